@@ -0,0 +1,188 @@
+#pragma once
+
+#include <new>          //! Provides std::bad_alloc, thrown when a chunk cannot be mapped.
+#include <cstddef>      //? Provides size_t / std::max_align_t.
+#include <cstdint>      //! Provides uintptr_t, used for alignment arithmetic.
+#include <cstdlib>      //? Provides std::malloc/std::free for the portable fallback.
+#include <algorithm>    //? Provides std::max, used when sizing oversized chunks.
+#include <string_view>  //? Provides std::string_view, used for page-mode names.
+
+#include "LinkedList.hpp" //* One node per chunk (not per block).
+
+#ifdef __linux__
+    #include <sys/mman.h>   //> mmap / munmap / madvise (MAP_HUGETLB, MADV_HUGEPAGE, MADV_POPULATE_WRITE).
+#elif defined(_WIN32)
+    #include <windows.h>    //> VirtualAlloc / VirtualFree.
+#endif
+
+/*
+ * Chunked bump allocator for the memory stress test.
+ *
+ * Memory is mapped from the OS in large chunks (256 MB by default) and handed out
+ * by advancing a pointer: no header, free list or lock per block. Individual blocks
+ * are never freed; release() unmaps every chunk at once, so tearing down tens of
+ * gigabytes costs one munmap per chunk instead of one free() per block.
+ *
+ * With setPopulate(true) each allocation is faulted in by the kernel as it is handed out
+ * (MADV_POPULATE_WRITE over just those bytes), so the first store into it takes no fault and
+ * the unused tail of the last chunk stays uncommitted.
+ *
+ * Not thread-safe: each arena has a single owning thread.
+ */
+namespace Memory {
+
+    enum class PageMode {
+        Default,      // Whatever the system does for anonymous memory
+        Transparent,  // madvise(MADV_HUGEPAGE): ask for transparent huge pages
+        Explicit      // MAP_HUGETLB: preallocated hugetlbfs pages, falls back to Default if none
+    };
+
+    inline bool parsePageMode(std::string_view name, PageMode& mode) {
+        if (name == "off")           mode = PageMode::Default;
+        else if (name == "thp")      mode = PageMode::Transparent;
+        else if (name == "explicit") mode = PageMode::Explicit;
+        else return false;
+        return true;
+    }
+
+    constexpr const char* name(PageMode mode) {
+        switch (mode) {
+            case PageMode::Transparent: return "thp";
+            case PageMode::Explicit:    return "explicit";
+            default:                    return "off";
+        }
+    }
+
+    struct Chunk {
+        char* base = nullptr;   // Start of the mapping
+        size_t size = 0;        // Mapped bytes
+        size_t used = 0;        // Bytes handed out so far
+        bool hugetlb = false;   // Backed by explicit huge pages
+    };
+
+    class Arena {
+        static constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+    #if defined(__linux__) || defined(_WIN32)
+        static constexpr size_t BASE_ALIGNMENT = 4096;                   // mmap / VirtualAlloc return whole pages
+    #else
+        static constexpr size_t BASE_ALIGNMENT = alignof(std::max_align_t);
+    #endif
+
+        LinkedList<Chunk> chunks;   // Every mapping, in allocation order
+        Chunk* current = nullptr;   // Chunk being carved up
+        size_t chunkSize;
+        PageMode pageMode;
+        size_t reservedBytes = 0;
+        size_t usedBytes = 0;
+        bool hugetlbFallback = false;
+        bool populate = false;
+
+        static size_t roundUp(size_t value, size_t to) { return (value + to - 1) / to * to; }
+
+        Chunk map(size_t bytes) {
+            Chunk chunk;
+            chunk.size = roundUp(bytes, HUGE_PAGE);
+
+        #ifdef __linux__
+            void* base = MAP_FAILED;
+            if (pageMode == PageMode::Explicit) {
+                base = mmap(nullptr, chunk.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                chunk.hugetlb = base != MAP_FAILED;
+                hugetlbFallback |= base == MAP_FAILED;
+            }
+            if (base == MAP_FAILED) {
+                base = mmap(nullptr, chunk.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            }
+            if (base == MAP_FAILED) throw std::bad_alloc();
+            if (pageMode == PageMode::Transparent) madvise(base, chunk.size, MADV_HUGEPAGE);
+            chunk.base = static_cast<char*>(base);
+        #elif defined(_WIN32)
+            chunk.base = static_cast<char*>(VirtualAlloc(nullptr, chunk.size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+            if (!chunk.base) throw std::bad_alloc();
+        #else
+            chunk.base = static_cast<char*>(std::malloc(chunk.size));
+            if (!chunk.base) throw std::bad_alloc();
+        #endif
+
+            reservedBytes += chunk.size;
+            return chunk;
+        }
+
+        // [O(bytes / page)] The chunk was MADV_HUGEPAGE'd when mapped, so THP chunks are populated with
+        // huge pages. Without MADV_POPULATE_WRITE (Linux < 5.14, other systems) one store per page
+        // does the faulting instead.
+        static void prefault(char* base, size_t bytes) {
+            char* first = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(base) / 4096 * 4096);
+            const size_t length = roundUp(static_cast<size_t>(base + bytes - first), 4096);
+        #if defined(__linux__) && defined(MADV_POPULATE_WRITE)
+            if (madvise(first, length, MADV_POPULATE_WRITE) == 0) return;
+        #endif
+            for (size_t offset = 0; offset < bytes; offset += 4096) base[offset] = 0; // Fresh memory: only our own bytes
+            if (bytes > 0) base[bytes - 1] = 0;
+        }
+
+        static void unmap(const Chunk& chunk) {
+        #ifdef __linux__
+            munmap(chunk.base, chunk.size);
+        #elif defined(_WIN32)
+            VirtualFree(chunk.base, 0, MEM_RELEASE);
+        #else
+            std::free(chunk.base);
+        #endif
+        }
+
+    public:
+        explicit Arena(size_t chunkSize = 256 * 1024 * 1024, PageMode pageMode = PageMode::Default)
+            : chunkSize(chunkSize), pageMode(pageMode) {}
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        ~Arena() { release(); }
+
+        void setPageMode(PageMode mode) { pageMode = mode; }
+        void setPopulate(bool enabled) { populate = enabled; }
+
+        // [O(1)] Bump allocation; maps a new chunk when the current one is exhausted (and with
+        // setPopulate, faults in the bytes handed out). Throws std::bad_alloc when the OS refuses a new chunk.
+        void* allocate(size_t bytes, size_t alignment = 64) {
+            if (current) {
+                size_t offset = roundUp(reinterpret_cast<uintptr_t>(current->base) + current->used, alignment)
+                              - reinterpret_cast<uintptr_t>(current->base);
+                if (offset + bytes <= current->size) {
+                    current->used = offset + bytes;
+                    usedBytes += bytes;
+                    if (populate) prefault(current->base + offset, bytes);
+                    return current->base + offset;
+                }
+            }
+
+            // A chunk's base already satisfies page alignment, so a request of a whole chunk at 4 KB
+            // alignment maps exactly one chunk; only stricter alignments need room to pad
+            chunks.push_back(map(std::max(chunkSize, bytes + (alignment > BASE_ALIGNMENT ? alignment : 0))));
+            current = &chunks.back();
+            return allocate(bytes, alignment);
+        }
+
+        // [O(chunks)] Unmaps every chunk; all pointers handed out become invalid
+        void release() {
+            chunks.forEach([](const Chunk& chunk) { unmap(chunk); });
+            chunks.clear();
+            current = nullptr;
+            reservedBytes = usedBytes = 0;
+        }
+
+        // [O(chunks)] Calls fn(base, usedBytes) for every chunk, oldest first
+        template <typename Fn>
+        void forEachChunk(Fn&& fn) const {
+            chunks.forEach([&](const Chunk& chunk) { fn(chunk.base, chunk.used); });
+        }
+
+        size_t reserved() const { return reservedBytes; }
+        size_t used() const { return usedBytes; }
+        size_t chunkCount() const { return chunks.getSize(); }
+
+        // True when MAP_HUGETLB was requested but at least one chunk fell back to normal pages
+        bool fellBackFromHugetlb() const { return hugetlbFallback; }
+    };
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>       //? Provides std::vector, the spawned and the resumable coroutines.
+#include <string>       //? Provides std::string, the setup error.
+#include <cstdint>      //! Provides uint64_t for offsets and io_uring user data.
+#include <algorithm>    //? Provides std::max, the peak of requests in flight.
+#include <exception>    //! Provides std::terminate for an exception escaping a task.
+#include <coroutine>    //! Provides std::coroutine_handle and the suspend_* awaitables (C++20/23).
+
+#include "Storage.hpp"  //* The raw-syscall io_uring the executor submits to.
+
+/*
+ * Coroutine executor for I/O-bound load (--io-engine=coro): one thread, one io_uring, and as
+ * many requests in flight as there are coroutines, each written as a plain sequential loop.
+ *
+ *   coroutine:  while (running) { r = co_await executor.read(fd, buf, n, off); record(r); }
+ *                                   |                                   ^
+ *                          queue one SQE, suspend          resumed with cqe.res
+ *                                   v                                   |
+ *   run():  resume every ready coroutine -> io_uring_enter(submit all, wait 1) -> reap CQEs
+ *
+ * A suspended coroutine is a heap frame of a few hundred bytes and its SQE's user data points
+ * at the awaiter inside that frame, so thousands of outstanding requests cost no threads and no
+ * per-request bookkeeping beyond the frame. Spawned tasks start on the first pass of run();
+ * run() returns when all of them have returned. Linux only (io_uring).
+ */
+namespace Async {
+
+#ifdef __linux__
+    class Executor;
+
+    // Coroutine owned by an Executor: starts inside run(), its frame is freed by the executor
+    struct Task {
+        struct promise_type {
+            Executor* owner = nullptr;
+
+            Task get_return_object() { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void();
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    class Executor {
+        // Every spawned frame. Declared before the ring, so the ring is closed first and no completion
+        // can refer to a frame once it is freed (a failed run() leaves some suspended).
+        struct Frames {
+            std::vector<std::coroutine_handle<Task::promise_type>> list;
+            ~Frames() { for (auto handle : list) handle.destroy(); }
+        } tasks;
+        Storage::Uring ring;
+        std::vector<std::coroutine_handle<>> ready, resuming;          // Resumed on the next pass
+        size_t live = 0;            // Spawned tasks that have not returned
+        size_t inFlight = 0;        // Queued or submitted requests without a completion yet
+        size_t peak = 0;
+
+        friend struct Task::promise_type;
+
+    public:
+        // Awaitable read or write: suspends until its completion, resumes with cqe.res (bytes or -errno)
+        struct Io {
+            Executor& executor;
+            bool read;
+            int fd;
+            void* buffer;
+            uint32_t bytes;
+            uint64_t offset;
+            int result = 0;
+            std::coroutine_handle<> waiting;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { // [O(1)] One SQE, submitted with the next enter
+                waiting = handle;
+                executor.ring.queue(read, fd, buffer, bytes, offset, reinterpret_cast<uint64_t>(this));
+                executor.peak = std::max(executor.peak, ++executor.inFlight);
+            }
+            int await_resume() const noexcept { return result; }
+        };
+
+        Executor() = default;
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        // `entries` bounds the requests in flight (one per suspended coroutine)
+        bool setup(unsigned entries, std::string& error) { return ring.setup(entries, error); }
+        unsigned capacity() const { return ring.depth(); }
+        size_t peakInFlight() const { return peak; }
+
+        void spawn(Task task) {
+            task.handle.promise().owner = this;
+            tasks.list.push_back(task.handle);
+            ready.push_back(task.handle);
+            ++live;
+        }
+
+        Io read(int fd, void* buffer, uint32_t bytes, uint64_t offset) { return {*this, true, fd, buffer, bytes, offset, 0, {}}; }
+        Io write(int fd, void* buffer, uint32_t bytes, uint64_t offset) { return {*this, false, fd, buffer, bytes, offset, 0, {}}; }
+
+        // [O(completions)] Event loop until every task has returned; false when io_uring_enter fails
+        bool run() {
+            while (live > 0) {
+                resuming.swap(ready);
+                for (auto handle : resuming) handle.resume(); // [O(ready)] Each queues its next request or returns
+                resuming.clear();
+                if (live == 0) break;
+                if (!ring.submit(1)) return false; // One syscall submits every new request and waits
+                ring.reap([&](uint64_t data, int result) { // [O(completions)]
+                    Io* io = reinterpret_cast<Io*>(data);
+                    io->result = result;
+                    --inFlight;
+                    ready.push_back(io->waiting);
+                });
+            }
+            return true;
+        }
+    };
+
+    inline void Task::promise_type::return_void() { --owner->live; }
+#endif
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cmath>        //! Provides std::sqrt/std::log/std::exp for the spread and the geometric mean.
+#include <string>       //? Provides std::string, kernel names and the score file.
+#include <vector>       //? Provides std::vector, samples and results.
+#include <cstdio>       //? Provides std::snprintf, used to format scores without locale surprises.
+#include <cstdint>      //! Provides uint64_t, the seed.
+#include <cstdlib>      //? Provides std::strtod/std::strtoull, used to read a baseline back.
+#include <ctime>        //? Provides std::time/std::gmtime, the timestamp in the score file.
+#include <fstream>      //? Provides std::ifstream/std::ofstream for score and baseline files.
+#include <algorithm>    //? Provides std::sort, used for the median and the MAD.
+#include <chrono>       //! Provides steady_clock, used to time iterations.
+#include <latch>        //! Provides std::latch, used to start the threads of one iteration together.
+#include <memory>       //! Provides std::unique_ptr, the per-thread kernel instances.
+#include <thread>       //! Provides std::thread for multi-threaded iterations.
+
+#include "Workloads.hpp"    //* The CPU kernels and their registry.
+#include "Topology.hpp"     //* Pinning the iteration threads.
+
+#ifdef __linux__
+    #include <unistd.h>         //> gethostname.
+    #include <sys/utsname.h>    //> uname: kernel release in the score file.
+#endif
+
+/*
+ * Benchmark mode (--bench): fixed kernels, fixed inputs, a score per kernel.
+ *
+ *   calibrate   calls per iteration so one iteration takes ~--bench-ms (rounded to a power of two)
+ *   warm-up     --bench-warmup iterations, discarded (clocks, caches, branch predictors settle)
+ *   measure     --bench-iterations iterations, every one doing exactly the same work
+ *   reject      samples more than OUTLIER_MADS scaled MADs from the median (an interrupt, a
+ *               migration, a frequency change) are dropped; the score is the mean of the rest
+ *
+ * Kernel inputs come from --bench-seed and the call index only, so two runs on the same
+ * machine execute identical instruction streams. The score file has one kernel per line:
+ *
+ *   {"bench":1,"seed":1,"threads":1,...,"kernels":[
+ *   {"name":"modexp","unit":"ops/s","higher_is_better":true,"score":1234.5,"cv":0.4,"kept":15,"samples":15},
+ *   ...]}
+ *
+ * which is also what --bench-baseline reads back, by kernel name.
+ */
+namespace Bench {
+
+    constexpr double OUTLIER_MADS = 3.0;        // Rejection distance in MADs (scaled to sigma)
+    constexpr int SCORE_FORMAT = 1;             // "bench" field of the score file
+
+    struct Stats {
+        double score = 0.0;                     // Mean of the kept samples
+        double median = 0.0;
+        double cvPercent = 0.0;                 // Spread of the kept samples, % of the score
+        size_t samples = 0, kept = 0;
+    };
+
+    // [O(n log n)] Median / MAD outlier rejection, then mean and coefficient of variation
+    inline Stats summarise(std::vector<double> samples) {
+        Stats stats;
+        stats.samples = samples.size();
+        if (samples.empty()) return stats;
+
+        auto median = [](std::vector<double> values) {
+            std::sort(values.begin(), values.end());
+            const size_t n = values.size();
+            return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+        };
+        stats.median = median(samples);
+        std::vector<double> deviations;
+        for (double s : samples) deviations.push_back(std::fabs(s - stats.median));
+        const double mad = median(deviations) * 1.4826;    // ~ one standard deviation for normal noise
+
+        double sum = 0.0, squares = 0.0;
+        for (double s : samples) {
+            if (mad > 0.0 && std::fabs(s - stats.median) > OUTLIER_MADS * mad) continue;
+            sum += s;
+            squares += s * s;
+            ++stats.kept;
+        }
+        stats.score = sum / stats.kept;
+        const double variance = std::max(0.0, squares / stats.kept - stats.score * stats.score);
+        stats.cvPercent = stats.score > 0.0 ? std::sqrt(variance) / stats.score * 100.0 : 0.0;
+        return stats;
+    }
+
+    struct Result {
+        std::string name;
+        const char* unit = "ops/s";
+        bool higherIsBetter = true;
+        Stats stats;
+    };
+
+    // What a score file says about one kernel
+    struct Baseline {
+        std::string name;
+        double score = 0.0;
+        bool higherIsBetter = true;
+    };
+
+    // Machine the scores were taken on (kept in the score file, shown next to a baseline)
+    struct System {
+        std::string host, kernel, cpu, timestamp;
+    };
+
+    inline System describeSystem() {
+        System system;
+        char stamp[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        system.timestamp = stamp;
+    #ifdef __linux__
+        char host[256] = {};
+        if (gethostname(host, sizeof(host) - 1) == 0) system.host = host;
+        utsname uts{};
+        if (uname(&uts) == 0) system.kernel = uts.release;
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        for (std::string line; std::getline(cpuinfo, line);) {
+            if (line.starts_with("model name")) {
+                system.cpu = line.substr(std::min(line.size(), line.find(':') + 2));
+                break;
+            }
+        }
+    #endif
+        return system;
+    }
+
+    inline std::string quoted(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out + '"';
+    }
+
+    inline std::string number(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        return buffer;
+    }
+
+    // Run settings recorded with the scores; a baseline taken with other settings is not comparable
+    struct Settings {
+        uint64_t seed = 1;
+        unsigned threads = 1;
+        int warmup = 0, iterations = 0, iterationMs = 0;
+    };
+
+    inline bool writeScores(const std::string& path, const Settings& settings, const System& system,
+                            const std::vector<Result>& results) {
+        std::ofstream out(path);
+        out << "{\"bench\":" << SCORE_FORMAT << ",\"seed\":" << settings.seed << ",\"threads\":" << settings.threads
+            << ",\"warmup\":" << settings.warmup << ",\"iterations\":" << settings.iterations
+            << ",\"iteration_ms\":" << settings.iterationMs << ",\"timestamp\":" << quoted(system.timestamp)
+            << ",\"host\":" << quoted(system.host) << ",\"kernel\":" << quoted(system.kernel)
+            << ",\"cpu\":" << quoted(system.cpu) << ",\"kernels\":[\n";
+        for (size_t k = 0; k < results.size(); ++k) {
+            const Result& r = results[k];
+            out << "{\"name\":" << quoted(r.name) << ",\"unit\":" << quoted(r.unit)
+                << ",\"higher_is_better\":" << (r.higherIsBetter ? "true" : "false")
+                << ",\"score\":" << number(r.stats.score) << ",\"median\":" << number(r.stats.median)
+                << ",\"cv\":" << number(r.stats.cvPercent) << ",\"kept\":" << r.stats.kept
+                << ",\"samples\":" << r.stats.samples << '}' << (k + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "]}\n";
+        return static_cast<bool>(out);
+    }
+
+    // Text after "key": up to the next ',' or '}' on the same line (no nested objects in kernel lines)
+    inline bool field(const std::string& line, const std::string& key, std::string& value) {
+        const size_t at = line.find("\"" + key + "\":");
+        if (at == std::string::npos) return false;
+        const size_t from = at + key.size() + 3;
+        if (from < line.size() && line[from] == '"') {
+            const size_t end = line.find('"', from + 1);
+            if (end == std::string::npos) return false;
+            value = line.substr(from + 1, end - from - 1);
+            return true;
+        }
+        value = line.substr(from, line.find_first_of(",}", from) - from);
+        return true;
+    }
+
+    // [O(file)] Kernel lines of a score file written by writeScores(); false when none are found
+    inline bool readScores(const std::string& path, std::vector<Baseline>& baseline, Settings& settings, System& system) {
+        std::ifstream in(path);
+        std::string line, value;
+        while (std::getline(in, line)) {
+            if (line.starts_with("{\"bench\":")) {
+                if (field(line, "host", value)) system.host = value;
+                if (field(line, "timestamp", value)) system.timestamp = value;
+                if (field(line, "kernel", value)) system.kernel = value;
+                if (field(line, "seed", value)) settings.seed = std::strtoull(value.c_str(), nullptr, 10);
+                if (field(line, "threads", value)) settings.threads = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+                if (field(line, "iteration_ms", value)) settings.iterationMs = std::atoi(value.c_str());
+                continue;
+            }
+            Baseline entry;
+            if (!field(line, "name", entry.name) || !field(line, "score", value)) continue;
+            entry.score = std::strtod(value.c_str(), nullptr);
+            entry.higherIsBetter = !field(line, "higher_is_better", value) || value == "true";
+            baseline.push_back(entry);
+        }
+        return !baseline.empty();
+    }
+
+    // Change of a score against its baseline in %, positive = better whichever way the unit points
+    inline double improvementPercent(const Result& result, const Baseline& baseline) {
+        if (baseline.score <= 0.0 || result.stats.score <= 0.0) return 0.0;
+        const double ratio = result.higherIsBetter ? result.stats.score / baseline.score : baseline.score / result.stats.score;
+        return (ratio - 1.0) * 100.0;
+    }
+
+    inline const Baseline* find(const std::vector<Baseline>& baseline, const std::string& name) {
+        for (const auto& entry : baseline) {
+            if (entry.name == name) return &entry;
+        }
+        return nullptr;
+    }
+
+    // Geometric mean of the better-is-positive ratios over the kernels both runs have, in %
+    inline double overallPercent(const std::vector<Result>& results, const std::vector<Baseline>& baseline) {
+        double logSum = 0.0;
+        int count = 0;
+        for (const auto& result : results) {
+            const Baseline* entry = find(baseline, result.name);
+            if (!entry || entry->score <= 0.0 || result.stats.score <= 0.0) continue;
+            logSum += std::log(1.0 + improvementPercent(result, *entry) / 100.0);
+            ++count;
+        }
+        return count ? (std::exp(logSum / count) - 1.0) * 100.0 : 0.0;
+    }
+
+    // ============================================================================================
+    // RUNNING KERNELS
+    // ============================================================================================
+
+    // The original hash, its SIMD variants, FP, and the memory-bound kernels, in this order.
+    // Kernels this CPU cannot run are skipped (and show as missing against a baseline).
+    constexpr const char* WORKLOADS[] = {"modexp", "modexp-sse4.2", "modexp-avx2", "modexp-avx512", "fma",
+                                         "gemm-avx2", "gemm-avx512", "pointer-chase", "crc32", "aes"};
+
+    // Calibrates, warms up and samples one kernel. run(count) performs `count` units of work and
+    // returns its seconds; value(count, seconds) turns that into the kernel's unit.
+    template <typename Run, typename Value>
+    Result measure(const Settings& settings, const std::string& name, const char* unit, bool higherIsBetter,
+                   Run&& run, Value&& value) {
+        const double target = settings.iterationMs / 1000.0;
+        uint64_t count = 1;
+        double seconds = run(count);
+        while (seconds < target / 4 && count < (uint64_t(1) << 40)) seconds = run(count *= 2);
+        while (seconds * 1.5 < target) { // Extrapolated: the work per unit is the same for every count
+            count *= 2;
+            seconds *= 2;
+        }
+        for (int w = 0; w < settings.warmup; ++w) run(count);
+
+        std::vector<double> samples;
+        for (int s = 0; s < settings.iterations; ++s) samples.push_back(value(count, run(count)));
+        return {name, unit, higherIsBetter, summarise(samples)};
+    }
+
+    // [O(threads * calls)] Wall time of every thread making calls [0, calls) on its own instance
+    inline double timeWorkload(std::vector<std::unique_ptr<Workloads::Workload>>& instances,
+                               const std::vector<unsigned>& cpus, uint64_t calls) {
+        if (instances.size() == 1) { // Already pinned: no thread start inside the timed region
+            volatile uint64_t sink = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < calls; ++i) sink = sink + instances[0]->runOnce(i);
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::vector<std::chrono::steady_clock::time_point> starts(instances.size()), ends(instances.size());
+        std::latch ready(static_cast<std::ptrdiff_t>(instances.size()));
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < instances.size(); ++t) {
+            threads.emplace_back([&, t] {
+                Topology::pinCurrentThread(cpus[t % cpus.size()]);
+                volatile uint64_t sink = 0;
+                ready.arrive_and_wait();
+                starts[t] = std::chrono::steady_clock::now();
+                for (uint64_t i = 0; i < calls; ++i) sink = sink + instances[t]->runOnce(i);
+                ends[t] = std::chrono::steady_clock::now();
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        return std::chrono::duration<double>(*std::max_element(ends.begin(), ends.end())
+                                             - *std::min_element(starts.begin(), starts.end())).count();
+    }
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>      //? Provides size_t.
+#include <cstdint>      //! Provides uint64_t words and the per-line counters.
+#include <algorithm>    //? Provides std::max/std::min, used for working-set sizes.
+
+#include "Topology.hpp"     //* CacheSizes (sysfs / CPUID).
+#include "MemoryBench.hpp"  //* buildChase() and LINE for the scattered working sets.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>  //> AVX2 read-modify-write loop (_mm256_add_epi64).
+    #define STRESS_CACHE_AVX2 1
+#else
+    #define STRESS_CACHE_AVX2 0
+#endif
+
+/*
+ * Cache-resident read-modify-write stress, one working set per cache level and thread:
+ *
+ *   L1d       l1d / 2                 L2        l2 / 2
+ *   LLC/core  3/4 of this thread's LLC share (llc / threads sharing it)
+ *   >LLC      1.5x this thread's share: with every thread in the same phase the sets
+ *             together spill just past the LLC, so the traffic is LLC <-> DRAM
+ *
+ * Each level is stressed with two access patterns:
+ *
+ *   sequential  every word += 1 in address order (the prefetchers stream it, so this is
+ *               the level's bandwidth ceiling)
+ *   random      the lines are linked into one random cycle (MemoryBench::buildChase) and
+ *               CURSORS walkers step through it, each incrementing the counter in its line:
+ *               independent misses the prefetchers cannot predict
+ *
+ * Every lap adds exactly one to every word (sequential) or every line counter (random), so after
+ * a phase the whole set must read back as its lap count. A word that does not is a cache-array
+ * (SRAM) error that only shows under load; a broken link word is reported the same way and the
+ * set is rebuilt. A line visited counts as LINE bytes read plus LINE written back in both patterns.
+ */
+namespace CacheStress {
+
+    enum Level { L1, L2, Llc, PastLlc, LEVEL_COUNT };
+    enum Access { Sequential, Scattered, ACCESS_COUNT };
+
+    constexpr int PHASE_COUNT = int(LEVEL_COUNT) * int(ACCESS_COUNT);   // Level-major: L1d seq, L1d rand, L2 seq, ...
+
+    constexpr const char* name(Level level) {
+        constexpr const char* NAMES[LEVEL_COUNT] = {"L1d", "L2", "LLC/core", ">LLC"};
+        return NAMES[level];
+    }
+
+    constexpr const char* name(Access access) {
+        return access == Sequential ? "sequential" : "random";
+    }
+
+    constexpr unsigned CURSORS = 8;     // Independent walkers per random set (misses in flight)
+
+    // Bytes of one thread's working set at `level`; `share` threads compete for one LLC instance.
+    // Page multiples, so every set holds a whole number of lines per walker.
+    inline size_t workingSet(Level level, const Topology::CacheSizes& caches, unsigned share) {
+        const size_t llcShare = caches.llc / std::max(1u, share);
+        size_t bytes = 0;
+        switch (level) {
+            case L1:  bytes = caches.l1d / 2; break;
+            case L2:  bytes = caches.l2 / 2; break;
+            case Llc: bytes = std::max(llcShare / 4 * 3, caches.l2); break;
+            default:  bytes = std::max(llcShare / 2 * 3, 2 * caches.l2); break;
+        }
+        return std::max<size_t>(bytes / 4096 * 4096, 4096);
+    }
+
+    // One level's two working sets and their walkers; owned and touched by a single thread
+    struct Region {
+        uint64_t* words = nullptr;      // Sequential set
+        char* lines = nullptr;          // Random set (linked lines)
+        size_t bytes = 0;               // Size of each set
+        char* cursors[CURSORS] = {};
+        uint64_t laps[ACCESS_COUNT] = {};
+    };
+
+    // [O(bytes / LINE)] Zeroes both sets and links the random one; each walker starts 1/CURSORS of
+    // the cycle after the previous one, so a lap of bytes / LINE / CURSORS steps visits each line once
+    inline void reset(Region& region, uint64_t seed) {
+        const size_t words = region.bytes / sizeof(uint64_t);
+        for (size_t i = 0; i < words; ++i) region.words[i] = 0;
+        MemoryBench::buildChase(region.lines, region.bytes, seed);
+        const size_t count = region.bytes / MemoryBench::LINE;
+        for (size_t k = 0; k < count; ++k) {
+            uint64_t* line = reinterpret_cast<uint64_t*>(region.lines + k * MemoryBench::LINE);
+            for (size_t w = 1; w < MemoryBench::LINE / sizeof(uint64_t); ++w) line[w] = 0; // Drop buildChase's scratch
+        }
+        char* p = region.lines;
+        for (unsigned c = 0; c < CURSORS; ++c) {
+            region.cursors[c] = p;
+            for (size_t s = 0; s < count / CURSORS; ++s) p = *reinterpret_cast<char**>(p);
+        }
+        region.laps[Sequential] = region.laps[Scattered] = 0;
+    }
+
+    #if STRESS_CACHE_AVX2
+    // [O(n)] 16 words per iteration; n must be a multiple of 16, p 32-byte aligned
+    __attribute__((target("avx2")))
+    inline void incrementAvx2(uint64_t* p, size_t n) {
+        const __m256i one = _mm256_set1_epi64x(1);
+        for (size_t i = 0; i < n; i += 16) {
+            auto* v = reinterpret_cast<__m256i*>(p + i);
+            const __m256i a = _mm256_load_si256(v), b = _mm256_load_si256(v + 1);
+            const __m256i c = _mm256_load_si256(v + 2), d = _mm256_load_si256(v + 3);
+            _mm256_store_si256(v, _mm256_add_epi64(a, one));
+            _mm256_store_si256(v + 1, _mm256_add_epi64(b, one));
+            _mm256_store_si256(v + 2, _mm256_add_epi64(c, one));
+            _mm256_store_si256(v + 3, _mm256_add_epi64(d, one));
+        }
+    }
+    #endif
+
+    // [O(bytes)] One sequential lap: every word += 1; returns bytes moved
+    inline size_t sequentialLap(Region& region) {
+        const size_t n = region.bytes / sizeof(uint64_t);
+        ++region.laps[Sequential];
+    #if STRESS_CACHE_AVX2
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        if (avx2) {
+            incrementAvx2(region.words, n);
+            return 2 * region.bytes;
+        }
+    #endif
+        for (size_t i = 0; i < n; ++i) region.words[i] += 1;
+        return 2 * region.bytes;
+    }
+
+    // [O(bytes / LINE)] One random lap: every line's counter += 1, CURSORS walkers interleaved.
+    // Returns bytes moved, or 0 when a link left the set (the walk stops; the caller rebuilds).
+    inline size_t scatteredLap(Region& region) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(region.lines);
+        const size_t steps = region.bytes / MemoryBench::LINE / CURSORS;
+        char* cursor[CURSORS];
+        for (unsigned c = 0; c < CURSORS; ++c) cursor[c] = region.cursors[c];
+        for (size_t s = 0; s < steps; ++s) {
+            bool escaped = false;
+            for (unsigned c = 0; c < CURSORS; ++c) {
+                uint64_t* line = reinterpret_cast<uint64_t*>(cursor[c]);
+                line[1] += 1;
+                cursor[c] = reinterpret_cast<char*>(line[0]);
+                escaped |= reinterpret_cast<uintptr_t>(cursor[c]) - base >= region.bytes;
+            }
+            if (escaped) return 0;
+        }
+        for (unsigned c = 0; c < CURSORS; ++c) region.cursors[c] = cursor[c];
+        ++region.laps[Scattered];
+        return 2 * region.bytes;
+    }
+
+    // [O(bytes)] Words (sequential) or line counters (random) that do not hold the lap count
+    inline uint64_t check(const Region& region, Access access) {
+        uint64_t wrong = 0;
+        const uint64_t expected = region.laps[access];
+        if (access == Sequential) {
+            const size_t n = region.bytes / sizeof(uint64_t);
+            for (size_t i = 0; i < n; ++i) wrong += region.words[i] != expected;
+        } else {
+            const size_t count = region.bytes / MemoryBench::LINE;
+            for (size_t k = 0; k < count; ++k) {
+                wrong += reinterpret_cast<const uint64_t*>(region.lines + k * MemoryBench::LINE)[1] != expected;
+            }
+        }
+        return wrong;
+    }
+
+    // Per cache-stress thread; written only by its owner, read after join
+    struct Results {
+        double bytes[LEVEL_COUNT][ACCESS_COUNT] = {};
+        double seconds[LEVEL_COUNT][ACCESS_COUNT] = {};
+        uint64_t errors[LEVEL_COUNT] = {};      // Words / line counters / links that read back wrong
+    };
+}
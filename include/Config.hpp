@@ -0,0 +1,709 @@
+#pragma once
+
+#include <string>       //? Provides std::string, used for option values and error messages.
+#include <vector>       //? Provides std::vector, used for list-valued options.
+#include <cstdlib>      //? Provides std::strtoull / std::strtod for numeric values.
+#include <cstdint>      //! Provides SIZE_MAX, the overflow bound of --memory and the other sizes.
+#include <fstream>      //? Provides std::ifstream, used for --config files.
+#include <sstream>      //? Provides std::istringstream, used for options forwarded by a coordinator.
+#include <iostream>     //? Provides std::ostream, used for --help and --list-workloads.
+#include <algorithm>    //? Provides std::min / std::any_of, used for list parsing and option checks.
+#include <string_view>  //? Provides std::string_view, used for splitting keys, values and lists.
+
+#include "Workloads.hpp"    //* Kernel registry for --workload.
+#include "Topology.hpp"     //* Affinity modes and CPU lists.
+#include "Arena.hpp"        //* Huge page modes.
+#include "Storage.hpp"      //* Storage engines.
+#include "Network.hpp"      //* Network protocols and HOST:PORT parsing.
+#include "MemoryVerify.hpp" //* Verification pattern names.
+#include "Profile.hpp"      //* Load-profile steps.
+
+#ifdef _WIN32
+    #include <io.h>         //> _isatty / _fileno.
+    #include <windows.h>    //> GlobalMemoryStatusEx.
+#else
+    #include <unistd.h>     //> isatty / sysconf.
+#endif
+
+/*
+ * Run options, collected from the command line and optional config files.
+ * The defaults reproduce the original fixed test (30 s, 15 GB, 4500-op batches).
+ */
+struct StressOptions {
+    int durationSeconds = 30;       //? --duration=30|90s|5m|2h: test length
+    bool durationGiven = false;     //  Set by --duration (otherwise a --profile sets the length)
+    size_t memoryTarget = size_t(15) * 1024 * 1024 * 1024; //? --memory=15G|512M|50%: memory test target
+    double memoryPercent = 0.0;     //  Set when --memory was given in % of physical RAM (resolved after parsing)
+    unsigned threads = 0;           //? --threads=N: CPU workers (default: one per available/selected CPU)
+    int batchSize = 4500;           //? --batch-size=N: hash operations per scheduler task
+    int barWidth = 30;              //? --bar-width=N: progress bar width for time and memory displays
+    bool nonInteractive = false;    //? --yes / -y: do not wait for Enter (also implied when stdin is not a terminal)
+    bool sharedCounter = false;     //? --shared-counter: all workers fetch_add one atomic (coherence-traffic test)
+    std::vector<const Workloads::WorkloadInfo*> workloads; //? --workload=a,b: kernels assigned round-robin to workers
+    bool isaReport = false;         //? --isa-report: time scalar vs SSE4.2/AVX2/AVX-512 modexp before the run
+    bool coreLatency = false;       //? --core-latency: core-to-core ping-pong matrix, idle before the run and under load
+    std::vector<unsigned> coreLatencyCpus; //? --core-latency-cpus=LIST: CPUs of the matrix (default: all available)
+    std::vector<int> rampSteps;     //? --ramp=25,50,75,100: equal-length load steps in % of workers (default 100)
+    std::vector<Profile::Step> profile; //? --profile="60s cpu=100; 30s idle; 60s cpu=50 mem; 60s square=1hz"
+    Topology::Affinity affinity = Topology::Affinity::None; //? --affinity=compact|scatter|physical, or --cpus=LIST
+    std::vector<unsigned> cpuList;  //? --cpus=0-3,8: explicit worker CPUs (one worker each)
+    Memory::PageMode pageMode = Memory::PageMode::Default; //? --hugepages=off|thp|explicit for arena chunks
+    bool parallelFill = false;      //? --fill=parallel: N threads first-touch their own slice (default serial)
+    unsigned fillThreads = 0;       //? --fill-threads=N: parallel fill threads (default: one per worker CPU)
+    bool prefault = false;          //? --prefault: reserve and fault in the memory target before the clock starts
+    bool memoryBandwidth = false;   //? --mem-mode=bandwidth: keep running STREAM + latency chases on the blocks
+    unsigned bandwidthThreads = 0;  //? --bw-threads=N: STREAM threads (default: one per worker CPU)
+    bool memoryVerify = false;      //? --mem-mode=verify: keep writing and checking patterns on the blocks
+    unsigned verifyThreads = 0;     //? --verify-threads=N: verification threads (default: one per worker CPU)
+    std::vector<int> verifyPatterns = {MemoryVerify::WalkingOnes, MemoryVerify::MovingInversions,
+                                       MemoryVerify::AddressInAddress, MemoryVerify::Random}; //? --verify-patterns=a,b
+    uint64_t verifySeed = 1;        //? --verify-seed=N: seed of the random pattern (reproducible runs)
+    bool memoryPressure = false;    //? --mem-mode=pressure: grow resident memory in steps into reclaim (replaces --memory)
+    int pressureTargetPercent = 90; //? --pressure-target=PCT: of MemAvailable / cgroup headroom (over 100 needs --pressure-swap)
+    size_t pressureStep = size_t(256) << 20; //? --pressure-step=SIZE: bytes made resident per step
+    int pressureDwellMs = 2000;     //? --pressure-dwell=MS: time between steps
+    bool pressureSwap = false;      //? --pressure-swap: let the target go past RAM into swap / zram
+    int pressureBackoffPercent = 40; //? --pressure-backoff=PCT: PSI full avg10 that gives the last step back (0 = never)
+    bool memoryFile = false;        //? --mem-mode=file: the blocks are a shared mapping of a sparse file, streamed with msync
+    std::string memoryFileDirectory = "/var/tmp"; //? --mem-file-dir=DIR: where the backing file is created
+    size_t memoryFileWindow = size_t(64) << 20; //? --mem-file-window=SIZE: bytes rewritten between writeback calls
+    bool cacheStress = false;       //? --cache-stress: read-modify-write loops over L1d/L2/LLC/past-LLC sized sets
+    unsigned cacheThreads = 0;      //? --cache-threads=N: cache-stress threads (default: one per worker CPU)
+    int cachePhaseMs = 500;         //? --cache-phase=MS: time on each level/pattern before the next
+    bool gpu = false;               //? --gpu: OpenCL modexp, FP32 GEMM and device-memory copy next to the CPU load
+    unsigned gpuDevice = 0;         //? --gpu-device=N: OpenCL device index (GPUs first)
+    std::string telemetryJson;      //? --telemetry-json=PATH: one JSON object per collector tick
+    std::string telemetryCsv;       //? --telemetry-csv=PATH: one CSV row per collector tick
+    int telemetryIntervalMs = 250;  //? --telemetry-interval=MS: collector tick (rates, console view, writers)
+    unsigned metricsPort = 0;       //? --metrics-port=PORT: Prometheus / OpenMetrics text on GET /metrics (0 = off)
+    bool perfCounters = true;       //? --perf=false: skip the per-worker hardware counters
+    bool sensors = true;            //? --sensors=false: skip clock/temperature/power polling
+    unsigned latencySample = 16;    //? --latency-sample=N: time every Nth kernel call (0 = off)
+    std::string storagePath;        //? --storage=DIR: storage test on a scratch file created in DIR (off by default)
+    size_t storageSize = size_t(1) << 30; //? --storage-size=1G: scratch file size (rounded down to whole --io-size requests)
+    size_t ioSize = 4096;           //? --io-size=4K: bytes per request (multiple of 512 for O_DIRECT)
+    unsigned ioDepth = 32;          //? --io-depth=N: requests in flight per storage thread
+    unsigned ioThreads = 1;         //? --io-threads=N: submitting threads (each with its own ring)
+    unsigned ioReadPercent = 70;    //? --io-read=PCT: share of reads in the mix
+    bool ioRandom = true;           //? --io-pattern=random|sequential
+    Storage::Engine ioEngine = Storage::Engine::Auto; //? --io-engine=auto|io_uring|threads|coro
+    int sensorIntervalMs = 1000;    //? --sensor-interval=MS: sensor polling period
+    std::string netTarget;          //? --net=loopback|HOST:PORT: send flows over loopback or to a --net-listen peer
+    unsigned netListenPort = 0;     //? --net-listen=PORT: receive flows from peers (0 = off)
+    Network::Protocol netProtocol = Network::Protocol::Tcp; //? --net-proto=tcp|udp
+    unsigned netFlows = 4;          //? --net-flows=N: sending flows (and receivers), pinned across the CPUs
+    size_t netMessageSize = 0;      //? --net-size=SIZE: bytes per send or datagram (0 = 64K TCP / 1472 UDP)
+    bool netZeroCopy = true;        //? --net-zerocopy=false: plain copying sends instead of MSG_ZEROCOPY
+    unsigned coordinatorPort = 0;   //? --coordinator=PORT: release --agents=N agents together and merge their telemetry
+    unsigned fleetAgents = 0;       //? --agents=N: agents the coordinator waits for
+    int fleetWaitSeconds = 300;     //? --fleet-wait=5m: how long the coordinator waits for them
+    std::string agentTarget;        //? --agent=HOST:PORT: join a coordinator and run with its options
+    bool bench = false;             //? --bench: score a fixed, seeded kernel set instead of running the stress test
+    std::string benchOut = "bench.json"; //? --bench-out=PATH: score file (one kernel per line, see Bench.hpp)
+    std::string benchBaseline;      //? --bench-baseline=PATH: earlier score file to compare against
+    int benchThresholdPercent = 5;  //? --bench-threshold=PCT: slower than the baseline by more = regression (exit code 2)
+    int benchWarmup = 3;            //? --bench-warmup=N: discarded iterations per kernel
+    int benchIterations = 15;       //? --bench-iterations=N: measured iterations per kernel
+    int benchMs = 100;              //? --bench-ms=MS: target length of one iteration
+    unsigned benchThreads = 1;      //? --bench-threads=N: threads per CPU kernel (memory kernels use one)
+    uint64_t benchSeed = 1;         //? --bench-seed=N: kernel inputs (same seed = same instruction stream)
+    std::string forwarded;          //  Every test option applied, as "key = value" lines (sent to the agents)
+};
+
+/*
+ * Command-line and config-file front end.
+ *
+ * Every option is a key with an optional value. On the command line it is written
+ * --key=value (or --key for switches); in a config file (--config=PATH) it is one
+ * "key = value" per line, with # comments. Later settings override earlier ones,
+ * so command-line flags after --config win over the file.
+ */
+namespace Config {
+
+    enum class Outcome { Run, Exit, Error };
+
+    // Calls fn(item) for each comma-separated item; stops and returns false if fn does
+    template <typename Fn>
+    bool forEachListItem(std::string_view list, Fn&& fn) {
+        while (!list.empty()) {
+            std::string_view item = list.substr(0, list.find(','));
+            list.remove_prefix(std::min(list.size(), item.size() + 1));
+            if (!fn(item)) return false;
+        }
+        return true;
+    }
+
+    inline std::string_view trim(std::string_view text) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+        return text;
+    }
+
+    // Whole non-negative integer, no trailing characters
+    inline bool parseUnsigned(std::string_view text, unsigned long long& value) {
+        if (text.empty() || text.find_first_not_of("0123456789") != std::string_view::npos) return false;
+        value = std::strtoull(std::string(text).c_str(), nullptr, 10);
+        return true;
+    }
+
+    inline bool parseBool(std::string_view text, bool& value) {
+        if (text == "1" || text == "true" || text == "yes" || text == "on") value = true;
+        else if (text == "0" || text == "false" || text == "no" || text == "off") value = false;
+        else return false;
+        return true;
+    }
+
+    // "30", "90s", "5m", "2h"
+    inline bool parseDuration(std::string_view text, int& seconds) {
+        int scale = 1;
+        if (!text.empty() && (text.back() == 's' || text.back() == 'm' || text.back() == 'h')) {
+            scale = text.back() == 'h' ? 3600 : text.back() == 'm' ? 60 : 1;
+            text.remove_suffix(1);
+        }
+        unsigned long long value;
+        if (!parseUnsigned(text, value) || value == 0 || value * scale > 0x7FFFFFFF) return false;
+        seconds = static_cast<int>(value * scale);
+        return true;
+    }
+
+    // "60s cpu=100; 30s idle; 60s cpu=50 mem; 60s square=1hz duty=25": ';'-separated steps, each a
+    // duration followed by space-separated settings
+    inline bool parseProfile(std::string_view text, std::vector<Profile::Step>& steps, std::string& error) {
+        steps.clear();
+        while (!text.empty()) {
+            const size_t semicolon = text.find(';');
+            std::string_view item = trim(text.substr(0, semicolon));
+            text.remove_prefix(semicolon == std::string_view::npos ? text.size() : semicolon + 1);
+            if (item.empty()) continue;
+
+            Profile::Step step;
+            bool first = true;
+            while (!item.empty()) {
+                std::string_view token = item.substr(0, item.find(' '));
+                item = trim(item.substr(token.size()));
+                const size_t equals = token.find('=');
+                const std::string_view name = token.substr(0, equals);
+                const std::string_view value = equals == std::string_view::npos ? std::string_view() : token.substr(equals + 1);
+                unsigned long long percent = 0;
+                bool ok = true;
+                if (first)                 ok = parseDuration(token, step.seconds);
+                else if (token == "idle")  step.cpuPercent = 0;
+                else if (token == "mem")   step.memoryBandwidth = true;
+                else if (name == "cpu" || name == "duty") {
+                    ok = parseUnsigned(value, percent) && (name == "cpu" ? percent <= 100 : percent > 0 && percent < 100);
+                    (name == "cpu" ? step.cpuPercent : step.dutyPercent) = static_cast<int>(percent);
+                }
+                else if (name == "square") {
+                    std::string hz(value);
+                    if (hz.size() > 2 && (hz.ends_with("hz") || hz.ends_with("Hz"))) hz.resize(hz.size() - 2);
+                    char* end = nullptr;
+                    step.waveHz = std::strtod(hz.c_str(), &end);
+                    ok = !hz.empty() && *end == '\0' && step.waveHz > 0.0 && step.waveHz <= 1000.0;
+                }
+                else ok = false;
+                if (!ok) {
+                    error = "Bad profile step setting: " + std::string(token);
+                    return false;
+                }
+                first = false;
+            }
+            steps.push_back(step);
+        }
+        if (steps.empty()) error = "Expected at least one profile step";
+        return !steps.empty();
+    }
+
+    // "4096", "512K", "512M", "15G", "1T" (binary units) or "50%" of physical RAM; zero and sizes
+    // that do not fit in size_t are rejected
+    inline bool parseSize(std::string_view text, size_t& bytes, double& percent) {
+        if (!text.empty() && text.back() == '%') {
+            text.remove_suffix(1);
+            unsigned long long value;
+            if (!parseUnsigned(text, value) || value == 0 || value > 100) return false;
+            percent = static_cast<double>(value);
+            return true;
+        }
+
+        size_t scale = 1;
+        if (!text.empty()) {
+            switch (text.back()) {
+                case 'K': case 'k': scale = size_t(1) << 10; break;
+                case 'M': case 'm': scale = size_t(1) << 20; break;
+                case 'G': case 'g': scale = size_t(1) << 30; break;
+                case 'T': case 't': scale = size_t(1) << 40; break;
+                default: break;
+            }
+            if (scale != 1) text.remove_suffix(1);
+        }
+        unsigned long long value;
+        if (!parseUnsigned(text, value) || value == 0 || value > SIZE_MAX / scale) return false;
+        bytes = static_cast<size_t>(value) * scale;
+        percent = 0.0;
+        return true;
+    }
+
+    inline size_t physicalMemoryBytes() {
+    #ifdef _WIN32
+        MEMORYSTATUSEX status;
+        status.dwLength = sizeof(status);
+        return GlobalMemoryStatusEx(&status) ? static_cast<size_t>(status.ullTotalPhys) : 0;
+    #else
+        long pages = sysconf(_SC_PHYS_PAGES), pageSize = sysconf(_SC_PAGESIZE);
+        return pages > 0 && pageSize > 0 ? static_cast<size_t>(pages) * static_cast<size_t>(pageSize) : 0;
+    #endif
+    }
+
+    inline bool stdinIsTerminal() {
+    #ifdef _WIN32
+        return _isatty(_fileno(stdin));
+    #else
+        return isatty(STDIN_FILENO);
+    #endif
+    }
+
+    inline void printUsage(std::ostream& out) {
+        out << "Usage: Stress_test.exe [options]\n"
+               "\n"
+               "  --config=PATH            Read \"key = value\" lines (same keys as below, without --)\n"
+               "  --duration=T             Test length: seconds, or 90s / 5m / 2h (default 30)\n"
+               "  --memory=SIZE            Memory target: 512M, 15G, ... or 50% of physical RAM (default 15G)\n"
+               "  --threads=N              CPU workers (default: one per CPU)\n"
+               "  --workload=A,B           CPU kernels, dealt out to workers round-robin (default modexp)\n"
+               "  --batch-size=N           Hash operations per scheduler task (default 4500)\n"
+               "  --bar-width=N            Progress bar width (default 30)\n"
+               "  --yes, -y                Start without waiting for Enter\n"
+               "  --shared-counter         Count ops on one shared atomic (coherence-traffic test)\n"
+               "  --isa-report             Time scalar vs SSE4.2/AVX2/AVX-512 modexp before the run\n"
+               "  --core-latency           Core-to-core cache-line ping-pong matrix, idle and under the CPU load\n"
+               "  --core-latency-cpus=LIST CPUs of that matrix, e.g. 0-7,64-71 (default all)\n"
+               "  --perf=false             Do not open per-worker hardware counters (IPC, misses, stalls)\n"
+               "  --sensors=false          Do not poll clocks, temperatures, throttling and RAPL power\n"
+               "  --sensor-interval=MS     Sensor polling period in milliseconds (default 1000)\n"
+               "  --latency-sample=N       Time every Nth kernel call into latency histograms (default 16, 0 = off)\n"
+               "  --ramp=P1,P2,...         Equal-length load steps in % of workers\n"
+               "  --profile=\"STEP; ...\"    Timed steps: DURATION [cpu=PCT|idle] [mem] [square=HZ] [duty=PCT],\n"
+               "                           repeated until --duration (default: one pass)\n"
+               "  --affinity=MODE          none, compact, scatter or physical\n"
+               "  --cpus=LIST              Explicit worker CPUs, e.g. 0-3,8\n"
+               "  --hugepages=MODE         off, thp or explicit\n"
+               "  --fill=MODE              serial or parallel first-touch fill\n"
+               "  --fill-threads=N         Parallel fill threads\n"
+               "  --prefault               Reserve and fault in --memory before the clock starts (kernel populate,\n"
+               "                           or the parallel fill with --fill=parallel); reports time to ready\n"
+               "  --mem-mode=MODE          hold, bandwidth (STREAM + latency chase), verify (pattern write/check)\n"
+               "                           pressure (stepwise growth into reclaim and swap) or file (mmap'ed\n"
+               "                           sparse file streamed through the page cache with msync writeback)\n"
+               "  --bw-threads=N           STREAM threads in bandwidth mode\n"
+               "  --verify-threads=N       Pattern threads in verify mode\n"
+               "  --verify-patterns=LIST   walking,inversions,address,random (default all)\n"
+               "  --verify-seed=N          Seed of the random pattern (default 1)\n"
+               "  --pressure-target=PCT    Pressure mode: % of MemAvailable / cgroup headroom to hold (default 90)\n"
+               "  --pressure-step=SIZE     Bytes made resident per step (default 256M)\n"
+               "  --pressure-dwell=MS      Milliseconds between steps (default 2000)\n"
+               "  --pressure-swap          Allow a target over 100, pushed out to swap / zram\n"
+               "  --pressure-backoff=PCT   PSI full avg10 that releases the last step (default 40, 0 = never)\n"
+               "  --mem-file-dir=DIR       File mode: directory of the backing file (default /var/tmp)\n"
+               "  --mem-file-window=SIZE   File mode: bytes rewritten per msync window (default 64M)\n"
+               "  --cache-stress           RMW loops over L1d, L2, LLC-per-core and past-LLC working sets\n"
+               "  --cache-threads=N        Cache-stress threads (default: one per worker CPU)\n"
+               "  --cache-phase=MS         Milliseconds per level and access pattern (default 500)\n"
+               "  --gpu                    GPU load: modexp, FP32 GEMM and device copies, transfers overlapped\n"
+               "  --gpu-device=N           OpenCL device to load, GPUs first (default 0)\n"
+               "  --storage=DIR            Storage test on a scratch file in DIR, alongside the CPU load\n"
+               "  --storage-size=SIZE      Scratch file size (default 1G)\n"
+               "  --io-size=SIZE           Bytes per request, multiple of 512 (default 4K)\n"
+               "  --io-depth=N             Requests in flight per storage thread (default 32)\n"
+               "  --io-threads=N           Storage submitting threads (default 1)\n"
+               "  --io-read=PCT            Share of reads, 0-100 (default 70)\n"
+               "  --io-pattern=MODE        random or sequential (default random)\n"
+               "  --io-engine=MODE         auto, io_uring, threads (blocking pread/pwrite pool) or coro\n"
+               "                           (one coroutine per request in flight on an io_uring event loop)\n"
+               "  --net=TARGET             loopback, or HOST:PORT of a peer started with --net-listen\n"
+               "  --net-listen=PORT        Receive flows from peers on PORT\n"
+               "  --net-proto=PROTO        tcp or udp (default tcp)\n"
+               "  --net-flows=N            Flows, pinned across the CPUs (default 4)\n"
+               "  --net-size=SIZE          Bytes per send / datagram (default 64K TCP, 1472 UDP)\n"
+               "  --net-zerocopy=BOOL      MSG_ZEROCOPY sends (default true)\n"
+               "  --coordinator=PORT       Start --agents=N agents together and merge their telemetry\n"
+               "  --agents=N               Agents the coordinator waits for\n"
+               "  --fleet-wait=DURATION    How long the coordinator waits for them (default 5m)\n"
+               "  --agent=HOST:PORT        Join a coordinator and run with the options it sends\n"
+               "  --bench                  Score a fixed, seeded kernel set instead of the stress test\n"
+               "  --bench-out=PATH         Score file (default bench.json)\n"
+               "  --bench-baseline=PATH    Compare with an earlier score file; regressions exit with code 2\n"
+               "  --bench-threshold=PCT    Slowdown that counts as a regression (default 5)\n"
+               "  --bench-warmup=N         Discarded iterations per kernel (default 3)\n"
+               "  --bench-iterations=N     Measured iterations per kernel (default 15)\n"
+               "  --bench-ms=MS            Target length of one iteration (default 100)\n"
+               "  --bench-threads=N        Threads per CPU kernel (default 1)\n"
+               "  --bench-seed=N           Seed of the kernel inputs (default 1)\n"
+               "  --telemetry-json=PATH    Write one JSON line of totals/rates per collector tick\n"
+               "  --telemetry-csv=PATH     Write one CSV row of totals/rates per collector tick\n"
+               "  --telemetry-interval=MS  Collector tick in milliseconds (default 250)\n"
+               "  --metrics-port=PORT      Serve the latest tick as Prometheus / OpenMetrics text on GET /metrics\n"
+               "  --list-workloads         Print the kernel registry and exit\n"
+               "  --help                   Print this help and exit\n";
+    }
+
+    inline bool loadFile(const std::string& path, StressOptions& options, std::string& error, int depth);
+
+    // Applies one option; `value` is empty and hasValue false for a bare switch
+    inline bool applyOption(std::string_view key, std::string_view value, bool hasValue,
+                            StressOptions& options, std::string& error, int depth = 0) {
+        auto fail = [&](const std::string& message) {
+            error = message + ": " + std::string(key) + (hasValue ? "=" + std::string(value) : "");
+            return false;
+        };
+        auto count = [&](unsigned& target) {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed) || parsed > 1u << 20) return fail("Expected a thread count");
+            target = static_cast<unsigned>(parsed);
+            return true;
+        };
+        auto flag = [&](bool& target) {
+            if (!hasValue) return target = true;
+            return parseBool(value, target) || fail("Expected true or false");
+        };
+
+        if (key == "config") {
+            if (depth > 4) return fail("Config files nested too deeply");
+            return loadFile(std::string(value), options, error, depth + 1);
+        }
+
+        // Fleet roles stay local; everything else is what a coordinator hands its agents
+        if (key == "coordinator" || key == "agents") {
+            unsigned long long parsed;
+            const unsigned long long limit = key == "coordinator" ? 65535 : 100000;
+            if (!parseUnsigned(value, parsed) || parsed == 0 || parsed > limit) return fail("Value out of range");
+            (key == "coordinator" ? options.coordinatorPort : options.fleetAgents) = static_cast<unsigned>(parsed);
+            return true;
+        }
+        if (key == "fleet-wait")      return parseDuration(value, options.fleetWaitSeconds) || fail("Expected a duration");
+
+        // Benchmark mode runs locally
+        if (key == "bench")           return flag(options.bench);
+        if (key == "bench-out")       return !value.empty() ? (options.benchOut = value, true) : fail("Expected a path");
+        if (key == "bench-baseline")  return !value.empty() ? (options.benchBaseline = value, true) : fail("Expected a path");
+        if (key == "bench-threads")   return count(options.benchThreads) && (options.benchThreads > 0 || fail("Expected at least one thread"));
+        if (key == "bench-threshold" || key == "bench-warmup" || key == "bench-iterations" || key == "bench-ms") {
+            unsigned long long parsed;
+            const bool positive = key == "bench-iterations" || key == "bench-ms";
+            if (!parseUnsigned(value, parsed) || parsed > 100000 || (positive && parsed == 0)) return fail("Value out of range");
+            (key == "bench-threshold" ? options.benchThresholdPercent : key == "bench-warmup" ? options.benchWarmup
+                : key == "bench-iterations" ? options.benchIterations : options.benchMs) = static_cast<int>(parsed);
+            return true;
+        }
+        if (key == "bench-seed") {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed)) return fail("Expected a number");
+            options.benchSeed = parsed;
+            return true;
+        }
+        if (key == "agent") {
+            std::string host;
+            uint16_t port;
+            return Network::splitEndpoint(value, host, port) ? (options.agentTarget = value, true) : fail("Expected HOST:PORT");
+        }
+        options.forwarded.append(key).append(" = ").append(hasValue ? value : "true").append("\n");
+
+        if (key == "duration") {
+            options.durationGiven = true;
+            return parseDuration(value, options.durationSeconds) || fail("Expected a duration");
+        }
+        if (key == "profile")         return parseProfile(value, options.profile, error);
+        if (key == "memory")          return parseSize(value, options.memoryTarget, options.memoryPercent) || fail("Expected a size or percentage");
+        if (key == "threads")         return count(options.threads);
+        if (key == "fill-threads")    return count(options.fillThreads);
+        if (key == "bw-threads")      return count(options.bandwidthThreads);
+        if (key == "verify-threads")  return count(options.verifyThreads);
+        if (key == "cache-threads")   return count(options.cacheThreads);
+        if (key == "yes")             return flag(options.nonInteractive);
+        if (key == "prefault")        return flag(options.prefault);
+        if (key == "shared-counter")  return flag(options.sharedCounter);
+        if (key == "isa-report")      return flag(options.isaReport);
+        if (key == "core-latency")    return flag(options.coreLatency);
+        if (key == "perf")            return flag(options.perfCounters);
+        if (key == "sensors")         return flag(options.sensors);
+        if (key == "cache-stress")    return flag(options.cacheStress);
+        if (key == "gpu")             return flag(options.gpu);
+        if (key == "pressure-swap")   return flag(options.pressureSwap);
+
+        if (key == "gpu-device") {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed) || parsed > 1024) return fail("Expected a device index");
+            options.gpuDevice = static_cast<unsigned>(parsed);
+            return true;
+        }
+        if (key == "latency-sample") {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed) || parsed > 1u << 30) return fail("Expected a sampling interval");
+            options.latencySample = static_cast<unsigned>(parsed);
+            return true;
+        }
+        if (key == "storage")         return !value.empty() ? (options.storagePath = value, true) : fail("Expected a directory");
+        if (key == "io-threads")      return count(options.ioThreads);
+        if (key == "io-engine") {
+            return Storage::parseEngine(value, options.ioEngine) || fail("I/O engine must be auto, io_uring, threads or coro");
+        }
+        if (key == "io-pattern") {
+            if (value != "random" && value != "sequential") return fail("I/O pattern must be random or sequential");
+            options.ioRandom = value == "random";
+            return true;
+        }
+        if (key == "storage-size" || key == "io-size") {
+            size_t bytes;
+            double percent;
+            if (!parseSize(value, bytes, percent) || percent != 0.0) return fail("Expected a size");
+            if (key == "io-size" && (bytes == 0 || bytes % 512 != 0 || bytes > (size_t(64) << 20))) return fail("I/O size must be a multiple of 512 up to 64M");
+            if (key == "storage-size" && bytes < (size_t(1) << 20)) return fail("Storage size must be at least 1M");
+            (key == "io-size" ? options.ioSize : options.storageSize) = bytes;
+            return true;
+        }
+        if (key == "io-depth" || key == "io-read") {
+            unsigned long long parsed;
+            const unsigned long long limit = key == "io-depth" ? 4096 : 100;
+            if (!parseUnsigned(value, parsed) || parsed > limit || (key == "io-depth" && parsed == 0)) return fail("Value out of range");
+            (key == "io-depth" ? options.ioDepth : options.ioReadPercent) = static_cast<unsigned>(parsed);
+            return true;
+        }
+        if (key == "net") {
+            std::string host;
+            uint16_t port;
+            if (value != "loopback" && !Network::splitEndpoint(value, host, port)) return fail("Expected loopback or HOST:PORT");
+            options.netTarget = value;
+            return true;
+        }
+        if (key == "net-listen" || key == "metrics-port") {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed) || parsed == 0 || parsed > 65535) return fail("Expected a port");
+            (key == "net-listen" ? options.netListenPort : options.metricsPort) = static_cast<unsigned>(parsed);
+            return true;
+        }
+        if (key == "net-proto")       return Network::parseProtocol(value, options.netProtocol) || fail("Protocol must be tcp or udp");
+        if (key == "net-flows")       return count(options.netFlows) && (options.netFlows > 0 || fail("Expected at least one flow"));
+        if (key == "net-zerocopy")    return flag(options.netZeroCopy);
+        if (key == "net-size") {
+            size_t bytes;
+            double percent;
+            if (!parseSize(value, bytes, percent) || percent != 0.0 || bytes > (size_t(1) << 20)) return fail("Expected a size up to 1M");
+            options.netMessageSize = bytes;
+            return true;
+        }
+        if (key == "telemetry-json")  return !value.empty() ? (options.telemetryJson = value, true) : fail("Expected a path");
+        if (key == "telemetry-csv")   return !value.empty() ? (options.telemetryCsv = value, true) : fail("Expected a path");
+
+        if (key == "batch-size" || key == "bar-width" || key == "telemetry-interval" || key == "sensor-interval"
+            || key == "cache-phase" || key == "pressure-dwell") {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed) || parsed == 0 || parsed > 0xFFFFFF) return fail("Expected a positive number");
+            (key == "batch-size" ? options.batchSize : key == "bar-width" ? options.barWidth
+                : key == "telemetry-interval" ? options.telemetryIntervalMs
+                : key == "sensor-interval" ? options.sensorIntervalMs
+                : key == "cache-phase" ? options.cachePhaseMs : options.pressureDwellMs) = static_cast<int>(parsed);
+            return true;
+        }
+        if (key == "workload") {
+            options.workloads.clear();
+            return forEachListItem(value, [&](std::string_view name) {
+                const auto* info = Workloads::find(name);
+                if (!info || !info->isSupported()) return fail("Unknown or unsupported workload " + std::string(name));
+                options.workloads.push_back(info);
+                return true;
+            });
+        }
+        if (key == "ramp") {
+            options.rampSteps.clear();
+            return forEachListItem(value, [&](std::string_view step) {
+                unsigned long long percent;
+                if (!parseUnsigned(step, percent) || percent > 100) return fail("Ramp steps must be 0-100");
+                options.rampSteps.push_back(static_cast<int>(percent));
+                return true;
+            });
+        }
+        if (key == "affinity") {
+            return Topology::parseAffinity(value, options.affinity) || fail("Affinity must be none, compact, scatter or physical");
+        }
+        if (key == "cpus") {
+            options.cpuList.clear();
+            options.affinity = Topology::Affinity::List;
+            return Topology::parseCpuList(value, options.cpuList) || fail("Malformed CPU list");
+        }
+        if (key == "core-latency-cpus") {
+            options.coreLatencyCpus.clear();
+            options.coreLatency = true;
+            return Topology::parseCpuList(value, options.coreLatencyCpus) || fail("Malformed CPU list");
+        }
+        if (key == "hugepages") {
+            return Memory::parsePageMode(value, options.pageMode) || fail("Huge pages must be off, thp or explicit");
+        }
+        if (key == "fill") {
+            if (value != "serial" && value != "parallel") return fail("Fill must be serial or parallel");
+            options.parallelFill = value == "parallel";
+            return true;
+        }
+        if (key == "mem-mode") {
+            if (value != "hold" && value != "bandwidth" && value != "verify" && value != "pressure" && value != "file") {
+                return fail("Memory mode must be hold, bandwidth, verify, pressure or file");
+            }
+            options.memoryBandwidth = value == "bandwidth";
+            options.memoryVerify = value == "verify";
+            options.memoryPressure = value == "pressure";
+            options.memoryFile = value == "file";
+            return true;
+        }
+        if (key == "pressure-target" || key == "pressure-backoff") {
+            unsigned long long parsed;
+            const bool target = key == "pressure-target";
+            if (!parseUnsigned(value, parsed) || parsed > (target ? 400 : 100) || (target && parsed == 0)) return fail("Value out of range");
+            (target ? options.pressureTargetPercent : options.pressureBackoffPercent) = static_cast<int>(parsed);
+            return true;
+        }
+        if (key == "pressure-step") {
+            double percent;
+            if (!parseSize(value, options.pressureStep, percent) || percent != 0.0 || options.pressureStep < (size_t(1) << 20)) {
+                return fail("Expected a size of at least 1M");
+            }
+            return true;
+        }
+        if (key == "mem-file-dir")    return !value.empty() ? (options.memoryFileDirectory = value, true) : fail("Expected a directory");
+        if (key == "mem-file-window") {
+            double percent;
+            if (!parseSize(value, options.memoryFileWindow, percent) || percent != 0.0 || options.memoryFileWindow < (size_t(1) << 20)) {
+                return fail("Expected a size of at least 1M");
+            }
+            return true;
+        }
+        if (key == "verify-patterns") {
+            options.verifyPatterns.clear();
+            return forEachListItem(value, [&](std::string_view name) {
+                int pattern;
+                if (!MemoryVerify::parsePattern(name, pattern)) return fail("Patterns are walking, inversions, address and random");
+                options.verifyPatterns.push_back(pattern);
+                return true;
+            }) && (!options.verifyPatterns.empty() || fail("Expected at least one pattern"));
+        }
+        if (key == "verify-seed") {
+            unsigned long long parsed;
+            if (!parseUnsigned(value, parsed)) return fail("Expected a number");
+            options.verifySeed = parsed;
+            return true;
+        }
+        return fail("Unknown option");
+    }
+
+    // Applies "key = value" lines (# comments); `origin` prefixes error messages
+    inline bool applyLines(std::istream& input, const std::string& origin, StressOptions& options, std::string& error, int depth) {
+        std::string line;
+        for (int number = 1; std::getline(input, line); ++number) {
+            std::string_view text = trim(std::string_view(line).substr(0, line.find('#')));
+            if (text.empty()) continue;
+
+            size_t equals = text.find('=');
+            std::string_view key = trim(text.substr(0, equals));
+            std::string_view value = equals == std::string_view::npos ? std::string_view() : trim(text.substr(equals + 1));
+            if (!applyOption(key, value, equals != std::string_view::npos, options, error, depth)) {
+                error = origin + ":" + std::to_string(number) + ": " + error;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline bool loadFile(const std::string& path, StressOptions& options, std::string& error, int depth) {
+        std::ifstream file(path);
+        if (!file) {
+            error = "Cannot open config file: " + path;
+            return false;
+        }
+        return applyLines(file, path, options, error, depth);
+    }
+
+    // Defaults and values derived from several options; run again after applying more of them
+    inline void resolve(StressOptions& options) {
+        if (options.workloads.empty()) options.workloads.push_back(Workloads::find("modexp"));
+        if (options.memoryPercent > 0.0) {
+            options.memoryTarget = static_cast<size_t>(physicalMemoryBytes() * (options.memoryPercent / 100.0));
+        }
+        if (!stdinIsTerminal()) options.nonInteractive = true;
+        options.storageSize = options.storageSize / options.ioSize * options.ioSize; // Whole requests only
+        if (!options.profile.empty()) {
+            if (!options.durationGiven) options.durationSeconds = Profile::totalSeconds(options.profile);
+            for (const auto& step : options.profile) {
+                if (step.memoryBandwidth && !options.memoryVerify && !options.memoryPressure && !options.memoryFile) {
+                    options.memoryBandwidth = true;
+                }
+            }
+        }
+    }
+
+    // Options a coordinator forwarded, applied over the agent's own command line
+    inline bool applyForwarded(const std::string& text, StressOptions& options, std::string& error) {
+        std::istringstream input(text);
+        if (!applyLines(input, "coordinator", options, error, 0)) return false;
+        resolve(options);
+        options.nonInteractive = true;
+        return true;
+    }
+
+    // Parses argv into `options`. Returns Exit after --help / --list-workloads, Error with `error` set.
+    inline Outcome parseArguments(int argc, char* argv[], StressOptions& options, std::string& error) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg(argv[i]);
+
+            if (arg == "--help" || arg == "-h") {
+                printUsage(std::cout);
+                return Outcome::Exit;
+            }
+            if (arg == "--list-workloads") {
+                for (const auto& info : Workloads::registry()) {
+                    std::cout << (info.isSupported() ? "  " : "- ") << info.name << ": " << info.description << std::endl;
+                }
+                return Outcome::Exit;
+            }
+            if (arg == "-y") arg = "--yes";
+
+            if (!arg.starts_with("--")) {
+                error = "Unknown option: " + std::string(arg);
+                return Outcome::Error;
+            }
+            arg.remove_prefix(2);
+            size_t equals = arg.find('=');
+            std::string_view key = arg.substr(0, equals);
+            std::string_view value = equals == std::string_view::npos ? std::string_view() : arg.substr(equals + 1);
+            if (!applyOption(key, value, equals != std::string_view::npos, options, error)) return Outcome::Error;
+        }
+
+        if (options.bench && (options.coordinatorPort != 0 || !options.agentTarget.empty())) {
+            error = "--bench runs locally, not as a fleet coordinator or agent";
+            return Outcome::Error;
+        }
+        if (options.coordinatorPort != 0 && options.fleetAgents == 0) {
+            error = "--coordinator needs --agents=N";
+            return Outcome::Error;
+        }
+        if (!options.profile.empty() && !options.rampSteps.empty()) {
+            error = "--profile and --ramp both set the load; use one of them";
+            return Outcome::Error;
+        }
+        if ((options.memoryVerify || options.memoryPressure || options.memoryFile)
+            && std::any_of(options.profile.begin(), options.profile.end(),
+                           [](const Profile::Step& step) { return step.memoryBandwidth; })) {
+            error = "Profile steps with mem need --mem-mode=bandwidth or hold";
+            return Outcome::Error;
+        }
+        if (options.prefault && (options.memoryPressure || options.memoryFile)) {
+            error = "--prefault applies to the arena blocks, not --mem-mode=pressure or file";
+            return Outcome::Error;
+        }
+        if (options.ioSize > options.storageSize) {
+            error = "--io-size must not exceed --storage-size";
+            return Outcome::Error;
+        }
+        if (options.pressureTargetPercent > 100 && !options.pressureSwap) {
+            error = "--pressure-target over 100 needs --pressure-swap";
+            return Outcome::Error;
+        }
+        resolve(options);
+        return Outcome::Run;
+    }
+}
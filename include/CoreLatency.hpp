@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic, the bounced cache line and the stop flag.
+#include <chrono>       //! Provides steady_clock, used to time round trips.
+#include <thread>       //! Provides std::thread for the responder and the measuring thread.
+#include <vector>       //? Provides std::vector, the latency matrix.
+#include <cstdint>      //! Provides uint64_t for the ping-pong sequence.
+#include <algorithm>    //? Provides std::min, used to keep the best sample.
+
+#include "Topology.hpp" //* Pinning and the CPU relations used to group the matrix.
+
+/*
+ * Core-to-core latency: one cache line bounced between two pinned threads.
+ *
+ *   initiator (cpu a)                    responder (cpu b)
+ *   line = 2k + 1   ------------------>  sees 2k + 1
+ *   sees 2k + 2     <------------------  line = 2k + 2
+ *
+ * Every half of a round trip moves the line from one core's cache to the other's, so half the
+ * round trip is the one-way coherence latency between the two CPUs. Each pair is timed in SAMPLES
+ * batches of ROUND_TRIPS and the fastest batch is kept: a batch the scheduler interrupted can only
+ * take longer, which keeps the estimate meaningful while the CPU hash load shares those CPUs.
+ * A pair stops sampling after PAIR_BUDGET, and a long spin yields, so an oversubscribed CPU
+ * slows the loaded pass down instead of stalling it.
+ */
+namespace CoreLatency {
+
+    constexpr unsigned SAMPLES = 16;
+    constexpr unsigned ROUND_TRIPS = 256;
+    constexpr double UNMEASURED = -1.0;         // Matrix cell of a pair that was not reached
+    constexpr auto PAIR_BUDGET = std::chrono::milliseconds(50); // Fewer samples for a pair that keeps being preempted
+
+    // How two CPUs relate in the topology, nearest first
+    enum Relation { SmtSibling, SameLlc, SamePackage, CrossPackage, RELATION_COUNT };
+
+    constexpr const char* name(Relation relation) {
+        constexpr const char* NAMES[RELATION_COUNT] = {"SMT siblings", "same LLC", "same package, other LLC", "cross package"};
+        return NAMES[relation];
+    }
+
+    inline Relation relation(const Topology::Cpu& a, const Topology::Cpu& b) {
+        if (a.core == b.core) return SmtSibling;
+        if (a.llc == b.llc) return SameLlc;
+        return a.package == b.package ? SamePackage : CrossPackage;
+    }
+
+    // Spin-wait step; after a long spin the partner is probably not running, so give up the CPU
+    inline void relax(unsigned& spins) {
+        if (++spins % (1u << 14) == 0) {
+            std::this_thread::yield();
+            return;
+        }
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+    #elif defined(__GNUC__) && defined(__aarch64__)
+        asm volatile("yield");
+    #endif
+    }
+
+    // [O(SAMPLES * ROUND_TRIPS)] One-way latency in ns between the calling thread's CPU and `responderCpu`
+    // (best batch); UNMEASURED when the responder cannot be pinned or `keepGoing` drops first
+    inline double pingPong(unsigned responderCpu, const std::atomic<bool>& keepGoing) {
+        constexpr uint64_t STOP = UINT64_MAX;
+        struct alignas(64) Line { std::atomic<uint64_t> value{0}; };
+        Line line;
+        std::atomic<int> responderState{0};     // 0 starting, 1 pinned, -1 could not pin
+
+        std::thread responder([&] {
+            const bool pinned = Topology::pinCurrentThread(responderCpu);
+            responderState.store(pinned ? 1 : -1, std::memory_order_release);
+            if (!pinned) return;
+            for (uint64_t expected = 1;; expected += 2) {
+                uint64_t seen;
+                unsigned spins = 0;
+                while ((seen = line.value.load(std::memory_order_acquire)) != expected && seen != STOP) relax(spins);
+                if (seen == STOP) return;
+                line.value.store(expected + 1, std::memory_order_release);
+            }
+        });
+
+        int state;
+        unsigned spins = 0;
+        while ((state = responderState.load(std::memory_order_acquire)) == 0) relax(spins);
+        double best = UNMEASURED;
+        uint64_t next = 1;
+        const auto begin = std::chrono::steady_clock::now();
+        for (unsigned s = 0; s < SAMPLES && state > 0 && keepGoing.load(std::memory_order_relaxed); ++s) {
+            const auto start = std::chrono::steady_clock::now();
+            if (s > 0 && start - begin > PAIR_BUDGET) break;
+            for (unsigned r = 0; r < ROUND_TRIPS; ++r, next += 2) {
+                line.value.store(next, std::memory_order_release);
+                spins = 0;
+                while (line.value.load(std::memory_order_acquire) != next + 1) relax(spins);
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                              / (2.0 * ROUND_TRIPS);
+            best = best < 0.0 ? ns : std::min(best, ns);
+        }
+        line.value.store(STOP, std::memory_order_release);
+        responder.join();
+        return best;
+    }
+
+    // [O(n^2 * SAMPLES * ROUND_TRIPS)] Symmetric n x n one-way latency matrix (row-major, 0 on the
+    // diagonal) over `cpus`, measured from a separate pinned thread. Pairs not reached before
+    // `keepGoing` drops stay UNMEASURED; `measured` counts the pairs done so far (for progress).
+    inline std::vector<double> matrix(const std::vector<unsigned>& cpus, const std::atomic<bool>& keepGoing,
+                                      std::atomic<size_t>& measured) {
+        const size_t n = cpus.size();
+        std::vector<double> cells(n * n, UNMEASURED);
+        std::thread runner([&] {
+            for (size_t i = 0; i < n; ++i) {
+                cells[i * n + i] = 0.0;
+                if (!Topology::pinCurrentThread(cpus[i])) continue;
+                for (size_t j = i + 1; j < n && keepGoing.load(std::memory_order_relaxed); ++j) {
+                    cells[i * n + j] = cells[j * n + i] = pingPong(cpus[j], keepGoing);
+                    measured.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        runner.join();
+        return cells;
+    }
+}
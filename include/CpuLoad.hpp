@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>       //? Provides std::vector, used for the per-core counter snapshots (sized once).
+#include <cstdint>      //! Provides fixed-width integer types for tick counters.
+#include <algorithm>    //? Provides std::min/std::max, used to clamp utilisation figures.
+
+#ifdef __linux__
+    #include <fcntl.h>      //> open() for /proc/stat.
+    #include <unistd.h>     //> pread() / close(): re-read /proc/stat without reopening it.
+#elif defined(_WIN32)
+    #include <windows.h>    //> GetSystemTimes.
+#endif
+
+/*
+ * CPU utilisation sampler.
+ *
+ * Linux: per-core busy/total jiffies from /proc/stat. The file stays open and is
+ * re-read with pread() into a buffer sized at construction, so sample() does no
+ * allocations. Windows: GetSystemTimes (whole machine; every core reports that figure).
+ * Elsewhere available() is false and every figure reads 0.
+ *
+ * Utilisation between two samples = delta(busy) / delta(total), where
+ * busy = user + nice + system + irq + softirq + steal and total = busy + idle + iowait.
+ */
+namespace CpuLoad {
+
+    struct Ticks {
+        uint64_t busy = 0;
+        uint64_t total = 0;
+    };
+
+    inline double utilisation(const Ticks& from, const Ticks& to) {
+        if (to.total <= from.total) return 0.0;
+        return std::min(1.0, static_cast<double>(to.busy - from.busy) / static_cast<double>(to.total - from.total));
+    }
+
+    class Sampler {
+        std::vector<Ticks> first;       // Per core: at construction (whole-run averages)
+        std::vector<Ticks> previous;    // Per core: at the previous sample()
+        std::vector<Ticks> current;     // Per core: at the latest sample()
+        std::vector<double> interval;   // Per core: utilisation between the last two samples
+        std::vector<char> buffer;       // /proc/stat contents (Linux)
+        Ticks firstAll, previousAll, currentAll;
+        double intervalAll = 0.0;
+        bool ok = false;
+
+    #ifdef __linux__
+        int fd = -1;
+
+        // [O(file)] Parses every "cpuN ..." line into current / currentAll
+        bool read() {
+            ssize_t length = pread(fd, buffer.data(), buffer.size() - 1, 0);
+            if (length <= 0) return false;
+            buffer[length] = '\0';
+
+            const char* p = buffer.data();
+            while (*p) {
+                if (p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+                    p += 3;
+                    bool all = *p == ' ';
+                    unsigned id = 0;
+                    while (*p >= '0' && *p <= '9') id = id * 10 + static_cast<unsigned>(*p++ - '0');
+
+                    uint64_t field[8] = {}; // user nice system idle iowait irq softirq steal
+                    for (int f = 0; f < 8; ++f) {
+                        while (*p == ' ') ++p;
+                        while (*p >= '0' && *p <= '9') field[f] = field[f] * 10 + static_cast<uint64_t>(*p++ - '0');
+                    }
+                    Ticks ticks;
+                    ticks.busy = field[0] + field[1] + field[2] + field[5] + field[6] + field[7];
+                    ticks.total = ticks.busy + field[3] + field[4];
+
+                    if (all) currentAll = ticks;
+                    else if (id < current.size()) current[id] = ticks;
+                }
+                while (*p && *p != '\n') ++p;
+                if (*p) ++p;
+            }
+            return true;
+        }
+    #endif
+
+    public:
+        // `maxCpuId` sizes the per-core tables; ids above it are ignored
+        explicit Sampler(unsigned maxCpuId)
+            : first(maxCpuId + 1), previous(maxCpuId + 1), current(maxCpuId + 1), interval(maxCpuId + 1) {
+        #ifdef __linux__
+            fd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+            buffer.resize(64 * 1024 + 256 * (maxCpuId + 1)); // cpu lines plus intr/softirq/ctxt
+            ok = fd >= 0 && read();
+        #elif defined(_WIN32)
+            FILETIME idle, kernel, user;
+            ok = GetSystemTimes(&idle, &kernel, &user) != 0;
+            sample();
+        #endif
+            first = previous = current;
+            firstAll = previousAll = currentAll;
+        }
+
+        ~Sampler() {
+        #ifdef __linux__
+            if (fd >= 0) close(fd);
+        #endif
+        }
+
+        Sampler(const Sampler&) = delete;
+        Sampler& operator=(const Sampler&) = delete;
+
+        bool available() const { return ok; }
+
+        // [O(cores)] Takes a new sample; the interval figures cover the time since the previous one
+        void sample() {
+            if (!ok) return;
+            previous = current; // Same size, so the copy reuses the existing storage
+            previousAll = currentAll;
+
+        #ifdef __linux__
+            if (!read()) return;
+        #elif defined(_WIN32)
+            FILETIME idle, kernel, user;
+            if (!GetSystemTimes(&idle, &kernel, &user)) return;
+            auto ticks = [](const FILETIME& time) { return (uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime; };
+            // Kernel time includes idle time
+            currentAll.total = ticks(kernel) + ticks(user);
+            currentAll.busy = currentAll.total - ticks(idle);
+            for (auto& core : current) core = currentAll;
+        #endif
+
+            for (size_t id = 0; id < current.size(); ++id) interval[id] = utilisation(previous[id], current[id]);
+            intervalAll = utilisation(previousAll, currentAll);
+        }
+
+        // [O(cores)] Starts the since-start figures and the next interval from now
+        void rebaseline() {
+            sample();
+            first = previous = current;
+            firstAll = previousAll = currentAll;
+        }
+
+        // 0.0 - 1.0 between the last two samples
+        double core(unsigned id) const { return id < interval.size() ? interval[id] : 0.0; }
+        double overall() const { return intervalAll; }
+
+        // 0.0 - 1.0 from construction to the latest sample
+        double coreSinceStart(unsigned id) const { return id < current.size() ? utilisation(first[id], current[id]) : 0.0; }
+        double overallSinceStart() const { return utilisation(firstAll, currentAll); }
+
+        // Mean of the interval figures over a set of cores (e.g. the workers' CPUs)
+        double mean(const std::vector<unsigned>& ids) const {
+            if (ids.empty()) return 0.0;
+            double sum = 0.0;
+            for (unsigned id : ids) sum += core(id);
+            return sum / static_cast<double>(ids.size());
+        }
+    };
+}
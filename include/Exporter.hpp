@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic, the stop flag and the latest tick's elapsed time.
+#include <string>       //? Provides std::string, the reused response buffer.
+#include <thread>       //! Provides std::thread, the serving thread.
+#include <cstdio>       //? Provides std::snprintf for sample values.
+#include <cmath>        //! Provides std::isnan/std::isinf, spelled out as NaN / +Inf in the text format.
+#include <string_view>  //? Provides std::string_view, used to read the request line and headers.
+
+#include "Telemetry.hpp"    //* Sources and gauges of the collector (its latest tick).
+#include "Network.hpp"      //* The listening socket and socket timeouts.
+
+#ifdef __linux__
+    #include <poll.h>           //> poll: the accept loop wakes up to notice stop().
+#endif
+
+/*
+ * Prometheus / OpenMetrics endpoint (--metrics-port=PORT): GET /metrics on a dedicated thread.
+ *
+ *   worker threads --publish--> rings --collector tick--> Source::total / rate, Gauge::value
+ *                                                            |  (relaxed atomic loads)
+ *   scraper --GET /metrics--> serving thread --render()------+
+ *
+ * The response is built from what the collector stored at its latest tick, so a scrape never
+ * touches a ring or a worker's cache lines and costs the workers nothing. Every source becomes a
+ * counter and a rate gauge of its metric's family, labelled with the source, and every collector
+ * gauge (memory, temperature, profile step, ...) a stress_<name> gauge:
+ *
+ *   # TYPE stress_hash_ops counter
+ *   stress_hash_ops_total{source="worker0"} 123456
+ *   # TYPE stress_hash_ops_rate gauge
+ *   stress_hash_ops_rate{source="worker0"} 4012.5
+ *   # TYPE stress_temperature_c gauge
+ *   stress_temperature_c 71.5
+ *
+ * A scraper that asks for application/openmetrics-text gets that content type and the closing
+ * "# EOF"; anyone else gets the Prometheus text format 0.0.4. One connection is served at a time.
+ */
+namespace Exporter {
+
+    inline void appendValue(std::string& out, double value) {
+        if (std::isnan(value)) { out += "NaN"; return; }
+        if (std::isinf(value)) { out += value > 0 ? "+Inf" : "-Inf"; return; }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+        out += buffer;
+    }
+
+    // A metric or label name may only hold [a-zA-Z0-9_]
+    inline void appendName(std::string& out, std::string_view name) {
+        for (char c : name) {
+            const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+            out += ok ? c : '_';
+        }
+    }
+
+    // [O(sources + gauges)] Exposition of the collector's latest tick into `out` (cleared first)
+    inline void render(const Telemetry::Collector& collector, double elapsedSeconds, int durationSeconds,
+                       bool openMetrics, std::string& out) {
+        out.clear();
+        for (size_t m = 0; m < Telemetry::METRIC_COUNT; ++m) { // [O(metrics * sources)] Samples of a family stay together
+            const auto metric = static_cast<Telemetry::Metric>(m);
+            bool any = false;
+            for (const auto& source : collector.allSources()) any |= source->metric == metric;
+            if (!any) continue;
+
+            for (int pass = 0; pass < 2; ++pass) {
+                const bool counter = pass == 0;
+                const std::string family = std::string("stress_") + Telemetry::name(metric) + (counter ? "" : "_rate");
+                const std::string typed = counter && !openMetrics ? family + "_total" : family;
+                out += "# HELP " + typed + (counter ? " Total published by each source" : " Per second over the last collector tick")
+                     + "\n# TYPE " + typed + (counter ? " counter\n" : " gauge\n");
+                for (const auto& source : collector.allSources()) {
+                    if (source->metric != metric) continue;
+                    out += family + (counter ? "_total" : "") + "{source=\"";
+                    appendName(out, source->label);
+                    out += "\"} ";
+                    if (counter) out += std::to_string(source->total.load(std::memory_order_relaxed));
+                    else appendValue(out, source->rate.load(std::memory_order_relaxed));
+                    out += '\n';
+                }
+            }
+        }
+        for (const auto& gauge : collector.allGauges()) {
+            std::string name = "stress_";
+            appendName(name, gauge->label);
+            out += "# TYPE " + name + " gauge\n" + name + ' ';
+            appendValue(out, gauge->value.load(std::memory_order_relaxed));
+            out += '\n';
+        }
+        out += "# HELP stress_elapsed_seconds Test time at the latest collector tick\n"
+               "# TYPE stress_elapsed_seconds gauge\nstress_elapsed_seconds ";
+        appendValue(out, elapsedSeconds);
+        out += "\n# TYPE stress_duration_seconds gauge\nstress_duration_seconds " + std::to_string(durationSeconds) + '\n';
+        if (openMetrics) out += "# EOF\n";
+    }
+
+#ifdef __linux__
+    class Server {
+        static constexpr size_t MAX_REQUEST = 8192;     // Request line + headers we are willing to read
+
+        const Telemetry::Collector* collector = nullptr;
+        int durationSeconds = 0;
+        int listener = -1;
+        std::thread thread;
+        std::atomic<bool> stopping{false};
+        std::atomic<double> elapsed{0.0};               // Set from the collector's tick hook
+        std::atomic<uint64_t> scrapes{0};
+        std::string request, body, response;            // Serving thread only, reused
+
+        static bool sendAll(int fd, const std::string& data) {
+            for (size_t sent = 0; sent < data.size();) {
+                const ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0) return false;
+                sent += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        // [O(response)] One request per connection ("Connection: close")
+        void serve(int fd) {
+            Network::setTimeouts(fd);
+            request.clear();
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST) {
+                const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+                if (n <= 0) return;
+                request.append(buffer, static_cast<size_t>(n));
+            }
+            const std::string_view text(request);
+            const std::string_view line = text.substr(0, text.find("\r\n"));
+            const bool metrics = line.starts_with("GET /metrics ") || line.starts_with("GET /metrics?");
+            const bool openMetrics = text.find("application/openmetrics-text") != std::string_view::npos;
+
+            const char* status = "200 OK";
+            const char* type = "text/plain; version=0.0.4; charset=utf-8";
+            if (metrics) {
+                render(*collector, elapsed.load(std::memory_order_relaxed), durationSeconds, openMetrics, body);
+                if (openMetrics) type = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+                scrapes.fetch_add(1, std::memory_order_relaxed);
+            } else if (line.starts_with("GET / ")) {
+                body = "Stress tester metrics: /metrics\n";
+            } else {
+                status = line.starts_with("GET ") ? "404 Not Found" : "405 Method Not Allowed";
+                body = "Only GET /metrics is served\n";
+            }
+            response = std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + type + "\r\nContent-Length: "
+                     + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+            sendAll(fd, response) && sendAll(fd, body);
+        }
+
+    public:
+        Server() = default;
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+        ~Server() { stop(); }
+
+        // Must be called before collector.start() (it registers a tick hook); false with `error` set
+        bool start(Telemetry::Collector& source, uint16_t port, int duration, std::string& error) {
+            listener = Network::openReceiver(Network::Protocol::Tcp, false, port, error);
+            if (listener < 0) return false;
+            collector = &source;
+            durationSeconds = duration;
+            source.onTick([this](double seconds) { elapsed.store(seconds, std::memory_order_relaxed); });
+            thread = std::thread([this] {
+                pollfd waiting{listener, POLLIN, 0};
+                while (!stopping.load(std::memory_order_relaxed)) {
+                    if (poll(&waiting, 1, Network::TIMEOUT_MS) <= 0) continue;
+                    const int fd = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                    if (fd < 0) continue;
+                    serve(fd);
+                    close(fd);
+                }
+            });
+            return true;
+        }
+
+        void stop() {
+            stopping = true;
+            if (thread.joinable()) thread.join();
+            if (listener >= 0) close(listener);
+            listener = -1;
+        }
+
+        uint64_t scrapeCount() const { return scrapes.load(std::memory_order_relaxed); }
+    };
+#endif
+}
@@ -0,0 +1,512 @@
+#pragma once
+
+#include <chrono>       //! Provides system_clock, the wall clock the start time is agreed on.
+#include <string>       //? Provides std::string, used for host names, config text and errors.
+#include <vector>       //? Provides std::vector, the frame buffers (reused, capacity kept).
+#include <cstdint>      //! Provides fixed-width integer types for the wire format.
+#include <cstring>      //? Provides std::memcpy / std::strerror.
+#include <algorithm>    //? Provides std::max, used for the per-agent peaks.
+
+#include "Telemetry.hpp"    //* Collector totals/rates and the Writer interface the agent streams through.
+#include "Network.hpp"      //* Listening socket, HOST:PORT resolution and socket timeouts.
+
+#ifdef __linux__
+    #include <poll.h>               //> poll() over the agent connections.
+    #include <unistd.h>             //> gethostname / close.
+    #include <sys/socket.h>         //> send / recv / accept4.
+#endif
+
+/*
+ * Coordinated fleet runs: one coordinator, many agents (Linux).
+ *
+ *   agent                                       coordinator
+ *     | -- Hello {t0, host, cpus} -------------->  |  t1 = receive time
+ *     |                                            |  ... waits until every agent is connected
+ *     | <-- Start {t0, t1, t2, startAt, config} -- |  t2 = send time, startAt = t2 + lead
+ *     |  t3 = receive time                         |
+ *     |  offset = ((t1 - t0) + (t2 - t3)) / 2      |  (coordinator clock - agent clock, NTP style)
+ *     |  starts at startAt - offset (own clock)    |
+ *     | -- Tick {elapsed, totals, rates, gauges} ->|  every collector tick
+ *     | -- Final {seconds, lateness, totals} ----->|  after the run; coordinator merges the fleet
+ *
+ * Frames: u32 magic, u16 type, u16 reserved, u32 payload length, then the payload. Every
+ * field is little-endian, doubles as their IEEE-754 bit pattern; strings are u32 length + bytes.
+ * The start time does not depend on NTP: each agent corrects by its own measured offset,
+ * so the remaining skew is bounded by the link's delay asymmetry.
+ */
+namespace Fleet {
+
+    constexpr uint32_t MAGIC = 0x31525453;  // "STR1"
+    constexpr size_t HEADER_BYTES = 12;
+    constexpr uint32_t MAX_PAYLOAD = 1 << 20;
+    constexpr int64_t START_LEAD_NS = 3'000'000'000;    // Time between Start and the common start
+
+    enum class Type : uint16_t { Hello = 1, Start = 2, Tick = 3, Final = 4 };
+
+    // Gauges carried in every Tick, by collector label (0 when an agent does not have one)
+    constexpr const char* TICK_GAUGES[] = {"cpu_utilisation", "memory_mb", "package_w", "temperature_c"};
+    constexpr size_t GAUGE_COUNT = sizeof(TICK_GAUGES) / sizeof(TICK_GAUGES[0]);
+    enum GaugeIndex { CpuUtilisation, MemoryMb, PackageWatts, Celsius };
+
+    inline int64_t wallNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Appends one frame to a reusable buffer
+    class Encoder {
+        std::vector<uint8_t> bytes;
+
+    public:
+        void begin(Type type) {
+            bytes.clear();
+            u32(MAGIC);
+            u16(static_cast<uint16_t>(type));
+            u16(0);
+            u32(0); // Length, patched by frame()
+        }
+        void u16(uint16_t v) { for (int i = 0; i < 2; ++i) bytes.push_back(static_cast<uint8_t>(v >> (8 * i))); }
+        void u32(uint32_t v) { for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<uint8_t>(v >> (8 * i))); }
+        void u64(uint64_t v) { for (int i = 0; i < 8; ++i) bytes.push_back(static_cast<uint8_t>(v >> (8 * i))); }
+        void i64(int64_t v) { u64(static_cast<uint64_t>(v)); }
+        void f64(double v) {
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            u64(bits);
+        }
+        void text(const std::string& s) {
+            u32(static_cast<uint32_t>(s.size()));
+            bytes.insert(bytes.end(), s.begin(), s.end());
+        }
+
+        // The finished frame (header length filled in)
+        const std::vector<uint8_t>& frame() {
+            const uint32_t length = static_cast<uint32_t>(bytes.size() - HEADER_BYTES);
+            for (int i = 0; i < 4; ++i) bytes[8 + i] = static_cast<uint8_t>(length >> (8 * i));
+            return bytes;
+        }
+    };
+
+    // Reads fields out of one payload; ok() turns false on a short frame and stays false
+    class Decoder {
+        const uint8_t* p;
+        const uint8_t* end;
+        bool good = true;
+
+        uint64_t le(int bytes) {
+            if (end - p < bytes) {
+                good = false;
+                return 0;
+            }
+            uint64_t v = 0;
+            for (int i = 0; i < bytes; ++i) v |= uint64_t(p[i]) << (8 * i);
+            p += bytes;
+            return v;
+        }
+
+    public:
+        Decoder(const uint8_t* data, size_t size) : p(data), end(data + size) {}
+
+        uint16_t u16() { return static_cast<uint16_t>(le(2)); }
+        uint32_t u32() { return static_cast<uint32_t>(le(4)); }
+        uint64_t u64() { return le(8); }
+        int64_t i64() { return static_cast<int64_t>(le(8)); }
+        double f64() {
+            const uint64_t bits = le(8);
+            double v;
+            std::memcpy(&v, &bits, sizeof(v));
+            return v;
+        }
+        std::string text() {
+            const uint32_t length = u32();
+            if (!good || static_cast<size_t>(end - p) < length) {
+                good = false;
+                return {};
+            }
+            std::string s(reinterpret_cast<const char*>(p), length);
+            p += length;
+            return s;
+        }
+        bool ok() const { return good; }
+    };
+
+    // Splits a byte stream into frames; feed() whatever recv() returned, then take frames with next()
+    class FrameReader {
+        std::vector<uint8_t> buffer;
+        size_t consumed = 0;
+        bool corrupt = false;
+
+    public:
+        void feed(const uint8_t* data, size_t size) {
+            if (consumed > 0) { // Drop the frames already handed out
+                buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
+                consumed = 0;
+            }
+            buffer.insert(buffer.end(), data, data + size);
+        }
+
+        // [O(1)] Next complete frame: type and payload (valid until the next feed)
+        bool next(Type& type, const uint8_t*& payload, size_t& size) {
+            if (corrupt || buffer.size() - consumed < HEADER_BYTES) return false;
+            Decoder header(buffer.data() + consumed, HEADER_BYTES);
+            const uint32_t magic = header.u32();
+            type = static_cast<Type>(header.u16());
+            header.u16();
+            const uint32_t length = header.u32();
+            if (magic != MAGIC || length > MAX_PAYLOAD) {
+                corrupt = true;
+                return false;
+            }
+            if (buffer.size() - consumed < HEADER_BYTES + length) return false;
+            payload = buffer.data() + consumed + HEADER_BYTES;
+            size = length;
+            consumed += HEADER_BYTES + length;
+            return true;
+        }
+
+        bool failed() const { return corrupt; }
+    };
+
+    struct TickValues {
+        double elapsedSeconds = 0.0;
+        uint64_t totals[Telemetry::METRIC_COUNT] = {};
+        double rates[Telemetry::METRIC_COUNT] = {};
+        double gauges[GAUGE_COUNT] = {};
+    };
+
+    inline void encodeTick(Encoder& out, const TickValues& tick) {
+        out.begin(Type::Tick);
+        out.f64(tick.elapsedSeconds);
+        out.u32(static_cast<uint32_t>(Telemetry::METRIC_COUNT));
+        for (size_t m = 0; m < Telemetry::METRIC_COUNT; ++m) {
+            out.u64(tick.totals[m]);
+            out.f64(tick.rates[m]);
+        }
+        for (double gauge : tick.gauges) out.f64(gauge);
+    }
+
+    // Metrics beyond what this build knows are skipped, missing ones stay 0
+    inline bool decodeTick(Decoder& in, TickValues& tick) {
+        tick.elapsedSeconds = in.f64();
+        const uint32_t metrics = in.u32();
+        if (metrics > 64) return false;
+        for (uint32_t m = 0; m < metrics; ++m) {
+            const uint64_t total = in.u64();
+            const double rate = in.f64();
+            if (m < Telemetry::METRIC_COUNT) {
+                tick.totals[m] = total;
+                tick.rates[m] = rate;
+            }
+        }
+        for (double& gauge : tick.gauges) gauge = in.f64();
+        return in.ok();
+    }
+
+#ifdef __linux__
+    inline bool sendAll(int fd, const std::vector<uint8_t>& frame) {
+        size_t sent = 0;
+        while (sent < frame.size()) {
+            const ssize_t n = send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) continue;
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Blocking read (up to the socket's SO_RCVTIMEO) of the next frame of `wanted` type into `payload`
+    inline bool receiveFrame(int fd, FrameReader& reader, Type wanted, std::vector<uint8_t>& payload, std::string& error) {
+        uint8_t chunk[4096];
+        for (;;) {
+            Type type;
+            const uint8_t* data;
+            size_t size;
+            while (reader.next(type, data, size)) {
+                if (type != wanted) continue;
+                payload.assign(data, data + size);
+                return true;
+            }
+            if (reader.failed()) {
+                error = "malformed frame";
+                return false;
+            }
+            const ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n == 0) {
+                error = "connection closed";
+                return false;
+            }
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                error = errno == EAGAIN ? "timed out" : std::strerror(errno);
+                return false;
+            }
+            reader.feed(chunk, static_cast<size_t>(n));
+        }
+    }
+
+    inline std::string hostName() {
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) != 0) return "unknown";
+        return name;
+    }
+
+    // Agent side of the connection: handshake, then Tick/Final frames
+    class AgentLink {
+        int fd = -1;
+        Encoder encoder;
+        bool broken = false;
+
+    public:
+        int64_t offsetNs = 0;       // Coordinator clock minus this clock
+        int64_t roundTripNs = 0;
+        int64_t startLocalNs = 0;   // Agreed start on this machine's wall clock
+        std::string config;         // Options forwarded by the coordinator ("key = value" lines)
+
+        AgentLink() = default;
+        AgentLink(const AgentLink&) = delete;
+        AgentLink& operator=(const AgentLink&) = delete;
+        ~AgentLink() { if (fd >= 0) close(fd); }
+
+        // Connects, says hello and blocks until the coordinator has every agent and sends Start
+        bool join(const std::string& target, unsigned cpus, std::string& error) {
+            std::string host;
+            uint16_t port = 0;
+            sockaddr_in address;
+            if (!Network::splitEndpoint(target, host, port) || !Network::resolve(host, port, address, error)) {
+                if (error.empty()) error = "Expected HOST:PORT";
+                return false;
+            }
+            bool zeroCopy = false;
+            if ((fd = Network::connectFlow(Network::Protocol::Tcp, address, zeroCopy, error)) < 0) return false;
+            timeval none{0, 0}; // The wait for the other agents has no deadline
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &none, sizeof(none));
+
+            const int64_t t0 = wallNs();
+            encoder.begin(Type::Hello);
+            encoder.i64(t0);
+            encoder.text(hostName());
+            encoder.u32(cpus);
+            if (!sendAll(fd, encoder.frame())) {
+                error = std::string("send: ") + std::strerror(errno);
+                return false;
+            }
+
+            FrameReader reader;
+            std::vector<uint8_t> payload;
+            if (!receiveFrame(fd, reader, Type::Start, payload, error)) return false;
+            const int64_t t3 = wallNs();
+            Decoder start(payload.data(), payload.size());
+            const int64_t echoed = start.i64(), t1 = start.i64(), t2 = start.i64(), startAt = start.i64();
+            config = start.text();
+            if (!start.ok() || echoed != t0) {
+                error = "malformed Start frame";
+                return false;
+            }
+            offsetNs = ((t1 - t0) + (t2 - t3)) / 2;
+            roundTripNs = (t3 - t0) - (t2 - t1);
+            startLocalNs = startAt - offsetNs;
+            return true;
+        }
+
+        // Collector thread only. A failed send (coordinator gone, 200 ms send timeout) ends the stream
+        void send(const std::vector<uint8_t>& frame) {
+            if (!broken && !sendAll(fd, frame)) broken = true;
+        }
+
+        void sendFinal(double seconds, const Telemetry::Collector& collector, int64_t latenessNs) {
+            encoder.begin(Type::Final);
+            encoder.f64(seconds);
+            encoder.i64(latenessNs);
+            encoder.i64(offsetNs);
+            encoder.i64(roundTripNs);
+            encoder.u32(static_cast<uint32_t>(Telemetry::METRIC_COUNT));
+            for (size_t m = 0; m < Telemetry::METRIC_COUNT; ++m) encoder.u64(collector.total(static_cast<Telemetry::Metric>(m)));
+            send(encoder.frame());
+        }
+
+        bool connected() const { return !broken; }
+    };
+
+    // Streams one Tick per collector interval to the coordinator
+    class TickWriter : public Telemetry::Writer {
+        AgentLink& link;
+        Encoder encoder;
+        TickValues values;
+        int gaugeIndex[GAUGE_COUNT] = {};
+
+    public:
+        explicit TickWriter(AgentLink& link) : link(link) {}
+
+        void begin(const Telemetry::Collector& collector) override {
+            const auto& gauges = collector.allGauges();
+            for (size_t g = 0; g < GAUGE_COUNT; ++g) {
+                gaugeIndex[g] = -1;
+                for (size_t i = 0; i < gauges.size(); ++i) {
+                    if (gauges[i]->label == TICK_GAUGES[g]) gaugeIndex[g] = static_cast<int>(i);
+                }
+            }
+        }
+
+        void tick(const Telemetry::Collector& collector, double elapsedSeconds) override {
+            values.elapsedSeconds = elapsedSeconds;
+            for (size_t m = 0; m < Telemetry::METRIC_COUNT; ++m) {
+                values.totals[m] = collector.total(static_cast<Telemetry::Metric>(m));
+                values.rates[m] = collector.rate(static_cast<Telemetry::Metric>(m));
+            }
+            const auto& gauges = collector.allGauges();
+            for (size_t g = 0; g < GAUGE_COUNT; ++g) {
+                values.gauges[g] = gaugeIndex[g] >= 0 ? gauges[gaugeIndex[g]]->value.load(std::memory_order_relaxed) : 0.0;
+            }
+            encodeTick(encoder, values);
+            link.send(encoder.frame());
+        }
+    };
+
+    // Coordinator-side view of one agent
+    struct Agent {
+        int fd = -1;
+        std::string host;
+        unsigned cpus = 0;
+        int64_t helloSentNs = 0;    // t0, agent clock
+        int64_t helloReceivedNs = 0;// t1, coordinator clock
+        FrameReader reader;
+        TickValues latest;
+        bool ticking = false;       // At least one Tick received
+        double peakWatts = 0.0, peakCelsius = 0.0;
+        bool finished = false;
+        double seconds = 0.0;
+        int64_t latenessNs = 0;     // How late the agent actually started (its own clock)
+        int64_t offsetNs = 0, roundTripNs = 0; // The agent's clock correction, as it measured it
+        uint64_t totals[Telemetry::METRIC_COUNT] = {};
+    };
+
+    // Accepts agents, releases them together and merges what they stream back
+    class Coordinator {
+        int listener = -1;
+        Encoder encoder;
+
+        bool readHello(Agent& agent, std::string& error) {
+            std::vector<uint8_t> payload;
+            if (!receiveFrame(agent.fd, agent.reader, Type::Hello, payload, error)) return false;
+            agent.helloReceivedNs = wallNs();
+            Decoder hello(payload.data(), payload.size());
+            agent.helloSentNs = hello.i64();
+            agent.host = hello.text();
+            agent.cpus = hello.u32();
+            if (!hello.ok()) error = "malformed Hello frame";
+            return hello.ok();
+        }
+
+        void handle(Agent& agent, Type type, const uint8_t* data, size_t size) {
+            Decoder in(data, size);
+            if (type == Type::Tick) {
+                TickValues tick;
+                if (!decodeTick(in, tick)) return;
+                agent.latest = tick;
+                agent.ticking = true;
+                agent.peakWatts = std::max(agent.peakWatts, tick.gauges[PackageWatts]);
+                agent.peakCelsius = std::max(agent.peakCelsius, tick.gauges[Celsius]);
+            } else if (type == Type::Final) {
+                agent.seconds = in.f64();
+                agent.latenessNs = in.i64();
+                agent.offsetNs = in.i64();
+                agent.roundTripNs = in.i64();
+                const uint32_t metrics = in.u32();
+                for (uint32_t m = 0; m < metrics && m < 64; ++m) {
+                    const uint64_t total = in.u64();
+                    if (m < Telemetry::METRIC_COUNT) agent.totals[m] = total;
+                }
+                agent.finished = in.ok();
+            }
+        }
+
+    public:
+        std::vector<Agent> agents;
+        int64_t startAtNs = 0;      // Coordinator clock
+
+        Coordinator() = default;
+        Coordinator(const Coordinator&) = delete;
+        Coordinator& operator=(const Coordinator&) = delete;
+        ~Coordinator() {
+            for (auto& agent : agents) if (agent.fd >= 0) close(agent.fd);
+            if (listener >= 0) close(listener);
+        }
+
+        // Waits (up to waitSeconds) for `count` agents to connect and say hello
+        bool gather(uint16_t port, unsigned count, int waitSeconds, std::string& error) {
+            if ((listener = Network::openReceiver(Network::Protocol::Tcp, false, port, error)) < 0) return false;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(waitSeconds);
+            agents.reserve(count);
+            while (agents.size() < count) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    error = "only " + std::to_string(agents.size()) + " of " + std::to_string(count) + " agents connected";
+                    return false;
+                }
+                const int fd = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (fd < 0) continue; // SO_RCVTIMEO: re-check the deadline
+                timeval helloTimeout{2, 0};
+                setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &helloTimeout, sizeof(helloTimeout));
+                agents.emplace_back();
+                agents.back().fd = fd;
+                std::string reason;
+                if (!readHello(agents.back(), reason)) {
+                    close(fd);
+                    agents.pop_back(); // Not an agent (or too slow to say hello): keep waiting
+                }
+            }
+            return true;
+        }
+
+        // Sends every agent the common start time and the options to run with
+        bool release(const std::string& config, std::string& error) {
+            startAtNs = wallNs() + START_LEAD_NS;
+            for (auto& agent : agents) {
+                encoder.begin(Type::Start);
+                encoder.i64(agent.helloSentNs);
+                encoder.i64(agent.helloReceivedNs);
+                encoder.i64(wallNs());
+                encoder.i64(startAtNs);
+                encoder.text(config);
+                if (!sendAll(agent.fd, encoder.frame())) {
+                    error = "Cannot start agent " + agent.host + ": " + std::strerror(errno);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // [O(agents)] Waits up to timeoutMs for frames and applies them; false once every agent is done
+        bool poll(int timeoutMs) {
+            std::vector<pollfd> fds;
+            for (const auto& agent : agents) {
+                if (agent.fd >= 0) fds.push_back({agent.fd, POLLIN, 0});
+            }
+            if (fds.empty()) return false;
+            if (::poll(fds.data(), fds.size(), timeoutMs) <= 0) return true;
+
+            uint8_t chunk[16384];
+            for (auto& agent : agents) {
+                if (agent.fd < 0) continue;
+                const ssize_t n = recv(agent.fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+                if (n < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+                if (n <= 0) {
+                    close(agent.fd);
+                    agent.fd = -1;
+                    continue;
+                }
+                agent.reader.feed(chunk, static_cast<size_t>(n));
+                Type type;
+                const uint8_t* data;
+                size_t size;
+                while (agent.reader.next(type, data, size)) handle(agent, type, data, size);
+                if (agent.reader.failed() || agent.finished) {
+                    close(agent.fd);
+                    agent.fd = -1;
+                }
+            }
+            return true;
+        }
+    };
+#endif
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>       //? Provides std::string, device names and error messages.
+#include <memory>       //! Provides std::unique_ptr, the backend's private state.
+#include <cstdint>      //! Provides uint64_t operation and byte counts.
+
+/*
+ * GPU compute load (--gpu): keeps the device busy next to the CPU workers, so the whole node
+ * draws the power it draws in production.
+ *
+ *   compute queue   [ modexp ][ GEMM ][ copy ][ modexp ][ GEMM ][ copy ] ...   one round each
+ *   transfer queue  [ host -> device | device -> host ][ host -> device | ...
+ *                    ^ pinned staging buffer, runs while the kernels run
+ *
+ *   modexp   computeIntensiveHash per work item, ModExpWorkload's inputs for worker 0
+ *            (64-bit integer multiply and modulo); the launch size adapts to ~100 ms
+ *   GEMM     FP32 N x N matrix product, tiled through local memory, 2 N^3 flops
+ *   copy     device memory to device memory, float4 per work item, 2 x bytes moved
+ *
+ * The backend is the OpenCL target built from src/GpuOpenCL.cpp, which CMake only adds (and
+ * links) when it finds an OpenCL SDK; it defines STRESS_TESTER_GPU. Without it, open() fails
+ * with a message and nothing else changes. Kernel times come from the queue's profiling
+ * events, so the rates are the device's own and not diluted by the round robin.
+ */
+namespace Gpu {
+
+#ifdef STRESS_TESTER_GPU
+    constexpr bool BUILT = true;
+#else
+    constexpr bool BUILT = false;
+#endif
+
+    // Inputs of modexp work item `index`, as ModExpWorkload computes them for thread 0
+    constexpr uint64_t MODEXP_MODULUS = 1000012347ull;
+    constexpr uint64_t modexpBase(uint64_t index) { return index * 987654321ull; }
+    constexpr uint64_t modexpExponent(uint64_t index) { return index % 2000 + 500; }
+
+    struct Device {
+        std::string name, platform, version;
+        uint64_t memoryBytes = 0;
+        unsigned computeUnits = 0;
+    };
+
+    // What one round did; the *Seconds are device time, wallSeconds the host's view of the round
+    struct Round {
+        uint64_t modexpOps = 0;
+        uint64_t modexpFirst = 0, modexpFirstResult = 0;    // Index and result of the round's first work item
+        double gemmFlops = 0.0;
+        uint64_t deviceBytes = 0, transferBytes = 0;
+        double modexpSeconds = 0.0, gemmSeconds = 0.0, copySeconds = 0.0, transferSeconds = 0.0, wallSeconds = 0.0;
+
+        void add(const Round& other) {
+            modexpOps += other.modexpOps;
+            gemmFlops += other.gemmFlops;
+            deviceBytes += other.deviceBytes;
+            transferBytes += other.transferBytes;
+            modexpSeconds += other.modexpSeconds;
+            gemmSeconds += other.gemmSeconds;
+            copySeconds += other.copySeconds;
+            transferSeconds += other.transferSeconds;
+            wallSeconds += other.wallSeconds;
+        }
+
+        // Share of the transfer time hidden behind the kernels (0 = serialised, 1 = fully overlapped)
+        double overlap() const {
+            if (transferSeconds <= 0.0) return 0.0;
+            const double hidden = modexpSeconds + gemmSeconds + copySeconds + transferSeconds - wallSeconds;
+            return hidden <= 0.0 ? 0.0 : hidden >= transferSeconds ? 1.0 : hidden / transferSeconds;
+        }
+    };
+
+    // One device: its context, two queues, the compiled kernels and their buffers
+    class Stress {
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+
+    public:
+        Stress();
+        ~Stress();
+        Stress(const Stress&) = delete;
+        Stress& operator=(const Stress&) = delete;
+
+        // Picks device `index` (GPUs first, then other OpenCL devices), builds the kernels and
+        // allocates every buffer; false with `error` set
+        bool open(unsigned index, std::string& error);
+        const Device& device() const;
+
+        // [O(round)] One transfer pair overlapped with one launch of each kernel; blocks until all finish
+        bool round(Round& done, std::string& error);
+    };
+
+#ifndef STRESS_TESTER_GPU
+    struct Stress::Impl {};
+
+    inline Stress::Stress() = default;
+    inline Stress::~Stress() = default;
+
+    inline bool Stress::open(unsigned, std::string& error) {
+        error = "This build has no GPU backend (CMake found no OpenCL SDK)";
+        return false;
+    }
+
+    inline const Device& Stress::device() const {
+        static const Device none;
+        return none;
+    }
+
+    inline bool Stress::round(Round&, std::string& error) {
+        error = "This build has no GPU backend";
+        return false;
+    }
+#endif
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>        //? Provides std::array, the fixed bucket table.
+#include <cstdint>      //! Provides fixed-width integer types for counts and values.
+#include <algorithm>    //? Provides std::min/std::max for merging extremes.
+
+/*
+ * Log-linear (HDR-style) histogram of non-negative integer values, e.g. nanoseconds.
+ *
+ * Values below 2^SUB_BITS get one bucket each; above that every power of two is
+ * split into 2^SUB_BITS equal sub-buckets, so any recorded value is known to within
+ * 1/2^SUB_BITS (about 3%) of itself, from nanoseconds up to 2^MAX_EXPONENT (~18 min).
+ *
+ *   value:   0 1 .. 31 | 32 33 .. 63 | 64 66 .. 126 | 128 132 .. 252 | ...
+ *   bucket:  0 1 .. 31 | 32 33 .. 63 | 64 65 .. 95  | 96  97  .. 127 | ...
+ *
+ * One histogram belongs to one thread: record() is a plain increment with no atomics
+ * or locks. Per-thread histograms are combined with merge() once their owners stopped.
+ */
+namespace Histogram {
+
+    class LogLinear {
+    public:
+        static constexpr int SUB_BITS = 5;
+        static constexpr uint64_t SUB = uint64_t(1) << SUB_BITS;
+        static constexpr int MAX_EXPONENT = 40;
+        static constexpr size_t BUCKETS = (MAX_EXPONENT - SUB_BITS + 2) * SUB;
+
+    private:
+        std::array<uint64_t, BUCKETS> counts{};
+        uint64_t total = 0;
+        uint64_t smallest = UINT64_MAX;
+        uint64_t largest = 0;
+
+    public:
+        // [O(1)] Bucket of a value (values beyond the range land in the last bucket)
+        static size_t bucketOf(uint64_t value) {
+            if (value < SUB) return static_cast<size_t>(value);
+            const int exponent = 63 - __builtin_clzll(value);
+            if (exponent > MAX_EXPONENT) return BUCKETS - 1;
+            const int shift = exponent - SUB_BITS;
+            return static_cast<size_t>((shift + 1) * SUB + ((value >> shift) - SUB));
+        }
+
+        // [O(1)] Highest value that maps to a bucket
+        static uint64_t upperBound(size_t bucket) {
+            if (bucket < SUB) return bucket;
+            const int shift = static_cast<int>(bucket / SUB) - 1;
+            const uint64_t sub = bucket % SUB + SUB;
+            return ((sub + 1) << shift) - 1;
+        }
+
+        void record(uint64_t value) { // [O(1)]
+            ++counts[bucketOf(value)];
+            ++total;
+            smallest = std::min(smallest, value);
+            largest = std::max(largest, value);
+        }
+
+        void merge(const LogLinear& other) { // [O(buckets)]
+            for (size_t b = 0; b < BUCKETS; ++b) counts[b] += other.counts[b];
+            total += other.total;
+            smallest = std::min(smallest, other.smallest);
+            largest = std::max(largest, other.largest);
+        }
+
+        uint64_t count() const { return total; }
+        uint64_t min() const { return total ? smallest : 0; }
+        uint64_t max() const { return largest; }
+
+        // [O(buckets)] Value at quantile q (0..1), reported as its bucket's upper bound (exact max at q = 1)
+        uint64_t percentile(double q) const {
+            if (total == 0) return 0;
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * total + 0.5));
+            uint64_t seen = 0;
+            for (size_t b = 0; b < BUCKETS; ++b) {
+                seen += counts[b];
+                if (seen >= rank) return std::min(upperBound(b), largest);
+            }
+            return largest;
+        }
+
+        // [O(buckets)] Number of recorded values above `threshold` (bucket resolution)
+        uint64_t countAbove(uint64_t threshold) const {
+            uint64_t above = 0;
+            for (size_t b = bucketOf(threshold) + 1; b < BUCKETS; ++b) above += counts[b];
+            return above;
+        }
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>      //? Provides size_t for the node count.
+#include <utility>      //! Provides std::move, used when storing elements in nodes.
+
+    // Template class for a LinkedList
+    template <typename T>
+    class LinkedList {
+    private:
+    // Internal structure representing a node in the LinkedList
+    struct Node {
+        T data;       // Data stored in the node
+        Node *next;   // Pointer to the next node
+
+        // Constructor to initialize a node with given data (move semantics used for efficiency)
+        explicit Node(T &&data) : data(std::move(data)), next(nullptr) {}
+    };
+
+    Node *head;     // Pointer to the first node in the LinkedList
+    Node *tail;     // Pointer to the last node in the LinkedList
+    size_t size;    // Tracks the number of nodes in the LinkedList
+
+    public:
+    // Constructor: Initializes an empty LinkedList
+    LinkedList() : head(nullptr), tail(nullptr), size(0) {}
+
+    // The list owns its nodes, so it is neither copyable nor assignable
+    LinkedList(const LinkedList &) = delete;
+    LinkedList &operator=(const LinkedList &) = delete;
+
+    // Destructor: Frees every node (and with it each element)
+    ~LinkedList() { clear(); }
+
+    // Adds a new element to the end of the LinkedList using move semantics
+    void push_back(T &&value) {
+        Node *newNode = new Node(std::move(value)); // Create a new node with the given value
+        if (!head) { // If the list is empty, initialize both head and tail to the new node
+        head = tail = newNode;
+        } else { // Otherwise, append the new node to the end of the list
+        tail->next = newNode;
+        tail = newNode;
+        }
+        ++size; // Increment the size of the list
+    }
+
+    // Returns the last element (the list must not be empty)
+    T &back() { return tail->data; }
+
+    // [O(n)] Calls fn(element) for every element from head to tail
+    template <typename Fn>
+    void forEach(Fn &&fn) {
+        for (Node *node = head; node; node = node->next) fn(node->data);
+    }
+
+    template <typename Fn>
+    void forEach(Fn &&fn) const {
+        for (const Node *node = head; node; node = node->next) fn(node->data);
+    }
+
+    // [O(n)] Deletes every node and leaves the list empty
+    void clear() {
+        while (head) {
+        Node *next = head->next;
+        delete head;
+        head = next;
+        }
+        tail = nullptr;
+        size = 0;
+    }
+
+    // Returns the current size of the LinkedList
+    size_t getSize() const { return size; }
+    };
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>       //! Provides steady_clock, used to time latency chases.
+#include <cstddef>      //? Provides size_t.
+#include <cstdint>      //! Provides uint64_t for the chase state.
+#include <utility>      //? Provides std::swap, used by the visit-order shuffle.
+
+/*
+ * Memory bandwidth and latency kernels that work on memory the caller already owns.
+ *
+ * The STREAM kernels (McCalpin) run over three equally sized double arrays and return
+ * the bytes they moved, counted the STREAM way (reads + writes, no write-allocate).
+ *
+ * The latency chase links every cache line of a working set into one cycle
+ * in random order and walks it with dependent loads, so neither the prefetchers
+ * nor out-of-order execution can hide the access latency.
+ */
+namespace MemoryBench {
+
+    enum class StreamKernel { Copy, Scale, Add, Triad };
+
+    constexpr StreamKernel STREAM_KERNELS[] = {StreamKernel::Copy, StreamKernel::Scale, StreamKernel::Add, StreamKernel::Triad};
+
+    constexpr const char* name(StreamKernel kernel) {
+        switch (kernel) {
+            case StreamKernel::Copy:  return "copy";
+            case StreamKernel::Scale: return "scale";
+            case StreamKernel::Add:   return "add";
+            default:                  return "triad";
+        }
+    }
+
+    // Scalar of scale and triad. One copy/scale/add/triad round multiplies `a` by 2q + q^2, so
+    // STREAM's 3.0 grows the arrays 15x per round and overflows to inf after about 260 rounds;
+    // q = sqrt(2) - 1 makes that factor 1 (this rounding settles on a fixed point just under 1.0,
+    // checked over 2M rounds), so a soak streams the same finite values forever.
+    constexpr double STREAM_SCALAR = 0.41421356237309503;
+
+    // [O(n)] One pass of `kernel` over a, b, c (n doubles each); returns bytes moved
+    inline size_t streamPass(StreamKernel kernel, double* __restrict a, double* __restrict b, double* __restrict c,
+                             size_t n, double scalar) {
+        switch (kernel) {
+            case StreamKernel::Copy:
+                for (size_t i = 0; i < n; ++i) c[i] = a[i];
+                return 2 * n * sizeof(double);
+            case StreamKernel::Scale:
+                for (size_t i = 0; i < n; ++i) b[i] = scalar * c[i];
+                return 2 * n * sizeof(double);
+            case StreamKernel::Add:
+                for (size_t i = 0; i < n; ++i) c[i] = a[i] + b[i];
+                return 3 * n * sizeof(double);
+            default:
+                for (size_t i = 0; i < n; ++i) a[i] = b[i] + scalar * c[i];
+                return 3 * n * sizeof(double);
+        }
+    }
+
+    // STREAM's initial values; with STREAM_SCALAR they stay near 1 (no denormals, no overflow)
+    inline void streamInit(double* a, double* b, double* c, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = 1.0;
+            b[i] = 2.0;
+            c[i] = 0.0;
+        }
+    }
+
+    constexpr size_t LINE = 64;
+
+    // [O(bytes / LINE)] Links the cache lines of [base, base + bytes) into one cycle in random order.
+    // Each line's first word holds the address of the next line.
+    inline void buildChase(void* base, size_t bytes, uint64_t seed) {
+        char* lines = static_cast<char*>(base);
+        const size_t count = bytes / LINE;
+        if (count < 2) return;
+
+        // Shuffled visit order of line indices, stored temporarily in each line's second word
+        auto slot = [&](size_t k) -> uint64_t& { return reinterpret_cast<uint64_t*>(lines + k * LINE)[1]; };
+        for (size_t k = 0; k < count; ++k) slot(k) = k;
+        uint64_t state = seed | 1;
+        for (size_t k = count - 1; k > 0; --k) {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            std::swap(slot(k), slot(state % k));
+        }
+
+        // Visit order slot(0) -> slot(1) -> ... -> slot(count - 1) -> slot(0)
+        for (size_t k = 0; k < count; ++k) {
+            char* from = lines + slot(k) * LINE;
+            char* to = lines + slot((k + 1) % count) * LINE;
+            *reinterpret_cast<char**>(from) = to;
+        }
+    }
+
+    // [O(steps)] Walks a chase built by buildChase(); returns nanoseconds per dependent load
+    inline double chaseNanoseconds(void* base, size_t steps) {
+        char* p = static_cast<char*>(base);
+        auto start = std::chrono::steady_clock::now();
+        // Volatile loads: otherwise the compiler may sink the whole walk past the second clock read
+        for (size_t s = 0; s < steps; ++s) p = *reinterpret_cast<char* volatile*>(p);
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return elapsed / static_cast<double>(steps);
+    }
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <string>       //? Provides std::string, cgroup directory paths.
+#include <fstream>      //? Provides std::ifstream, used for the /proc and cgroup files.
+#include <cstdint>      //! Provides uint64_t byte and event counters.
+#include <algorithm>    //? Provides std::min/std::max, used for the headroom.
+#include <string_view>  //? Provides std::string_view, used to split /proc lines.
+
+#ifdef __linux__
+    #include <sys/mman.h>       //> madvise(MADV_DONTNEED): give a step back without unmapping it.
+    #include <sys/resource.h>   //> getrusage: this process's own major faults.
+    #include <unistd.h>         //> access() for the cgroup files.
+#endif
+
+/*
+ * Memory pressure (--mem-mode=pressure): grow resident memory in steps until the machine
+ * is short of it, and measure what that does, without being the process the OOM killer picks.
+ *
+ *   budget   min(MemAvailable, tightest cgroup limit - usage) when the test starts
+ *   target   --pressure-target % of the budget; above 100 % only with --pressure-swap,
+ *            the rest is pushed out to swap / zram (at most 90 % of SwapFree)
+ *
+ *   held ^                                  _____ back-off: PSI full over --pressure-backoff,
+ *        |                   ______________|     |____ or headroom gone -> drop the last step
+ *        |          ________|
+ *        |   ______|   one --pressure-step every --pressure-dwell while there is headroom
+ *        |__|________________________________________________________________> time
+ *
+ * Headroom is re-read before every step: MemAvailable must stay above a floor (2 % of RAM,
+ * at least 256 MB) and every cgroup level above 5 % of its limit (at least 64 MB), unless
+ * swap may take the excess. What the test keeps is touched continuously, so the kernel has to
+ * reclaim from everyone else to satisfy it; the figures reported are the system's major
+ * faults, swap traffic, direct reclaim and the PSI stall time of /proc/pressure/memory.
+ */
+namespace MemoryPressure {
+
+    constexpr uint64_t UNLIMITED = UINT64_MAX;
+
+    struct Meminfo {
+        uint64_t total = 0, available = 0, swapTotal = 0, swapFree = 0;    // Bytes
+        bool ok = false;
+    };
+
+    // [O(file)] /proc/meminfo; ok is false when MemAvailable is missing (not Linux, kernel < 3.14)
+    inline Meminfo meminfo() {
+        Meminfo info;
+        std::ifstream file("/proc/meminfo");
+        std::string key;
+        uint64_t kb;
+        while (file >> key >> kb) {
+            if (key == "MemTotal:") info.total = kb * 1024;
+            else if (key == "MemAvailable:") { info.available = kb * 1024; info.ok = true; }
+            else if (key == "SwapTotal:") info.swapTotal = kb * 1024;
+            else if (key == "SwapFree:") info.swapFree = kb * 1024;
+            file.ignore(256, '\n');
+        }
+        return info;
+    }
+
+    // Memory controller of this process: the tightest limit on its way to the root
+    struct Cgroup {
+        std::string directory;          // Leaf directory (empty: no memory controller found)
+        uint64_t limit = UNLIMITED;     // Of the level with the least headroom
+        uint64_t usage = 0;
+        bool v2 = false;
+
+        uint64_t headroom() const { return limit == UNLIMITED ? UNLIMITED : limit - std::min(limit, usage); }
+    };
+
+    inline bool readNumber(const std::string& path, uint64_t& value) {
+        std::ifstream file(path);
+        std::string text;
+        if (!(file >> text)) return false;
+        if (text == "max") value = UNLIMITED;
+        else if (text.find_first_not_of("0123456789") == std::string::npos) value = std::stoull(text);
+        else return false;
+        return true;
+    }
+
+    // [O(depth)] Finds the memory cgroup in /proc/self/cgroup (v1 "N:...memory...:/path" first, else
+    // v2 "0::/path") and walks up to the mount point. Inside a cgroup namespace the path may not
+    // exist under the mount, in which case the mount root is this process's cgroup.
+    inline Cgroup cgroup() {
+        Cgroup group;
+    #ifdef __linux__
+        std::ifstream file("/proc/self/cgroup");
+        std::string line, v1Path, v2Path;
+        bool hasV1 = false, hasV2 = false;
+        while (std::getline(file, line)) {
+            const size_t first = line.find(':'), second = line.find(':', first + 1);
+            if (first == std::string::npos || second == std::string::npos) continue;
+            const std::string_view controllers = std::string_view(line).substr(first + 1, second - first - 1);
+            const std::string path = line.substr(second + 1);
+            if (controllers.empty()) { v2Path = path; hasV2 = true; continue; }
+            for (std::string_view rest = controllers; !rest.empty();) {
+                const std::string_view item = rest.substr(0, rest.find(','));
+                if (item == "memory") { v1Path = path; hasV1 = true; }
+                rest.remove_prefix(std::min(rest.size(), item.size() + 1));
+            }
+        }
+
+        std::string mount, path, limitFile, usageFile;
+        if (hasV1 && access("/sys/fs/cgroup/memory/memory.limit_in_bytes", R_OK) == 0) {
+            mount = "/sys/fs/cgroup/memory", path = v1Path;
+            limitFile = "/memory.limit_in_bytes", usageFile = "/memory.usage_in_bytes";
+        } else if (hasV2) {
+            mount = access("/sys/fs/cgroup/cgroup.controllers", R_OK) == 0 ? "/sys/fs/cgroup" : "/sys/fs/cgroup/unified";
+            path = v2Path, group.v2 = true;
+            limitFile = "/memory.max", usageFile = "/memory.current";
+        } else {
+            return group;
+        }
+        if (path == "/" || access((mount + path).c_str(), R_OK) != 0) path.clear();
+        group.directory = mount + path;
+
+        uint64_t best = UNLIMITED;
+        while (true) { // [O(depth)] Leaf to root; the root of v2 has no memory.max
+            uint64_t limit = 0, usage = 0;
+            const std::string directory = mount + path;
+            if (readNumber(directory + limitFile, limit) && readNumber(directory + usageFile, usage)
+                && limit < (uint64_t(1) << 62)) { // v1 reports "unlimited" as a huge page-rounded number
+                const uint64_t headroom = limit - std::min(limit, usage);
+                if (headroom < best) {
+                    best = headroom;
+                    group.limit = limit;
+                    group.usage = usage;
+                }
+            }
+            if (path.empty()) break;
+            path.resize(path.rfind('/'));
+        }
+    #endif
+        return group;
+    }
+
+    // System-wide pressure stall information; avg10 in %, totals in microseconds
+    struct Psi {
+        double someAvg10 = 0.0, fullAvg10 = 0.0;
+        uint64_t someUs = 0, fullUs = 0;
+        bool ok = false;
+    };
+
+    // [O(1)] "some avg10=1.23 avg60=... avg300=... total=N" and the same for "full"
+    inline Psi pressure() {
+        Psi psi;
+        std::ifstream file("/proc/pressure/memory");
+        std::string line;
+        while (std::getline(file, line)) {
+            const bool some = line.starts_with("some"), full = line.starts_with("full");
+            const size_t avg = line.find("avg10="), total = line.find("total=");
+            if ((!some && !full) || avg == std::string::npos || total == std::string::npos) continue;
+            const double avg10 = std::stod(line.substr(avg + 6));
+            const uint64_t us = std::stoull(line.substr(total + 6));
+            (some ? psi.someAvg10 : psi.fullAvg10) = avg10;
+            (some ? psi.someUs : psi.fullUs) = us;
+            psi.ok = true;
+        }
+        return psi;
+    }
+
+    // Reclaim-related event counters from /proc/vmstat (since boot)
+    struct VmCounters {
+        uint64_t majorFaults = 0;       // pgmajfault
+        uint64_t swapIns = 0, swapOuts = 0;     // pswpin / pswpout (pages)
+        uint64_t directReclaims = 0;    // allocstall_*: allocations that had to reclaim themselves
+        uint64_t pagesReclaimed = 0;    // pgsteal_*
+    };
+
+    inline VmCounters vmstat() {
+        VmCounters counters;
+        std::ifstream file("/proc/vmstat");
+        std::string key;
+        uint64_t value;
+        while (file >> key >> value) {
+            if (key == "pgmajfault") counters.majorFaults = value;
+            else if (key == "pswpin") counters.swapIns = value;
+            else if (key == "pswpout") counters.swapOuts = value;
+            else if (key.starts_with("allocstall_")) counters.directReclaims += value;
+            else if (key.starts_with("pgsteal_") && key != "pgsteal_anon" && key != "pgsteal_file") counters.pagesReclaimed += value;
+        }
+        return counters;
+    }
+
+    // Major faults taken by this process (its own pages coming back from swap or the page cache)
+    inline uint64_t ownMajorFaults() {
+    #ifdef __linux__
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<uint64_t>(usage.ru_majflt);
+    #endif
+        return 0;
+    }
+
+    // MemAvailable the test leaves alone, and the same per cgroup level
+    inline uint64_t memoryFloor(const Meminfo& info) { return std::max<uint64_t>(info.total / 50, uint64_t(256) << 20); }
+    inline uint64_t cgroupFloor(const Cgroup& group) { return std::max<uint64_t>(group.limit / 20, uint64_t(64) << 20); }
+
+    // Bytes that may still be made resident: what RAM and the cgroup allow above their floors,
+    // plus 90 % of the free swap when swapping is allowed. Negative when already past a floor.
+    inline int64_t headroom(const Meminfo& info, const Cgroup& group, bool swap) {
+        const int64_t swapShare = swap ? static_cast<int64_t>(info.swapFree / 10 * 9) : 0;
+        int64_t room = static_cast<int64_t>(info.available) - static_cast<int64_t>(memoryFloor(info));
+        if (group.limit != UNLIMITED) {
+            room = std::min(room, static_cast<int64_t>(group.headroom()) - static_cast<int64_t>(cgroupFloor(group)));
+        }
+        return room + swapShare;
+    }
+
+    // [O(bytes / page)] Drops a step's pages; the range stays mapped and reads back as zero
+    inline bool discard(void* base, size_t bytes) {
+    #ifdef __linux__
+        return madvise(base, bytes, MADV_DONTNEED) == 0;
+    #else
+        (void)base;
+        (void)bytes;
+        return false;
+    #endif
+    }
+}
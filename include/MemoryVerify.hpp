@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>      //? Provides size_t.
+#include <cstdint>      //! Provides uint64_t words and uintptr_t addresses.
+#include <string_view>  //? Provides std::string_view, used for pattern names.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>  //> AVX2 compare loops (_mm256_xor_si256 / _mm256_testz_si256).
+    #define STRESS_VERIFY_AVX2 1
+#else
+    #define STRESS_VERIFY_AVX2 0
+#endif
+
+#ifdef __linux__
+    #include <fcntl.h>      //> open() for /proc/self/pagemap.
+    #include <unistd.h>     //> pread / close / sysconf.
+#endif
+
+/*
+ * Memory integrity patterns: write a region, read it back, report every word that differs.
+ *
+ *   walking ones:      every word = 1 << k, k advancing each pass (stuck or shorted data lines)
+ *   moving inversions: write p; ascending verify p / write ~p; descending verify ~p / write p
+ *                      (coupling faults between neighbouring cells, in both address orders)
+ *   address:           every word holds its own address, then its complement (address lines,
+ *                      aliasing: a word written through the wrong address shows the other one)
+ *   random:            splitmix64(seed, word index), a new seed each pass (data-dependent faults)
+ *
+ * The compare loops OR together (read ^ expected) over 128-byte blocks and only look at single
+ * words when a block is non-zero, so a clean pass costs one XOR + OR per word; on x86 with AVX2
+ * that runs four words per instruction. Expected values depend only on the pattern, the pass and
+ * the word's address, so every verifying thread can work on its own slice independently.
+ */
+namespace MemoryVerify {
+
+    enum Pattern { WalkingOnes, MovingInversions, AddressInAddress, Random, PATTERN_COUNT };
+
+    constexpr const char* name(int pattern) {
+        constexpr const char* NAMES[PATTERN_COUNT] = {"walking", "inversions", "address", "random"};
+        return NAMES[pattern];
+    }
+
+    inline bool parsePattern(std::string_view text, int& pattern) {
+        for (int p = 0; p < PATTERN_COUNT; ++p) {
+            if (text == name(p)) {
+                pattern = p;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // [O(1)] Counter-based generator: any word's expected value without replaying the sequence
+    inline uint64_t splitmix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Physical address of a mapped byte from /proc/self/pagemap; 0 when not permitted (needs CAP_SYS_ADMIN)
+    inline uint64_t physicalAddress(const void* address) {
+    #ifdef __linux__
+        const int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return 0;
+        const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        const uint64_t virt = reinterpret_cast<uintptr_t>(address);
+        uint64_t entry = 0;
+        const bool ok = pread(fd, &entry, sizeof(entry), static_cast<off_t>(virt / page * sizeof(entry))) == sizeof(entry);
+        close(fd);
+        const uint64_t frame = entry & ((uint64_t(1) << 55) - 1); // Bits 0-54: PFN (zero without privilege)
+        if (!ok || !(entry >> 63) || frame == 0) return 0;        // Bit 63: page present
+        return frame * page + virt % page;
+    #else
+        (void)address;
+        return 0;
+    #endif
+    }
+
+    // One word that did not read back as written
+    struct Mismatch {
+        uintptr_t address = 0;
+        uint64_t expected = 0;
+        uint64_t actual = 0;
+        uint64_t physical = 0;      // Resolved while the page was still mapped; 0 when pagemap is not readable
+        int pattern = 0;
+        uint64_t pass = 0;
+    };
+
+    // Per verifying thread; written only by its owner
+    struct Results {
+        static constexpr size_t KEPT = 16;      // Mismatches recorded in full (all are counted)
+
+        uint64_t passes[PATTERN_COUNT] = {};
+        uint64_t bytes = 0;                     // Written + read back
+        uint64_t mismatches = 0;
+        uint64_t bitFlips[64] = {};             // Per data bit: how often it read back wrong
+        Mismatch kept[KEPT];
+        size_t keptCount = 0;
+
+        void record(const uint64_t* word, uint64_t expected, int pattern, uint64_t pass) {
+            const uint64_t flipped = *word ^ expected;
+            ++mismatches;
+            for (int bit = 0; bit < 64; ++bit) bitFlips[bit] += (flipped >> bit) & 1;
+            if (keptCount < KEPT) { // [O(1) syscalls] At most KEPT pagemap lookups per thread
+                kept[keptCount++] = {reinterpret_cast<uintptr_t>(word), expected, *word, physicalAddress(word), pattern, pass};
+            }
+        }
+    };
+
+    // ============================================================================================
+    // COMPARE LOOPS: return true when every word matched; mismatching words go to `results`
+    // ============================================================================================
+
+    // Scalar check of one block, used to pin down which words of a dirty block differ
+    template <typename Expected>
+    inline void locate(const uint64_t* p, size_t n, Expected&& expected, Results& results, int pattern, uint64_t pass) {
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t want = expected(p + i);
+            if (p[i] != want) results.record(p + i, want, pattern, pass);
+        }
+    }
+
+    #if STRESS_VERIFY_AVX2
+    // [O(n)] 16 words (128 bytes) per iteration, one branch per block
+    __attribute__((target("avx2")))
+    inline bool verifyLinearAvx2(const uint64_t* p, size_t n, uint64_t start, uint64_t step, uint64_t invert,
+                                 Results& results, int pattern, uint64_t pass) {
+        const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(invert));
+        const __m256i stride = _mm256_set1_epi64x(static_cast<long long>(4 * step));
+        __m256i value = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(start)),
+                                         _mm256_set_epi64x(static_cast<long long>(3 * step), static_cast<long long>(2 * step),
+                                                           static_cast<long long>(step), 0));
+        bool clean = true;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m256i diff = _mm256_setzero_si256();
+            for (int lane = 0; lane < 4; ++lane) {
+                const __m256i word = _mm256_load_si256(reinterpret_cast<const __m256i*>(p + i + 4 * lane));
+                diff = _mm256_or_si256(diff, _mm256_xor_si256(word, _mm256_xor_si256(value, mask)));
+                value = _mm256_add_epi64(value, stride);
+            }
+            if (!_mm256_testz_si256(diff, diff)) {
+                clean = false;
+                const uint64_t base = start + i * step;
+                locate(p + i, 16, [&](const uint64_t* w) { return (base + uint64_t(w - (p + i)) * step) ^ invert; },
+                       results, pattern, pass);
+            }
+        }
+        const uint64_t base = start + i * step;
+        const size_t before = results.mismatches;
+        locate(p + i, n - i, [&](const uint64_t* w) { return (base + uint64_t(w - (p + i)) * step) ^ invert; },
+               results, pattern, pass);
+        return clean && results.mismatches == before;
+    }
+    #endif
+
+    // [O(n)] Word i must equal (start + i * step) ^ invert: step 0 is a constant, step 8 with
+    // start = address is the address-in-address pattern. `p` must be 32-byte aligned.
+    inline bool verifyLinear(const uint64_t* p, size_t n, uint64_t start, uint64_t step, uint64_t invert,
+                             Results& results, int pattern, uint64_t pass) {
+    #if STRESS_VERIFY_AVX2
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        if (avx2) return verifyLinearAvx2(p, n, start, step, invert, results, pattern, pass);
+    #endif
+        const size_t before = results.mismatches;
+        for (size_t i = 0; i < n; i += 16) {
+            const size_t block = n - i < 16 ? n - i : 16;
+            uint64_t diff = 0;
+            for (size_t j = 0; j < block; ++j) diff |= p[i + j] ^ ((start + (i + j) * step) ^ invert);
+            if (diff) {
+                const uint64_t base = start + i * step;
+                locate(p + i, block, [&](const uint64_t* w) { return (base + uint64_t(w - (p + i)) * step) ^ invert; },
+                       results, pattern, pass);
+            }
+        }
+        return results.mismatches == before;
+    }
+
+    inline void writeLinear(uint64_t* p, size_t n, uint64_t start, uint64_t step, uint64_t invert) {
+        for (size_t i = 0; i < n; ++i) p[i] = (start + i * step) ^ invert; // [O(n)] Vectorised by the compiler
+    }
+
+    // [O(n)] Random pattern: word at global index `first + i` holds splitmix64(seed ^ index)
+    inline bool verifyRandom(const uint64_t* p, size_t n, uint64_t first, uint64_t seed,
+                             Results& results, int pattern, uint64_t pass) {
+        const size_t before = results.mismatches;
+        for (size_t i = 0; i < n; i += 16) {
+            const size_t block = n - i < 16 ? n - i : 16;
+            uint64_t diff = 0;
+            for (size_t j = 0; j < block; ++j) diff |= p[i + j] ^ splitmix64(seed ^ (first + i + j));
+            if (diff) {
+                locate(p + i, block, [&](const uint64_t* w) { return splitmix64(seed ^ (first + uint64_t(w - p))); },
+                       results, pattern, pass);
+            }
+        }
+        return results.mismatches == before;
+    }
+
+    inline void writeRandom(uint64_t* p, size_t n, uint64_t first, uint64_t seed) {
+        for (size_t i = 0; i < n; ++i) p[i] = splitmix64(seed ^ (first + i));
+    }
+
+    // [O(n)] Moving-inversion read-modify step, descending: verify `expected`, write `next`, high to low
+    inline void verifyWriteDescending(uint64_t* p, size_t n, uint64_t expected, uint64_t next,
+                                      Results& results, int pattern, uint64_t pass) {
+        for (size_t i = n; i-- > 0;) {
+            if (p[i] != expected) results.record(p + i, expected, pattern, pass);
+            p[i] = next;
+        }
+    }
+
+    // [O(n)] Ascending counterpart
+    inline void verifyWriteAscending(uint64_t* p, size_t n, uint64_t expected, uint64_t next,
+                                     Results& results, int pattern, uint64_t pass) {
+        for (size_t i = 0; i < n; ++i) {
+            if (p[i] != expected) results.record(p + i, expected, pattern, pass);
+            p[i] = next;
+        }
+    }
+
+    // Moving-inversion base pattern of a pass: solid and checkerboards for 4 passes, then one bit
+    // per byte walking from bit 0 to bit 7 for 8 passes (a cycle of 12)
+    inline uint64_t inversionPattern(uint64_t pass) {
+        constexpr uint64_t BASES[4] = {0, 0x5555555555555555ull, 0x3333333333333333ull, 0x0F0F0F0F0F0F0F0Full};
+        const uint64_t step = pass % 12;
+        return step < 4 ? BASES[step] : 0x0101010101010101ull << (step - 4);
+    }
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <string>       //? Provides std::string, used for endpoints and error messages.
+#include <vector>       //? Provides std::vector, the preallocated mmsghdr/iovec batches.
+#include <cstdint>      //! Provides fixed-width integer types for byte and packet counts.
+#include <cstring>      //? Provides std::memset / std::strerror.
+#include <string_view>  //? Provides std::string_view, used for protocol names and HOST:PORT parsing.
+
+#ifdef __linux__
+    #include <cerrno>               //> errno.
+    #include <fcntl.h>              //> open() for /proc/softirqs.
+    #include <netdb.h>              //> getaddrinfo for peer host names.
+    #include <unistd.h>             //> close / pread.
+    #include <sys/socket.h>         //> socket, sendmmsg / recvmmsg, MSG_ZEROCOPY, SO_ZEROCOPY.
+    #include <netinet/in.h>         //> sockaddr_in.
+    #include <linux/tcp.h>          //> TCP_INFO with tcpi_segs_out/in (glibc's tcp_info lacks them), TCP_NODELAY.
+    #include <arpa/inet.h>          //> htons / htonl.
+    #include <linux/errqueue.h>     //> sock_extended_err, SO_EE_ORIGIN_ZEROCOPY completions.
+#endif
+
+/*
+ * Network stress primitives (IPv4, Linux).
+ *
+ *   Flow:       one connected TCP or UDP socket per sending thread, another per receiving
+ *               thread; loopback mode runs both ends in this process, peer mode sends to
+ *               another instance started with --net-listen.
+ *   Zero copy:  TCP and UDP sends use MSG_ZEROCOPY (SO_ZEROCOPY) when the kernel allows it,
+ *               and the completion notifications are reaped from the socket error queue.
+ *               The payload never changes, so the buffer is reused without waiting for them.
+ *   Batches:    UDP goes through sendmmsg / recvmmsg, BATCH datagrams per syscall.
+ *   Softirqs:   NET_RX / NET_TX totals from /proc/softirqs, to set the packet rate against
+ *               the interrupt work it costs the compute threads.
+ */
+namespace Network {
+
+    enum class Protocol { Tcp, Udp };
+
+    inline bool parseProtocol(std::string_view name, Protocol& protocol) {
+        if (name == "tcp")      protocol = Protocol::Tcp;
+        else if (name == "udp") protocol = Protocol::Udp;
+        else return false;
+        return true;
+    }
+
+    constexpr const char* name(Protocol protocol) {
+        return protocol == Protocol::Udp ? "udp" : "tcp";
+    }
+
+    constexpr unsigned BATCH = 64;                  // Datagrams per sendmmsg / recvmmsg
+    constexpr size_t UDP_PAYLOAD = 1472;            // 1500-byte MTU minus IPv4 and UDP headers
+    constexpr size_t TCP_CHUNK = 64 * 1024;         // Bytes per TCP send
+    constexpr int TIMEOUT_MS = 200;                 // Socket timeouts, so threads notice the end of the run
+
+    // Splits "HOST:PORT" (the port is required)
+    inline bool splitEndpoint(std::string_view text, std::string& host, uint16_t& port) {
+        const size_t colon = text.rfind(':');
+        if (colon == std::string_view::npos || colon == 0 || colon + 1 == text.size()) return false;
+        unsigned long value = 0;
+        for (char c : text.substr(colon + 1)) {
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + static_cast<unsigned long>(c - '0');
+            if (value > 65535) return false;
+        }
+        if (value == 0) return false;
+        host = std::string(text.substr(0, colon));
+        port = static_cast<uint16_t>(value);
+        return true;
+    }
+
+    struct ZeroCopyCompletions {
+        uint64_t completed = 0;     // Sends the kernel has released
+        uint64_t copied = 0;        // ... of which it fell back to copying (always the case on loopback)
+    };
+
+#ifdef __linux__
+    inline bool resolve(const std::string& host, uint16_t port, sockaddr_in& address, std::string& error) {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        addrinfo* result = nullptr;
+        const int status = getaddrinfo(host.c_str(), nullptr, &hints, &result);
+        if (status != 0 || !result) {
+            error = "Cannot resolve " + host + ": " + gai_strerror(status);
+            return false;
+        }
+        address = *reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+        address.sin_port = htons(port);
+        freeaddrinfo(result);
+        return true;
+    }
+
+    inline void setTimeouts(int fd) {
+        timeval timeout{0, TIMEOUT_MS * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    }
+
+    // TCP: a listening socket. UDP: one receive socket; every receiver binds the same port
+    // with SO_REUSEPORT and the kernel spreads the flows over them. Port 0 picks a free one.
+    inline int openReceiver(Protocol protocol, bool loopbackOnly, uint16_t& port, std::string& error) {
+        const int fd = socket(AF_INET, (protocol == Protocol::Tcp ? SOCK_STREAM : SOCK_DGRAM) | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            error = std::string("socket: ") + std::strerror(errno);
+            return -1;
+        }
+        const int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (protocol == Protocol::Udp) setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+        address.sin_port = htons(port);
+        socklen_t length = sizeof(address);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            (protocol == Protocol::Tcp && listen(fd, 256) != 0) ||
+            getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            error = "Cannot listen on port " + std::to_string(port) + ": " + std::strerror(errno);
+            close(fd);
+            return -1;
+        }
+        port = ntohs(address.sin_port);
+        setTimeouts(fd);
+        return fd;
+    }
+
+    // Connected sending socket; `zeroCopy` is cleared when SO_ZEROCOPY is refused
+    inline int connectFlow(Protocol protocol, const sockaddr_in& peer, bool& zeroCopy, std::string& error) {
+        const int fd = socket(AF_INET, (protocol == Protocol::Tcp ? SOCK_STREAM : SOCK_DGRAM) | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            error = std::string("socket: ") + std::strerror(errno);
+            return -1;
+        }
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&peer), sizeof(peer)) != 0) {
+            error = std::string("connect: ") + std::strerror(errno);
+            close(fd);
+            return -1;
+        }
+        const int one = 1;
+        if (protocol == Protocol::Tcp) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (zeroCopy && setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) != 0) zeroCopy = false;
+        setTimeouts(fd);
+        return fd;
+    }
+
+    // [O(notifications)] Reaps MSG_ZEROCOPY notifications without blocking
+    inline void reapZeroCopy(int fd, ZeroCopyCompletions& completions) {
+        for (;;) {
+            alignas(cmsghdr) char control[128];
+            msghdr message;
+            std::memset(&message, 0, sizeof(message));
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            if (recvmsg(fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) return;
+
+            for (cmsghdr* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header)) {
+                if (header->cmsg_level != SOL_IP || header->cmsg_type != IP_RECVERR) continue;
+                const auto* notification = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(header));
+                if (notification->ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+                const uint64_t range = uint64_t(notification->ee_data) - notification->ee_info + 1; // [ee_info, ee_data]
+                completions.completed += range;
+                if (notification->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) completions.copied += range;
+            }
+        }
+    }
+
+    // [O(1)] Segments this TCP socket has sent and received so far (TCP_INFO)
+    inline void tcpSegments(int fd, uint64_t& out, uint64_t& in) {
+        tcp_info info;
+        socklen_t length = sizeof(info);
+        std::memset(&info, 0, sizeof(info));
+        if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &length) != 0) return;
+        out = info.tcpi_segs_out;
+        in = info.tcpi_segs_in;
+    }
+
+    // BATCH message headers over one payload buffer, built once per thread
+    class Datagrams {
+        std::vector<iovec> vectors;
+        std::vector<mmsghdr> headers;
+
+    public:
+        Datagrams(char* buffer, size_t payload) : vectors(BATCH), headers(BATCH) {
+            for (unsigned i = 0; i < BATCH; ++i) {
+                vectors[i] = {buffer, payload};
+                std::memset(&headers[i], 0, sizeof(mmsghdr));
+                headers[i].msg_hdr.msg_iov = &vectors[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+        }
+
+        mmsghdr* data() { return headers.data(); }
+        unsigned length(unsigned i) const { return headers[i].msg_len; }
+    };
+
+    // NET_RX + NET_TX softirqs raised so far, summed over all CPUs
+    class SoftirqCounter {
+        int fd = -1;
+        std::vector<char> buffer;
+
+        static uint64_t sumLine(const char* line) {
+            uint64_t total = 0;
+            const char* p = line;
+            while (*p && *p != ':') ++p;
+            while (*p && *p != '\n') {
+                while (*p == ' ' || *p == ':') ++p;
+                uint64_t value = 0;
+                while (*p >= '0' && *p <= '9') value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+                total += value;
+                if (*p != ' ' && *p != ':') break;
+            }
+            return total;
+        }
+
+    public:
+        SoftirqCounter() : fd(open("/proc/softirqs", O_RDONLY | O_CLOEXEC)), buffer(256 * 1024) {}
+        ~SoftirqCounter() { if (fd >= 0) close(fd); }
+        SoftirqCounter(const SoftirqCounter&) = delete;
+        SoftirqCounter& operator=(const SoftirqCounter&) = delete;
+
+        bool available() const { return fd >= 0; }
+
+        // [O(file)] Current NET_RX and NET_TX totals
+        bool read(uint64_t& rx, uint64_t& tx) {
+            if (fd < 0) return false;
+            const ssize_t length = pread(fd, buffer.data(), buffer.size() - 1, 0);
+            if (length <= 0) return false;
+            buffer[length] = '\0';
+            const char* text = buffer.data();
+            const char* rxLine = std::strstr(text, "NET_RX:");
+            const char* txLine = std::strstr(text, "NET_TX:");
+            if (!rxLine || !txLine) return false;
+            rx = sumLine(rxLine);
+            tx = sumLine(txLine);
+            return true;
+        }
+    };
+#endif
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>       //? Provides std::string, the backing file path.
+#include <fstream>      //? Provides std::ifstream, used for the Dirty / Writeback lines of /proc/meminfo.
+#include <cstring>      //? Provides std::strerror for the error messages.
+#include <cstdint>      //! Provides uint64_t byte counters.
+#include <cstddef>      //! Provides size_t mapping lengths.
+
+#ifdef __linux__
+    #include <fcntl.h>          //> open, posix_fadvise.
+    #include <unistd.h>         //> ftruncate, close, unlink, getpid.
+    #include <sys/mman.h>       //> mmap(MAP_SHARED), madvise, msync.
+    #include <sys/statvfs.h>    //> statvfs: free space, checked before the sparse file is mapped.
+    #include <cerrno>           //> errno after a failed call.
+#endif
+
+/*
+ * File-backed memory (--mem-mode=file): the blocks are a MAP_SHARED mapping of a sparse file,
+ * so every byte the test owns is a page-cache page that writeback has to clean.
+ *
+ *   file (sparse, ftruncate)   [ w0 ][ w1 ][ w2 ][ w3 ][ w4 ] ...     one window = --mem-file-window
+ *                                 ^     ^     ^
+ *                   evicted: MS_SYNC,   |     WILLNEED: read ahead of the stream
+ *                   DONTNEED (mapping   rewritten now, then MS_ASYNC
+ *                   and page cache)
+ *
+ * The whole mapping is MADV_SEQUENTIAL. After the first fill the stream rewrites one window at a
+ * time and queues its writeback; the window LAG behind is flushed synchronously and dropped from
+ * the page tables and the page cache, so the next lap has to read it back from the filesystem.
+ * Dirty pages pile up between the two, and when they reach the kernel's dirty limits the writes
+ * into the mapping themselves stall in balance_dirty_pages, the writeback stall of log-heavy services.
+ */
+namespace PageCache {
+
+    constexpr size_t LAG = 2;   // Windows between a window's rewrite and its eviction
+
+    struct Mapping {
+        int fd = -1;
+        char* base = nullptr;
+        size_t bytes = 0;
+        std::string path;
+    };
+
+#ifdef __linux__
+    // Creates the sparse backing file (no O_DIRECT: the page cache is the point) and maps it shared.
+    // A store into a hole the filesystem cannot back is a SIGBUS, so the free space is checked first.
+    inline bool create(const std::string& directory, size_t bytes, Mapping& mapping, std::string& error) {
+        struct statvfs space{};
+        if (statvfs(directory.c_str(), &space) == 0 && uint64_t(space.f_bavail) * space.f_frsize < bytes) {
+            error = directory + " has " + std::to_string(uint64_t(space.f_bavail) * space.f_frsize / (1024 * 1024))
+                  + " MB free, the file needs " + std::to_string(bytes / (1024 * 1024)) + " MB";
+            return false;
+        }
+        mapping.path = directory + "/stress_tester." + std::to_string(getpid()) + ".map";
+        mapping.fd = open(mapping.path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (mapping.fd < 0) {
+            error = "Cannot create " + mapping.path + ": " + std::strerror(errno);
+            return false;
+        }
+        void* base = MAP_FAILED;
+        if (ftruncate(mapping.fd, static_cast<off_t>(bytes)) != 0) {
+            error = "Cannot size " + mapping.path + ": " + std::strerror(errno);
+        } else if ((base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mapping.fd, 0)) == MAP_FAILED) {
+            error = "Cannot map " + mapping.path + ": " + std::strerror(errno);
+        }
+        if (base == MAP_FAILED) {
+            close(mapping.fd);
+            unlink(mapping.path.c_str());
+            mapping.fd = -1;
+            return false;
+        }
+        mapping.base = static_cast<char*>(base);
+        mapping.bytes = bytes;
+        return true;
+    }
+
+    // [O(bytes / page)] Drops a window from this mapping and from the page cache. POSIX_FADV_DONTNEED
+    // only drops clean pages, so the caller flushes the window with msync(MS_SYNC) first.
+    inline bool evict(const Mapping& mapping, size_t offset, size_t bytes) {
+        bool ok = madvise(mapping.base + offset, bytes, MADV_DONTNEED) == 0;
+        return posix_fadvise(mapping.fd, static_cast<off_t>(offset), static_cast<off_t>(bytes), POSIX_FADV_DONTNEED) == 0 && ok;
+    }
+
+    // Unmaps and deletes the backing file; dirty pages are thrown away with it, never written out
+    inline void remove(Mapping& mapping) {
+        if (mapping.fd < 0) return;
+        if (mapping.base) munmap(mapping.base, mapping.bytes);
+        close(mapping.fd);
+        unlink(mapping.path.c_str());
+        mapping = Mapping{};
+    }
+#endif
+
+    // System-wide page-cache state, bytes
+    struct Writeback {
+        uint64_t dirty = 0;         // Dirty: waiting for writeback
+        uint64_t writeback = 0;     // Writeback: being written right now
+    };
+
+    inline Writeback writeback() {
+        Writeback state;
+        std::ifstream file("/proc/meminfo");
+        std::string key;
+        uint64_t kb;
+        while (file >> key >> kb) {
+            if (key == "Dirty:") state.dirty = kb * 1024;
+            else if (key == "Writeback:") state.writeback = kb * 1024;
+            file.ignore(256, '\n');
+        }
+        return state;
+    }
+}
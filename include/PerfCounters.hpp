@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>      //! Provides fixed-width integer types for counter values.
+#include <cstring>      //? Provides std::memset / std::strerror, used for perf_event_attr and error text.
+#include <string>       //? Provides std::string, used for the open-failure reason.
+
+#ifdef __linux__
+    #include <cerrno>               //> errno from perf_event_open.
+    #include <unistd.h>             //> syscall(), read(), close(), sysconf().
+    #include <sys/mman.h>           //> mmap of the perf_event_mmap_page (rdpmc self-monitoring).
+    #include <sys/syscall.h>        //> SYS_perf_event_open (no glibc wrapper).
+    #include <linux/perf_event.h>   //> perf_event_attr, PERF_COUNT_HW_*.
+#endif
+
+/*
+ * Per-thread hardware performance counters (Linux perf_event_open).
+ *
+ * Each event is opened for the calling thread only (user mode) and its control page
+ * is mapped, so reads are done in user space with rdpmc under the page's seqlock:
+ *
+ *   do { seq = page->lock; idx = page->index; count = page->offset + rdpmc(idx - 1); } while (page->lock != seq)
+ *
+ * When rdpmc is not allowed, the event is not on the PMU right now, or it has been
+ * multiplexed, the read falls back to read(2) with enabled/running time scaling.
+ * Events the CPU does not have (e.g. stalled-cycles on many Intel parts) simply
+ * stay unavailable; the others still count.
+ */
+namespace Perf {
+
+    enum Event { Cycles, Instructions, CacheMisses, BranchMisses, StalledFrontend, StalledBackend, EVENT_COUNT };
+
+    constexpr const char* name(int event) {
+        constexpr const char* NAMES[EVENT_COUNT] = {
+            "cycles", "instructions", "cache-misses", "branch-misses", "stalled-cycles-frontend", "stalled-cycles-backend"};
+        return NAMES[event];
+    }
+
+    class ThreadCounters {
+    #ifdef __linux__
+        int fds[EVENT_COUNT] = {-1, -1, -1, -1, -1, -1};
+        perf_event_mmap_page* pages[EVENT_COUNT] = {};
+        size_t pageSize = 0;
+
+        static constexpr uint64_t CONFIG[EVENT_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND, PERF_COUNT_HW_STALLED_CYCLES_BACKEND};
+
+        // [O(1)] read(2) with multiplexing correction
+        uint64_t readSyscall(int event) const {
+            uint64_t values[3] = {}; // value, time_enabled, time_running
+            if (::read(fds[event], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) return 0;
+            if (values[2] == 0) return 0;
+            if (values[2] >= values[1]) return values[0];
+            return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+        }
+
+        // [O(1)] rdpmc under the control page's seqlock; falls back to read(2) when it cannot be used
+        uint64_t readUser(int event) const {
+        #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            const volatile perf_event_mmap_page* page = pages[event];
+            if (page) {
+                uint32_t seq, index;
+                uint64_t count, enabled, running;
+                do {
+                    seq = page->lock;
+                    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+                    enabled = page->time_enabled;
+                    running = page->time_running;
+                    index = page->index;
+                    count = page->offset;
+                    if (page->cap_user_rdpmc && index) {
+                        const unsigned width = page->pmc_width;
+                        int64_t pmc = static_cast<int64_t>(__builtin_ia32_rdpmc(static_cast<int>(index - 1)));
+                        pmc <<= 64 - width; // Sign-extend the width-bit hardware counter
+                        pmc >>= 64 - width;
+                        count += static_cast<uint64_t>(pmc);
+                    }
+                    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+                } while (page->lock != seq);
+
+                if (page->cap_user_rdpmc && index && enabled == running) return count;
+            }
+        #endif
+            return readSyscall(event);
+        }
+    #endif
+
+        bool any = false;
+        std::string failure;    // Why the first event could not be opened
+
+    public:
+        // Opens every event for the calling thread
+        ThreadCounters() {
+        #ifdef __linux__
+            pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            for (int event = 0; event < EVENT_COUNT; ++event) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = CONFIG[event];
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                fds[event] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+                if (fds[event] < 0) {
+                    if (failure.empty()) failure = std::string(name(event)) + ": " + std::strerror(errno);
+                    continue;
+                }
+                any = true;
+
+                void* page = mmap(nullptr, pageSize, PROT_READ, MAP_SHARED, fds[event], 0);
+                if (page != MAP_FAILED) pages[event] = static_cast<perf_event_mmap_page*>(page);
+            }
+        #else
+            failure = "perf_event_open is Linux only";
+        #endif
+        }
+
+        ~ThreadCounters() {
+        #ifdef __linux__
+            for (int event = 0; event < EVENT_COUNT; ++event) {
+                if (pages[event]) munmap(pages[event], pageSize);
+                if (fds[event] >= 0) close(fds[event]);
+            }
+        #endif
+        }
+
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+        bool available() const { return any; }
+        bool has(int event) const {
+        #ifdef __linux__
+            return fds[event] >= 0;
+        #else
+            (void)event;
+            return false;
+        #endif
+        }
+        const std::string& openFailure() const { return failure; }
+
+        // [O(events)] Current count of each event since the thread opened them (0 when unavailable).
+        // Must be called on the thread that constructed this object.
+        void read(uint64_t (&values)[EVENT_COUNT]) const {
+            for (int event = 0; event < EVENT_COUNT; ++event) {
+            #ifdef __linux__
+                values[event] = fds[event] >= 0 ? readUser(event) : 0;
+            #else
+                values[event] = 0;
+            #endif
+            }
+        }
+    };
+}
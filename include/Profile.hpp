@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cmath>        //! Provides std::fmod, used to place a time inside the profile and a wave period.
+#include <vector>       //? Provides std::vector, the profile steps.
+#include <cstdint>      //! Provides uint64_t, the packed control word.
+#include <algorithm>    //? Provides std::min, used for the time to the next edge.
+
+/*
+ * Phased load profiles: a list of steps played in order and repeated until the test ends.
+ *
+ *   --profile="60s cpu=100; 30s idle; 60s cpu=50 mem; 60s cpu=100 square=1hz duty=50"
+ *
+ *   step         60 s          30 s       60 s              60 s
+ *   workers  ___________                ______           _   _   _   _
+ *           |    100%   |____ 0% _____|  50%  |_________| |_| |_| |_| |_ ...
+ *   STREAM                              (mem on)
+ *
+ * A square wave alternates between the step's load (high, `duty` % of each period) and
+ * fully idle (low). The scheduler thread in SystemStressTest sleeps until the next edge
+ * and then publishes it: CPU workers through the pool's active-worker limit, which they
+ * already check between operations, and the memory side through one control word (below),
+ * which STREAM threads check between kernel passes.
+ */
+namespace Profile {
+
+    struct Step {
+        int seconds = 0;
+        int cpuPercent = 100;           // Share of the workers kept busy while high
+        bool memoryBandwidth = false;   // STREAM threads run while high (bandwidth memory mode)
+        double waveHz = 0.0;            // Square-wave frequency, 0 = steady
+        int dutyPercent = 50;           // Share of each wave period spent high
+    };
+
+    // Where a moment falls in the profile
+    struct State {
+        size_t step = 0;
+        bool high = true;               // Square-wave half; steady steps are always high
+        double untilChange = 0.0;       // Seconds to the next edge or step boundary
+    };
+
+    inline int totalSeconds(const std::vector<Step>& steps) {
+        int total = 0;
+        for (const auto& step : steps) total += step.seconds;
+        return total;
+    }
+
+    // [O(steps)] State `elapsed` seconds into the run (the profile repeats); `steps` must not be empty
+    inline State at(const std::vector<Step>& steps, double elapsed) {
+        State state;
+        double t = std::fmod(elapsed, static_cast<double>(totalSeconds(steps)));
+        for (size_t i = 0; i < steps.size(); ++i) {
+            const Step& step = steps[i];
+            if (t >= step.seconds && i + 1 < steps.size()) {
+                t -= step.seconds;
+                continue;
+            }
+            state.step = i;
+            state.untilChange = std::max(0.0, step.seconds - t);
+            if (step.waveHz > 0.0) {
+                const double period = 1.0 / step.waveHz;
+                const double phase = std::fmod(t, period);
+                const double highFor = period * step.dutyPercent / 100.0;
+                state.high = phase < highFor;
+                state.untilChange = std::min(state.untilChange, state.high ? highFor - phase : period - phase);
+            }
+            break;
+        }
+        return state;
+    }
+
+    // Control word for the memory side: bit 0 = memory load on, bits 1-15 = step, bits 16-63 = epoch
+    // (edges published so far). One relaxed load tells a thread both whether to run and whether
+    // anything changed; threads that have to pause wait on it with std::atomic::wait.
+    constexpr uint64_t MEMORY_ON = 1;
+
+    constexpr uint64_t pack(uint64_t epoch, size_t step, bool memory) {
+        return epoch << 16 | (uint64_t(step) & 0x7FFF) << 1 | (memory ? MEMORY_ON : 0);
+    }
+
+    constexpr size_t stepOf(uint64_t word) { return static_cast<size_t>(word >> 1 & 0x7FFF); }
+    constexpr uint64_t epochOf(uint64_t word) { return word >> 16; }
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic, the published sensor values.
+#include <chrono>       //! Provides steady_clock, used for power and TSC-rate intervals.
+#include <string>       //? Provides std::string, used for sysfs paths and labels.
+#include <thread>       //! Provides std::thread, the polling thread.
+#include <mutex>        //! Provides std::mutex, guarding the stop flag the polling thread waits on.
+#include <condition_variable> //! Provides std::condition_variable, so stop() cuts the poll interval short.
+#include <memory>       //! Provides std::unique_ptr, used for the per-core records (they hold atomics).
+#include <vector>       //? Provides std::vector, used for per-core paths and readings.
+#include <fstream>      //? Provides std::ifstream, used for sysfs/hwmon/powercap files.
+#include <cstdint>      //! Provides fixed-width integer types for energy and MSR counters.
+#include <algorithm>    //? Provides std::min/std::max for aggregating per-core figures.
+#include <filesystem>   //? Provides directory iteration over hwmon and powercap zones.
+
+#ifdef __linux__
+    #include <fcntl.h>      //> open() for /dev/cpu/N/msr.
+    #include <unistd.h>     //> pread() / close().
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>  //> __rdtsc, the reference clock for APERF/MPERF.
+#endif
+
+/*
+ * Clock, temperature, throttling and power sensors, polled on a background thread.
+ *
+ *   MHz:          APERF/MPERF deltas from /dev/cpu/N/msr scaled by the measured TSC rate
+ *                 (effective clock while busy), else cpufreq scaling_cur_freq
+ *   Temperature:  hwmon coretemp / k10temp / zenpower, else thermal_zone x86_pkg_temp
+ *   Throttling:   thermal_throttle core/package event counters
+ *   Power:        powercap RAPL energy counters (package-N and their dram subzones),
+ *                 wrap-corrected with max_energy_range_uj
+ *
+ * Every source is optional; a missing one reads as 0 and its has*() stays false.
+ * The readers (console view, telemetry gauges, final report) only load atomics.
+ * Linux only for now; elsewhere nothing is available.
+ */
+namespace Sensors {
+
+    inline bool readU64(const std::string& path, uint64_t& value) {
+        std::ifstream file(path);
+        return static_cast<bool>(file >> value);
+    }
+
+    inline std::string readLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    class Monitor {
+        struct Core {
+            unsigned id = 0;
+            int msrFd = -1;
+            uint64_t aperf = 0, mperf = 0;
+            std::string cpufreqPath;    // scaling_cur_freq (kHz)
+            std::string throttlePath;   // thermal_throttle/core_throttle_count
+            std::atomic<double> mhz{0.0};
+        };
+
+        struct EnergyZone {
+            std::string path;           // energy_uj
+            uint64_t range = 0;         // max_energy_range_uj (wrap point)
+            uint64_t last = 0;
+            bool dram = false;
+        };
+
+        std::vector<std::unique_ptr<Core>> cores;
+        std::vector<std::string> tempPaths;         // temp*_input of the package/die and core sensors
+        std::vector<bool> tempIsPackage;
+        std::vector<EnergyZone> zones;
+        std::vector<std::string> packageThrottlePaths;
+        uint64_t throttleStart = 0;
+        uint64_t tscLast = 0;
+        std::chrono::steady_clock::time_point lastPoll;
+
+        bool msr = false, cpufreq = false, temps = false, rapl = false, throttle = false;
+
+        std::atomic<double> mhzMean{0.0}, mhzLow{0.0}, mhzHigh{0.0};
+        std::atomic<double> packageC{0.0}, hottestC{0.0}, peakC{0.0};
+        std::atomic<double> packageW{0.0}, dramW{0.0};
+        std::atomic<double> packageJ{0.0}, dramJ{0.0};
+        std::atomic<uint64_t> throttleEvents{0};
+
+        std::thread thread;
+        std::atomic<bool> active{false};
+        std::mutex wakeMutex;
+        std::condition_variable wake;   // Notified by stop(), so it never waits out an interval
+
+        uint64_t throttleCount() const {
+            uint64_t total = 0, value;
+            for (const auto& core : cores) if (!core->throttlePath.empty() && readU64(core->throttlePath, value)) total += value;
+            for (const auto& path : packageThrottlePaths) if (readU64(path, value)) total += value;
+            return total;
+        }
+
+        void discoverTemperatures() {
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            for (const auto& entry : fs::directory_iterator("/sys/class/hwmon", ec)) {
+                const std::string base = entry.path().string();
+                const std::string chip = readLine(base + "/name");
+                if (chip != "coretemp" && chip != "k10temp" && chip != "zenpower") continue;
+
+                for (int index = 1; index < 256; ++index) {
+                    const std::string input = base + "/temp" + std::to_string(index) + "_input";
+                    if (!fs::exists(input, ec)) continue;
+                    const std::string label = readLine(base + "/temp" + std::to_string(index) + "_label");
+                    tempPaths.push_back(input);
+                    tempIsPackage.push_back(label.rfind("Package", 0) == 0 || label == "Tctl" || label == "Tdie");
+                }
+            }
+
+            if (tempPaths.empty()) { // Fallback: the package thermal zone
+                for (const auto& entry : fs::directory_iterator("/sys/class/thermal", ec)) {
+                    const std::string base = entry.path().string();
+                    if (readLine(base + "/type") != "x86_pkg_temp") continue;
+                    tempPaths.push_back(base + "/temp");
+                    tempIsPackage.push_back(true);
+                }
+            }
+            temps = !tempPaths.empty();
+        }
+
+        void discoverPower() {
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            for (const auto& entry : fs::directory_iterator("/sys/class/powercap", ec)) { // Every zone is listed here
+                if (entry.path().filename().string().rfind("intel-rapl:", 0) != 0) continue;
+                const std::string base = entry.path().string();
+                const std::string zone = readLine(base + "/name");
+                const bool dram = zone == "dram";
+                if (zone.rfind("package", 0) != 0 && !dram) continue;
+
+                EnergyZone energy;
+                energy.path = base + "/energy_uj";
+                energy.dram = dram;
+                if (!readU64(energy.path, energy.last)) continue; // Often root-only
+                readU64(base + "/max_energy_range_uj", energy.range);
+                zones.push_back(energy);
+            }
+            rapl = !zones.empty();
+        }
+
+        void poll() {
+            const auto now = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - lastPoll).count();
+            lastPoll = now;
+
+            // Clocks
+            double sum = 0.0, low = 0.0, high = 0.0;
+            unsigned counted = 0;
+        #if defined(__linux__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            const uint64_t tsc = __rdtsc();
+            const double tscHz = seconds > 0.0 ? (tsc - tscLast) / seconds : 0.0;
+            tscLast = tsc;
+        #endif
+            for (auto& core : cores) {
+                double mhz = 0.0;
+            #if defined(__linux__) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+                uint64_t aperf, mperf;
+                if (core->msrFd >= 0 && pread(core->msrFd, &aperf, 8, 0xE8) == 8 && pread(core->msrFd, &mperf, 8, 0xE7) == 8) {
+                    if (mperf > core->mperf && core->mperf != 0) {
+                        mhz = tscHz * static_cast<double>(aperf - core->aperf) / static_cast<double>(mperf - core->mperf) / 1e6;
+                    }
+                    core->aperf = aperf;
+                    core->mperf = mperf;
+                } else
+            #endif
+                {
+                    uint64_t khz;
+                    if (!core->cpufreqPath.empty() && readU64(core->cpufreqPath, khz)) mhz = khz / 1000.0;
+                }
+                core->mhz.store(mhz, std::memory_order_relaxed);
+                if (mhz <= 0.0) continue;
+                sum += mhz;
+                low = counted ? std::min(low, mhz) : mhz;
+                high = std::max(high, mhz);
+                ++counted;
+            }
+            mhzMean.store(counted ? sum / counted : 0.0, std::memory_order_relaxed);
+            mhzLow.store(low, std::memory_order_relaxed);
+            mhzHigh.store(high, std::memory_order_relaxed);
+
+            // Temperatures (millidegrees Celsius)
+            double package = 0.0, hottest = 0.0;
+            for (size_t i = 0; i < tempPaths.size(); ++i) {
+                uint64_t milli;
+                if (!readU64(tempPaths[i], milli)) continue;
+                double celsius = milli / 1000.0;
+                hottest = std::max(hottest, celsius);
+                if (tempIsPackage[i]) package = std::max(package, celsius);
+            }
+            packageC.store(package > 0.0 ? package : hottest, std::memory_order_relaxed);
+            hottestC.store(hottest, std::memory_order_relaxed);
+            if (hottest > peakC.load(std::memory_order_relaxed)) peakC.store(hottest, std::memory_order_relaxed);
+
+            // Throttle events since start
+            if (throttle) throttleEvents.store(throttleCount() - throttleStart, std::memory_order_relaxed);
+
+            // Power: energy delta / time, wrap-corrected
+            double packageJoules = 0.0, dramJoules = 0.0;
+            for (auto& zone : zones) {
+                uint64_t energy;
+                if (!readU64(zone.path, energy)) continue;
+                // A zone without a usable max_energy_range_uj cannot be unwrapped: that interval counts 0
+                uint64_t delta = energy >= zone.last ? energy - zone.last
+                               : zone.range > zone.last ? energy + (zone.range - zone.last) : 0;
+                zone.last = energy;
+                (zone.dram ? dramJoules : packageJoules) += delta / 1e6;
+            }
+            if (rapl && seconds > 0.0) {
+                packageW.store(packageJoules / seconds, std::memory_order_relaxed);
+                dramW.store(dramJoules / seconds, std::memory_order_relaxed);
+                packageJ.store(packageJ.load(std::memory_order_relaxed) + packageJoules, std::memory_order_relaxed);
+                dramJ.store(dramJ.load(std::memory_order_relaxed) + dramJoules, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        // Probes every sensor source for the given logical CPUs
+        explicit Monitor(const std::vector<unsigned>& cpuIds) {
+        #ifdef __linux__
+            for (unsigned id : cpuIds) {
+                auto core = std::make_unique<Core>();
+                core->id = id;
+                const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(id);
+                uint64_t value;
+
+                core->msrFd = open(("/dev/cpu/" + std::to_string(id) + "/msr").c_str(), O_RDONLY | O_CLOEXEC);
+                if (core->msrFd >= 0 && pread(core->msrFd, &value, 8, 0xE7) != 8) { // MPERF must be readable
+                    close(core->msrFd);
+                    core->msrFd = -1;
+                }
+                msr = msr || core->msrFd >= 0;
+
+                if (readU64(base + "/cpufreq/scaling_cur_freq", value)) {
+                    core->cpufreqPath = base + "/cpufreq/scaling_cur_freq";
+                    cpufreq = true;
+                }
+                if (readU64(base + "/thermal_throttle/core_throttle_count", value)) {
+                    core->throttlePath = base + "/thermal_throttle/core_throttle_count";
+                    throttle = true;
+                }
+                // One package counter per package, read through its first listed CPU
+                if (readU64(base + "/thermal_throttle/package_throttle_count", value) &&
+                    readU64(base + "/topology/physical_package_id", value)) {
+                    bool seen = false;
+                    for (const auto& path : packageThrottlePaths) {
+                        uint64_t other;
+                        seen = seen || (readU64(path.substr(0, path.find("/thermal_throttle")) + "/topology/physical_package_id", other) && other == value);
+                    }
+                    if (!seen) packageThrottlePaths.push_back(base + "/thermal_throttle/package_throttle_count");
+                }
+                cores.push_back(std::move(core));
+            }
+            discoverTemperatures();
+            discoverPower();
+            throttleStart = throttleCount();
+        #else
+            (void)cpuIds;
+        #endif
+        }
+
+        ~Monitor() {
+            stop();
+        #ifdef __linux__
+            for (auto& core : cores) if (core->msrFd >= 0) close(core->msrFd);
+        #endif
+        }
+
+        Monitor(const Monitor&) = delete;
+        Monitor& operator=(const Monitor&) = delete;
+
+        void start(std::chrono::milliseconds interval) {
+            if (!anyAvailable()) return;
+            lastPoll = std::chrono::steady_clock::now();
+        #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            tscLast = __rdtsc();
+        #endif
+            poll(); // Primes the APERF/MPERF and energy baselines
+            packageJ = 0.0;
+            dramJ = 0.0;
+            active = true;
+            thread = std::thread([this, interval] {
+                auto next = std::chrono::steady_clock::now();
+                while (true) {
+                    next += interval;
+                    std::unique_lock<std::mutex> lock(wakeMutex);
+                    if (wake.wait_until(lock, next, [this] { return !active.load(std::memory_order_relaxed); })) break;
+                    lock.unlock();
+                    poll();
+                }
+            });
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                if (!active.exchange(false)) return;
+            }
+            wake.notify_all();
+            if (thread.joinable()) thread.join();
+            poll(); // Energy up to the moment the test stopped
+        }
+
+        bool hasClock() const { return msr || cpufreq; }
+        bool hasTemperature() const { return temps; }
+        bool hasPower() const { return rapl; }
+        bool hasThrottle() const { return throttle; }
+        bool anyAvailable() const { return hasClock() || hasTemperature() || hasPower() || hasThrottle(); }
+        const char* clockSource() const { return msr ? "APERF/MPERF" : "cpufreq"; }
+
+        // Latest poll
+        double meanMhz() const { return mhzMean.load(std::memory_order_relaxed); }
+        double lowMhz() const { return mhzLow.load(std::memory_order_relaxed); }
+        double highMhz() const { return mhzHigh.load(std::memory_order_relaxed); }
+        double coreMhz(size_t index) const { return index < cores.size() ? cores[index]->mhz.load(std::memory_order_relaxed) : 0.0; }
+        double packageCelsius() const { return packageC.load(std::memory_order_relaxed); }
+        double hottestCelsius() const { return hottestC.load(std::memory_order_relaxed); }
+        double packageWatts() const { return packageW.load(std::memory_order_relaxed); }
+        double dramWatts() const { return dramW.load(std::memory_order_relaxed); }
+
+        // Since start()
+        double peakCelsius() const { return peakC.load(std::memory_order_relaxed); }
+        double packageJoules() const { return packageJ.load(std::memory_order_relaxed); }
+        double dramJoules() const { return dramJ.load(std::memory_order_relaxed); }
+        uint64_t throttleEventCount() const { return throttleEvents.load(std::memory_order_relaxed); }
+    };
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cstdint>      //! Provides fixed-width integer types for the 32-bit lanes.
+#include <algorithm>    //? Provides std::min/std::max, used for lane exponent bounds.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>  //> SSE4.2 / AVX2 / AVX-512 intrinsics, enabled per function via target attributes.
+    #define STRESS_SIMD_HASH 1
+#else
+    #define STRESS_SIMD_HASH 0
+#endif
+
+/*
+ * Multi-lane variants of computeIntensiveHash.
+ *
+ * Every lane runs the same nested modexp loop on its own (base, exponent) pair, in
+ * 32-bit arithmetic so that SSE4.2 / AVX2 / AVX-512 process 4 / 8 / 16 lanes per register.
+ * The modulus is the Mersenne prime 2^31 - 1: reducing a 64-bit product only needs
+ * shifts, masks and adds, all of which exist as vector instructions (a general modulus
+ * such as the scalar 1e9 + 12347 has no vector divide).
+ *
+ * Lanes whose exponent is smaller than the group maximum are masked off for the
+ * remaining iterations, so each lane's result is exactly that of hashLanesPortable.
+ */
+namespace SimdHash {
+
+    constexpr uint32_t MODULUS = 0x7FFFFFFFu;  // 2^31 - 1
+
+    enum class Isa { Scalar, Sse42, Avx2, Avx512 };
+
+    constexpr unsigned lanes(Isa isa) {
+        switch (isa) {
+            case Isa::Sse42:  return 4;
+            case Isa::Avx2:   return 8;
+            case Isa::Avx512: return 16;
+            default:          return 1;
+        }
+    }
+
+    constexpr const char* name(Isa isa) {
+        switch (isa) {
+            case Isa::Sse42:  return "sse4.2";
+            case Isa::Avx2:   return "avx2";
+            case Isa::Avx512: return "avx512";
+            default:          return "scalar";
+        }
+    }
+
+    inline bool isSupported(Isa isa) {
+    #if STRESS_SIMD_HASH
+        switch (isa) {
+            case Isa::Sse42:  return __builtin_cpu_supports("sse4.2");
+            case Isa::Avx2:   return __builtin_cpu_supports("avx2");
+            case Isa::Avx512: return __builtin_cpu_supports("avx512f");
+            default:          return true;
+        }
+    #else
+        return isa == Isa::Scalar;
+    #endif
+    }
+
+    // Widest variant this CPU supports (queried through CPUID once per process)
+    inline Isa detectBest() {
+        static const Isa best = isSupported(Isa::Avx512) ? Isa::Avx512
+                              : isSupported(Isa::Avx2)   ? Isa::Avx2
+                              : isSupported(Isa::Sse42)  ? Isa::Sse42
+                              : Isa::Scalar;
+        return best;
+    }
+
+    // x mod (2^31 - 1) for any 64-bit x: fold twice, then one conditional subtract
+    constexpr uint32_t reduce64(uint64_t x) {
+        x = (x & MODULUS) + (x >> 31);
+        x = (x & MODULUS) + (x >> 31);
+        return static_cast<uint32_t>(x >= MODULUS ? x - MODULUS : x);
+    }
+
+    // ============================================================================================
+    // PORTABLE REFERENCE
+    // ============================================================================================
+    // Defines the lane semantics; the vector versions must produce identical results.
+
+    template <unsigned L>
+    void hashLanesPortable(const uint32_t* base, const uint32_t* exponent, uint32_t* out) {
+        for (unsigned l = 0; l < L; ++l) {
+            uint32_t result = 1, nestedFactor = 1;
+            const uint32_t b = reduce64(base[l]);
+
+            for (uint32_t i = 0; i < exponent[l]; ++i) {                    // [O(exponent)]
+                result = reduce64(static_cast<uint64_t>(result) * b);
+                nestedFactor = reduce64(static_cast<uint64_t>(nestedFactor) * result);
+
+                for (uint32_t j = 0; j < exponent[l]; ++j) {                // [O(exponent)]
+                    nestedFactor += i + j;
+                    result *= nestedFactor;
+                }
+
+                if (i % 10 == 0) {
+                    result = reduce64(static_cast<uint32_t>(result + nestedFactor));
+                }
+            }
+            out[l] = result;
+        }
+    }
+
+    #if STRESS_SIMD_HASH
+    // ============================================================================================
+    // SSE4.2: 4 LANES
+    // ============================================================================================
+
+    __attribute__((target("sse4.2")))
+    inline __m128i mulModSse(__m128i a, __m128i b) {
+        const __m128i p = _mm_set1_epi64x(MODULUS);
+        auto fold = [&](__m128i x) __attribute__((target("sse4.2"))) {
+            x = _mm_add_epi64(_mm_and_si128(x, p), _mm_srli_epi64(x, 31));
+            return _mm_add_epi64(_mm_and_si128(x, p), _mm_srli_epi64(x, 31));
+        };
+        __m128i even = fold(_mm_mul_epu32(a, b));                                           // Lanes 0, 2
+        __m128i odd = fold(_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)));    // Lanes 1, 3
+        __m128i s = _mm_or_si128(even, _mm_slli_epi64(odd, 32));                            // Each < 2^31 + 8
+        return _mm_min_epu32(s, _mm_sub_epi32(s, _mm_set1_epi32(MODULUS)));                 // Conditional subtract
+    }
+
+    __attribute__((target("sse4.2")))
+    inline __m128i reduceSse(__m128i x) {
+        __m128i s = _mm_add_epi32(_mm_and_si128(x, _mm_set1_epi32(MODULUS)), _mm_srli_epi32(x, 31));
+        return _mm_min_epu32(s, _mm_sub_epi32(s, _mm_set1_epi32(MODULUS)));
+    }
+
+    __attribute__((target("sse4.2")))
+    inline void hashLanesSse42(const uint32_t* base, const uint32_t* exponent, uint32_t* out) {
+        const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(exponent));
+        const __m128i b = reduceSse(reduceSse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(base))));
+        const uint32_t minE = *std::min_element(exponent, exponent + 4);
+        const uint32_t maxE = *std::max_element(exponent, exponent + 4);
+
+        __m128i result = _mm_set1_epi32(1), nested = _mm_set1_epi32(1);
+        for (uint32_t i = 0; i < maxE; ++i) {
+            const __m128i activeI = _mm_cmpgt_epi32(e, _mm_set1_epi32(i));
+            __m128i r = mulModSse(result, b);
+            __m128i n = mulModSse(nested, r);
+
+            // All lanes active up to the smallest exponent, masked afterwards
+            const uint32_t unmasked = i < minE ? minE : 0;
+            for (uint32_t j = 0; j < unmasked; ++j) {
+                n = _mm_add_epi32(n, _mm_set1_epi32(i + j));
+                r = _mm_mullo_epi32(r, n);
+            }
+            for (uint32_t j = unmasked; j < maxE; ++j) {
+                const __m128i active = _mm_cmpgt_epi32(e, _mm_set1_epi32(j));
+                __m128i n2 = _mm_add_epi32(n, _mm_set1_epi32(i + j));
+                __m128i r2 = _mm_mullo_epi32(r, n2);
+                n = _mm_blendv_epi8(n, n2, active);
+                r = _mm_blendv_epi8(r, r2, active);
+            }
+            if (i % 10 == 0) r = reduceSse(_mm_add_epi32(r, n));
+
+            result = _mm_blendv_epi8(result, r, activeI);
+            nested = _mm_blendv_epi8(nested, n, activeI);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+    }
+
+    // ============================================================================================
+    // AVX2: 8 LANES
+    // ============================================================================================
+
+    __attribute__((target("avx2")))
+    inline __m256i mulModAvx2(__m256i a, __m256i b) {
+        const __m256i p = _mm256_set1_epi64x(MODULUS);
+        auto fold = [&](__m256i x) __attribute__((target("avx2"))) {
+            x = _mm256_add_epi64(_mm256_and_si256(x, p), _mm256_srli_epi64(x, 31));
+            return _mm256_add_epi64(_mm256_and_si256(x, p), _mm256_srli_epi64(x, 31));
+        };
+        __m256i even = fold(_mm256_mul_epu32(a, b));
+        __m256i odd = fold(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)));
+        __m256i s = _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+        return _mm256_min_epu32(s, _mm256_sub_epi32(s, _mm256_set1_epi32(MODULUS)));
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i reduceAvx2(__m256i x) {
+        __m256i s = _mm256_add_epi32(_mm256_and_si256(x, _mm256_set1_epi32(MODULUS)), _mm256_srli_epi32(x, 31));
+        return _mm256_min_epu32(s, _mm256_sub_epi32(s, _mm256_set1_epi32(MODULUS)));
+    }
+
+    __attribute__((target("avx2")))
+    inline void hashLanesAvx2(const uint32_t* base, const uint32_t* exponent, uint32_t* out) {
+        const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(exponent));
+        const __m256i b = reduceAvx2(reduceAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(base))));
+        const uint32_t minE = *std::min_element(exponent, exponent + 8);
+        const uint32_t maxE = *std::max_element(exponent, exponent + 8);
+
+        __m256i result = _mm256_set1_epi32(1), nested = _mm256_set1_epi32(1);
+        for (uint32_t i = 0; i < maxE; ++i) {
+            const __m256i activeI = _mm256_cmpgt_epi32(e, _mm256_set1_epi32(i));
+            __m256i r = mulModAvx2(result, b);
+            __m256i n = mulModAvx2(nested, r);
+
+            const uint32_t unmasked = i < minE ? minE : 0;
+            for (uint32_t j = 0; j < unmasked; ++j) {
+                n = _mm256_add_epi32(n, _mm256_set1_epi32(i + j));
+                r = _mm256_mullo_epi32(r, n);
+            }
+            for (uint32_t j = unmasked; j < maxE; ++j) {
+                const __m256i active = _mm256_cmpgt_epi32(e, _mm256_set1_epi32(j));
+                __m256i n2 = _mm256_add_epi32(n, _mm256_set1_epi32(i + j));
+                __m256i r2 = _mm256_mullo_epi32(r, n2);
+                n = _mm256_blendv_epi8(n, n2, active);
+                r = _mm256_blendv_epi8(r, r2, active);
+            }
+            if (i % 10 == 0) r = reduceAvx2(_mm256_add_epi32(r, n));
+
+            result = _mm256_blendv_epi8(result, r, activeI);
+            nested = _mm256_blendv_epi8(nested, n, activeI);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+    }
+
+    // ============================================================================================
+    // AVX-512: 16 LANES
+    // ============================================================================================
+    //! GCC 12's avx512fintrin.h trips -W(maybe-)uninitialized on its own _mm512_undefined_* helpers.
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wuninitialized"
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+    __attribute__((target("avx512f")))
+    inline __m512i mulModAvx512(__m512i a, __m512i b) {
+        const __m512i p = _mm512_set1_epi64(MODULUS);
+        auto fold = [&](__m512i x) __attribute__((target("avx512f"))) {
+            x = _mm512_add_epi64(_mm512_and_si512(x, p), _mm512_srli_epi64(x, 31));
+            return _mm512_add_epi64(_mm512_and_si512(x, p), _mm512_srli_epi64(x, 31));
+        };
+        __m512i even = fold(_mm512_mul_epu32(a, b));
+        __m512i odd = fold(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32)));
+        __m512i s = _mm512_or_si512(even, _mm512_slli_epi64(odd, 32));
+        return _mm512_min_epu32(s, _mm512_sub_epi32(s, _mm512_set1_epi32(MODULUS)));
+    }
+
+    __attribute__((target("avx512f")))
+    inline __m512i reduceAvx512(__m512i x) {
+        __m512i s = _mm512_add_epi32(_mm512_and_si512(x, _mm512_set1_epi32(MODULUS)), _mm512_srli_epi32(x, 31));
+        return _mm512_min_epu32(s, _mm512_sub_epi32(s, _mm512_set1_epi32(MODULUS)));
+    }
+
+    __attribute__((target("avx512f")))
+    inline void hashLanesAvx512(const uint32_t* base, const uint32_t* exponent, uint32_t* out) {
+        const __m512i e = _mm512_loadu_si512(exponent);
+        const __m512i b = reduceAvx512(reduceAvx512(_mm512_loadu_si512(base)));
+        const uint32_t minE = *std::min_element(exponent, exponent + 16);
+        const uint32_t maxE = *std::max_element(exponent, exponent + 16);
+
+        __m512i result = _mm512_set1_epi32(1), nested = _mm512_set1_epi32(1);
+        for (uint32_t i = 0; i < maxE; ++i) {
+            const __mmask16 activeI = _mm512_cmpgt_epi32_mask(e, _mm512_set1_epi32(i));
+            __m512i r = mulModAvx512(result, b);
+            __m512i n = mulModAvx512(nested, r);
+
+            const uint32_t unmasked = i < minE ? minE : 0;
+            for (uint32_t j = 0; j < unmasked; ++j) {
+                n = _mm512_add_epi32(n, _mm512_set1_epi32(i + j));
+                r = _mm512_mullo_epi32(r, n);
+            }
+            for (uint32_t j = unmasked; j < maxE; ++j) {
+                const __mmask16 active = _mm512_cmpgt_epi32_mask(e, _mm512_set1_epi32(j));
+                n = _mm512_mask_add_epi32(n, active, n, _mm512_set1_epi32(i + j));
+                r = _mm512_mask_mullo_epi32(r, active, r, n);
+            }
+            if (i % 10 == 0) r = reduceAvx512(_mm512_add_epi32(r, n));
+
+            result = _mm512_mask_blend_epi32(activeI, result, r);
+            nested = _mm512_mask_blend_epi32(activeI, nested, n);
+        }
+        _mm512_storeu_si512(out, result);
+    }
+    #pragma GCC diagnostic pop
+    #endif
+
+    // Runs lanes(isa) independent hashes; `base`, `exponent` and `out` hold lanes(isa) values
+    inline void hashLanes(Isa isa, const uint32_t* base, const uint32_t* exponent, uint32_t* out) {
+        switch (isa) {
+    #if STRESS_SIMD_HASH
+            case Isa::Sse42:  hashLanesSse42(base, exponent, out); return;
+            case Isa::Avx2:   hashLanesAvx2(base, exponent, out); return;
+            case Isa::Avx512: hashLanesAvx512(base, exponent, out); return;
+    #endif
+            default:          hashLanesPortable<1>(base, exponent, out); return;
+        }
+    }
+}
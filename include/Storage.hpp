@@ -0,0 +1,263 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic_ref, used for the io_uring ring indices shared with the kernel.
+#include <string>       //? Provides std::string, used for paths and error messages.
+#include <cstdint>      //! Provides fixed-width integer types for offsets and ring indices.
+#include <cstring>      //? Provides std::memset / std::strerror.
+#include <string_view>  //? Provides std::string_view, used for engine and pattern names.
+#include <algorithm>    //? Provides std::min/std::max, used for ring and prefill sizes.
+
+#ifdef __linux__
+    #include <cerrno>               //> errno.
+    #include <fcntl.h>              //> open(O_DIRECT), fallocate.
+    #include <unistd.h>             //> pread / pwrite / close / unlink / syscall.
+    #include <sys/mman.h>           //> mmap of the io_uring rings.
+    #include <sys/syscall.h>        //> __NR_io_uring_setup / __NR_io_uring_enter (no liburing dependency).
+    #include <linux/io_uring.h>     //> io_uring_params, io_uring_sqe, io_uring_cqe.
+#endif
+
+/*
+ * Storage stress primitives.
+ *
+ *   File:    a scratch file created inside the chosen directory, opened with O_DIRECT when the
+ *            filesystem allows it (buffered I/O otherwise), preallocated and written once so
+ *            reads hit real extents; removed again at the end.
+ *   Uring:   a minimal io_uring on raw syscalls: mmap'ed SQ/CQ rings, IORING_OP_READ/WRITE
+ *            with the alignment O_DIRECT needs, submission and reaping without any library.
+ *   Pattern: per-thread xorshift offsets (random) or a wrapping cursor (sequential) and a
+ *            read/write mix.
+ *
+ * The engines that drive these live in SystemStressTest::storageStressTest(); the coroutine
+ * engine runs on Async::Executor (Async.hpp), and without io_uring (old kernels, seccomp) the
+ * thread-pool engine issues blocking pread/pwrite.
+ * Linux only for now.
+ */
+namespace Storage {
+
+    enum class Engine { Auto, IoUring, Threads, Coroutines };
+
+    inline bool parseEngine(std::string_view name, Engine& engine) {
+        if (name == "auto")          engine = Engine::Auto;
+        else if (name == "io_uring") engine = Engine::IoUring;
+        else if (name == "threads")  engine = Engine::Threads;
+        else if (name == "coro")     engine = Engine::Coroutines;
+        else return false;
+        return true;
+    }
+
+    constexpr const char* name(Engine engine) {
+        switch (engine) {
+            case Engine::IoUring: return "io_uring";
+            case Engine::Threads: return "threads";
+            case Engine::Coroutines: return "coro";
+            default:              return "auto";
+        }
+    }
+
+    // Offsets and read/write choice for one submitting thread
+    class Pattern {
+        uint64_t state;
+        uint64_t blocks;        // File size in I/O blocks
+        uint64_t cursor = 0;    // Sequential position
+        uint64_t blockSize;
+        unsigned readPercent;
+        bool random;
+
+        uint64_t nextRandom() { // [O(1)] xorshift64*
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1Dull;
+        }
+
+    public:
+        Pattern(uint64_t seed, uint64_t fileSize, uint64_t blockSize, unsigned readPercent, bool random, uint64_t startBlock)
+            : state(seed * 0x9E3779B97F4A7C15ull | 1), blocks(fileSize / blockSize), cursor(startBlock),
+              blockSize(blockSize), readPercent(readPercent), random(random) {}
+
+        uint64_t nextOffset() {
+            if (random) return nextRandom() % blocks * blockSize;
+            const uint64_t offset = cursor * blockSize;
+            cursor = cursor + 1 == blocks ? 0 : cursor + 1;
+            return offset;
+        }
+
+        bool nextIsRead() { return readPercent >= 100 || (readPercent > 0 && nextRandom() % 100 < readPercent); }
+    };
+
+    struct File {
+        int fd = -1;
+        bool direct = false;
+        uint64_t size = 0;
+        std::string path;
+    };
+
+#ifdef __linux__
+    // Creates, preallocates and opens the scratch file (O_DIRECT when the filesystem supports it)
+    inline bool createFile(const std::string& directory, uint64_t size, File& file, std::string& error) {
+        file.path = directory + "/stress_tester." + std::to_string(getpid()) + ".io";
+        file.size = size;
+        file.fd = open(file.path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC | O_DIRECT, 0600);
+        file.direct = file.fd >= 0;
+        if (file.fd < 0 && errno == EINVAL) { // tmpfs and some FUSE filesystems refuse O_DIRECT
+            file.fd = open(file.path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        }
+        if (file.fd < 0) {
+            error = "Cannot create " + file.path + ": " + std::strerror(errno);
+            return false;
+        }
+        if (fallocate(file.fd, 0, 0, static_cast<off_t>(size)) != 0 && ftruncate(file.fd, static_cast<off_t>(size)) != 0) {
+            error = "Cannot size " + file.path + ": " + std::strerror(errno);
+            close(file.fd);
+            unlink(file.path.c_str());
+            file.fd = -1;
+            return false;
+        }
+        return true;
+    }
+
+    // [O(size)] Writes the whole file once with `buffer` (aligned, `chunk` bytes), so reads hit real data
+    inline bool prefill(const File& file, const void* buffer, size_t chunk, const std::atomic<bool>& keepGoing) {
+        for (uint64_t offset = 0; offset < file.size && keepGoing.load(std::memory_order_relaxed); offset += chunk) {
+            const size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunk, file.size - offset));
+            if (pwrite(file.fd, buffer, bytes, static_cast<off_t>(offset)) != static_cast<ssize_t>(bytes)) return false;
+        }
+        return fdatasync(file.fd) == 0;
+    }
+
+    inline void removeFile(File& file) {
+        if (file.fd < 0) return;
+        close(file.fd);
+        unlink(file.path.c_str());
+        file.fd = -1;
+    }
+
+    // Minimal io_uring: one submitting thread, no SQPOLL, no registered buffers
+    class Uring {
+        int fd = -1;
+        void* sqRing = MAP_FAILED;
+        void* cqRing = MAP_FAILED;
+        size_t sqRingSize = 0, cqRingSize = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t sqesSize = 0;
+
+        unsigned *sqHead = nullptr, *sqTail = nullptr, *sqArray = nullptr;
+        unsigned *cqHead = nullptr, *cqTail = nullptr;
+        unsigned sqMask = 0, cqMask = 0, entries = 0;
+        io_uring_cqe* cqes = nullptr;
+        unsigned queued = 0;    // SQEs written but not yet consumed by an enter()
+        unsigned submitted = 0; // Consumed by the kernel, completion not reaped yet
+
+        static int enter(int fd, unsigned submit, unsigned wait, unsigned flags) {
+            return static_cast<int>(syscall(__NR_io_uring_enter, fd, submit, wait, flags, nullptr, 0));
+        }
+
+    public:
+        Uring() = default;
+        Uring(const Uring&) = delete;
+        Uring& operator=(const Uring&) = delete;
+
+        ~Uring() {
+            if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+            if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+            if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+            if (fd >= 0) close(fd);
+        }
+
+        bool setup(unsigned depth, std::string& error) {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            fd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+            if (fd < 0) {
+                error = std::string("io_uring_setup: ") + std::strerror(errno);
+                return false;
+            }
+
+            sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+            sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            cqRing = single ? sqRing
+                            : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqeMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            sqes = static_cast<io_uring_sqe*>(sqeMap);
+            if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqeMap == MAP_FAILED) {
+                error = std::string("io_uring mmap: ") + std::strerror(errno);
+                return false;
+            }
+
+            char* sq = static_cast<char*>(sqRing);
+            char* cq = static_cast<char*>(cqRing);
+            sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            entries = params.sq_entries;
+            return true;
+        }
+
+        // [O(1)] Queues a read or write of `bytes` at `offset`; the caller keeps in-flight <= depth
+        void queue(bool read, int file, void* buffer, uint32_t bytes, uint64_t offset, uint64_t userData) {
+            const unsigned tail = std::atomic_ref<unsigned>(*sqTail).load(std::memory_order_relaxed);
+            const unsigned index = tail & sqMask;
+            io_uring_sqe& sqe = sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = read ? IORING_OP_READ : IORING_OP_WRITE;
+            sqe.fd = file;
+            sqe.addr = reinterpret_cast<uint64_t>(buffer);
+            sqe.len = bytes;
+            sqe.off = offset;
+            sqe.user_data = userData;
+            sqArray[index] = index;
+            std::atomic_ref<unsigned>(*sqTail).store(tail + 1, std::memory_order_release);
+            ++queued;
+        }
+
+        // Submits what is queued and waits until at least `wait` completions are available. SQEs the
+        // kernel did not take (a short submit) stay queued for the next call. EAGAIN and EBUSY (out
+        // of request resources, or completions backed up) are not failures: it waits for one of the
+        // requests already in the kernel instead, and the caller reaps and calls again.
+        bool submit(unsigned wait) {
+            int result;
+            do {
+                result = enter(fd, queued, wait, wait ? IORING_ENTER_GETEVENTS : 0);
+            } while (result < 0 && errno == EINTR);
+            if (result >= 0) {
+                queued -= static_cast<unsigned>(result);
+                submitted += static_cast<unsigned>(result);
+                return true;
+            }
+            if (errno != EAGAIN && errno != EBUSY) return false;
+            if (submitted == 0) return true; // Nothing to wait for: the next call simply tries again
+            do {
+                result = enter(fd, 0, 1, IORING_ENTER_GETEVENTS);
+            } while (result < 0 && errno == EINTR);
+            return result >= 0;
+        }
+
+        // [O(completions)] Calls fn(userData, result) for every completion; returns how many
+        template <typename Fn>
+        unsigned reap(Fn&& fn) {
+            unsigned head = std::atomic_ref<unsigned>(*cqHead).load(std::memory_order_relaxed);
+            const unsigned tail = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+            unsigned count = 0;
+            for (; head != tail; ++head, ++count) {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                fn(cqe.user_data, cqe.res);
+            }
+            std::atomic_ref<unsigned>(*cqHead).store(head, std::memory_order_release);
+            submitted -= count;
+            return count;
+        }
+
+        unsigned depth() const { return entries; }
+    };
+#endif
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic, used for ring indices and the published per-source values.
+#include <chrono>       //! Provides steady_clock, the timestamp source for samples.
+#include <memory>       //! Provides std::unique_ptr, used for sources and writers.
+#include <string>       //? Provides std::string, used for source/gauge names and output rows.
+#include <thread>       //! Provides std::thread, the collector thread.
+#include <mutex>        //! Provides std::mutex, guarding the stop flag the collector waits on.
+#include <condition_variable> //! Provides std::condition_variable, so stop() cuts the tick interval short.
+#include <vector>       //? Provides std::vector, used for sources, gauges and writers.
+#include <fstream>      //? Provides std::ofstream, used by the JSON-lines and CSV writers.
+#include <cstdint>      //! Provides fixed-width integer types for samples.
+#include <functional>   //? Provides std::function, used for gauges read by the collector.
+
+/*
+ * Telemetry pipeline.
+ *
+ *   worker -> SPSC ring (one per source) -> collector thread -> per-source totals/rates
+ *                                                            -> writers (JSON lines, CSV)
+ *   console view / exporters read the published totals/rates (relaxed atomics)
+ *
+ * The producer side is wait-free: a push is two relaxed loads, one store and one
+ * release store into the producer's own ring, with no lock, allocation or I/O.
+ * A full ring refuses the sample instead of blocking: the producer keeps the value for its
+ * next push, and whatever is still refused when the producer exits is handed over through
+ * settle() and counted at the next tick, so no value is lost.
+ * Everything else (aggregation, file output) runs on the collector thread.
+ */
+namespace Telemetry {
+
+    enum class Metric : uint32_t {
+        HashOps,        // Hash operations completed by a CPU worker
+        StreamBytes,    // Bytes moved by a STREAM thread
+        IoBytes,        // Bytes read + written by a storage thread
+        IoOps,          // I/O requests completed by a storage thread
+        NetTxBytes,     // Payload bytes sent by a network flow
+        NetRxBytes,     // Payload bytes received by a network flow
+        NetTxPackets,   // Datagrams (UDP) or segments (TCP) sent
+        NetRxPackets,   // Datagrams (UDP) or segments (TCP) received
+        VerifyBytes,    // Bytes written + read back by a memory verification thread
+        CacheBytes,     // Bytes read + written back by a cache-stress thread
+        FileBytes,      // Bytes rewritten in the file-backed mapping (--mem-mode=file)
+        GpuOps,         // modexp work items completed on the GPU (--gpu)
+    };
+
+    inline constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::GpuOps) + 1;
+
+    constexpr const char* name(Metric metric) {
+        switch (metric) {
+            case Metric::HashOps:     return "hash_ops";
+            case Metric::IoBytes:     return "io_bytes";
+            case Metric::IoOps:       return "io_ops";
+            case Metric::NetTxBytes:  return "net_tx_bytes";
+            case Metric::NetRxBytes:  return "net_rx_bytes";
+            case Metric::NetTxPackets: return "net_tx_packets";
+            case Metric::NetRxPackets: return "net_rx_packets";
+            case Metric::VerifyBytes: return "verify_bytes";
+            case Metric::CacheBytes:  return "cache_bytes";
+            case Metric::FileBytes:   return "file_bytes";
+            case Metric::GpuOps:      return "gpu_ops";
+            default:                  return "stream_bytes";
+        }
+    }
+
+    struct Sample {
+        uint64_t timestampNs;   // steady_clock nanoseconds
+        uint64_t value;         // Delta since the producer's previous sample
+    };
+
+    inline uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Bounded single-producer / single-consumer ring
+    template <size_t CAPACITY>
+    class SpscRing {
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+        alignas(64) std::atomic<uint64_t> head{0};  // Next slot to write (producer)
+        alignas(64) std::atomic<uint64_t> tail{0};  // Next slot to read (consumer)
+        alignas(64) std::atomic<uint64_t> droppedSamples{0}; // Written by the producer, read by anyone
+        Sample slots[CAPACITY];
+
+    public:
+        // Producer only. Returns false (and counts a drop) when the ring is full.
+        bool push(const Sample& sample) {
+            uint64_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) == CAPACITY) {
+                droppedSamples.store(droppedSamples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            slots[h & (CAPACITY - 1)] = sample;
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only. Calls fn(sample) for everything published so far; returns the count.
+        template <typename Fn>
+        size_t drain(Fn&& fn) {
+            uint64_t t = tail.load(std::memory_order_relaxed);
+            const uint64_t h = head.load(std::memory_order_acquire);
+            for (uint64_t i = t; i < h; ++i) fn(slots[i & (CAPACITY - 1)]);
+            tail.store(h, std::memory_order_release);
+            return static_cast<size_t>(h - t);
+        }
+
+        // Pushes refused because the ring was full (a relaxed load: a counter, not a fence)
+        uint64_t dropped() const { return droppedSamples.load(std::memory_order_relaxed); }
+    };
+
+    using Ring = SpscRing<1024>;
+
+    // One producer's stream: its ring plus the values the collector publishes for it
+    struct Source {
+        std::string label;                      // e.g. "worker3"
+        Metric metric;
+        Ring ring;
+        std::atomic<uint64_t> total{0};         // Sum of all drained samples
+        std::atomic<uint64_t> settled{0};       // Values a full ring refused as the producer exited
+        std::atomic<double> rate{0.0};          // Per second over the last collector interval
+        uint64_t totalAtLastTick = 0;           // Collector-owned
+
+        Source(std::string label, Metric metric) : label(std::move(label)), metric(metric) {}
+    };
+
+    struct Gauge {
+        std::string label;
+        std::function<double()> read;           // Called on the collector thread only
+        std::atomic<double> value{0.0};
+
+        Gauge(std::string label, std::function<double()> read) : label(std::move(label)), read(std::move(read)) {}
+    };
+
+    class Collector;
+
+    // Output sink, called on the collector thread after every tick
+    class Writer {
+    public:
+        virtual ~Writer() = default;
+        virtual void begin(const Collector& collector) = 0;
+        virtual void tick(const Collector& collector, double elapsedSeconds) = 0;
+    };
+
+    class Collector {
+        std::vector<std::unique_ptr<Source>> sources;
+        std::vector<std::unique_ptr<Gauge>> gauges;
+        std::vector<std::unique_ptr<Writer>> writers;
+        std::vector<std::function<void(double)>> tickHooks;
+        std::thread thread;
+        std::atomic<bool> active{false};
+        std::mutex wakeMutex;
+        std::condition_variable wake;   // Notified by stop(), so it never waits out a tick
+        std::chrono::milliseconds interval{250};
+        uint64_t startNs = 0;
+        uint64_t lastTickNs = 0;
+
+        void tick() {
+            const uint64_t now = nowNs();
+            const double seconds = (now - lastTickNs) / 1e9;
+            lastTickNs = now;
+
+            for (auto& source : sources) { // [O(sources + samples)]
+                uint64_t sum = 0;
+                source->ring.drain([&](const Sample& sample) { sum += sample.value; });
+                sum += source->settled.exchange(0, std::memory_order_relaxed);
+                uint64_t total = source->total.load(std::memory_order_relaxed) + sum;
+                source->total.store(total, std::memory_order_relaxed);
+                source->rate.store(seconds > 0.0 ? (total - source->totalAtLastTick) / seconds : 0.0, std::memory_order_relaxed);
+                source->totalAtLastTick = total;
+            }
+            for (auto& gauge : gauges) gauge->value.store(gauge->read(), std::memory_order_relaxed);
+
+            const double elapsed = (now - startNs) / 1e9;
+            for (auto& hook : tickHooks) hook(elapsed);
+            for (auto& writer : writers) writer->tick(*this, elapsed);
+        }
+
+    public:
+        Collector() = default;
+        Collector(const Collector&) = delete;
+        Collector& operator=(const Collector&) = delete;
+        ~Collector() { stop(); }
+
+        // Registration is only allowed before start(); returns the source id
+        unsigned addSource(std::string label, Metric metric) {
+            sources.push_back(std::make_unique<Source>(std::move(label), metric));
+            return static_cast<unsigned>(sources.size() - 1);
+        }
+        void addGauge(std::string label, std::function<double()> read) {
+            gauges.push_back(std::make_unique<Gauge>(std::move(label), std::move(read)));
+        }
+        void addWriter(std::unique_ptr<Writer> writer) { writers.push_back(std::move(writer)); }
+
+        // Extra work for the collector thread after each aggregation (e.g. time-series recording)
+        void onTick(std::function<void(double)> hook) { tickHooks.push_back(std::move(hook)); }
+
+        // Producer side: wait-free, lock-free, allocation-free. False when the ring is full: the
+        // value was not published and the caller keeps it for its next attempt.
+        bool publish(unsigned source, uint64_t value, uint64_t timestampNs = nowNs()) {
+            return sources[source]->ring.push({timestampNs, value});
+        }
+
+        // Producer side, once at exit: a value its full ring would not take. The next tick adds it
+        // to the total, so the producer never waits for the collector to make room.
+        void settle(unsigned source, uint64_t value) {
+            sources[source]->settled.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void start(std::chrono::milliseconds tickInterval) {
+            interval = tickInterval;
+            startNs = lastTickNs = nowNs();
+            for (auto& writer : writers) writer->begin(*this);
+            active = true;
+            thread = std::thread([this] {
+                auto next = std::chrono::steady_clock::now();
+                while (true) {
+                    next += interval;
+                    std::unique_lock<std::mutex> lock(wakeMutex);
+                    if (wake.wait_until(lock, next, [this] { return !active.load(std::memory_order_relaxed); })) break;
+                    lock.unlock();
+                    tick();
+                }
+            });
+        }
+
+        // Stops the thread after one final tick, so totals include every published sample
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                if (!active.exchange(false)) return;
+            }
+            wake.notify_all();
+            if (thread.joinable()) thread.join();
+            tick();
+        }
+
+        // Reader side (any thread)
+        const std::vector<std::unique_ptr<Source>>& allSources() const { return sources; }
+        const std::vector<std::unique_ptr<Gauge>>& allGauges() const { return gauges; }
+
+        uint64_t total(Metric metric) const {
+            uint64_t sum = 0;
+            for (const auto& source : sources) if (source->metric == metric) sum += source->total.load(std::memory_order_relaxed);
+            return sum;
+        }
+
+        double rate(Metric metric) const {
+            double sum = 0.0;
+            for (const auto& source : sources) if (source->metric == metric) sum += source->rate.load(std::memory_order_relaxed);
+            return sum;
+        }
+
+        uint64_t dropped() const {
+            uint64_t sum = 0;
+            for (const auto& source : sources) sum += source->ring.dropped();
+            return sum;
+        }
+    };
+
+    // Producer-side batching for per-operation counts. Pushes one sample every `stride` calls and
+    // adapts the stride so a producer emits roughly one sample per 1-10 ms, whatever the kernel's
+    // speed: the clock is read once per sample, never once per operation.
+    class Producer {
+        Collector* collector = nullptr;
+        unsigned source = 0;
+        uint64_t pending = 0;       // Value accumulated since the last published sample
+        uint64_t calls = 0;         // add() calls since the last sample
+        uint64_t stride = 1;        // add() calls per sample
+        uint64_t lastNs = 0;
+
+        static constexpr uint64_t MIN_GAP_NS = 1'000'000;
+        static constexpr uint64_t MAX_GAP_NS = 10'000'000;
+
+    public:
+        Producer() = default;
+        Producer(Collector& collector, unsigned source) : collector(&collector), source(source), lastNs(nowNs()) {}
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+        ~Producer() { finish(); }
+
+        void add(uint64_t value) { // [O(1)] Usually just two additions and a compare
+            pending += value;
+            if (++calls >= stride) flush();
+        }
+
+        void flush() {
+            const uint64_t now = nowNs();
+            if (pending > 0 && collector->publish(source, pending, now)) pending = 0; // A full ring: retried next flush
+            const uint64_t gap = now - lastNs;
+            if (gap < MIN_GAP_NS && stride < (uint64_t(1) << 30)) stride *= 2;
+            else if (gap > MAX_GAP_NS && stride > 1) stride /= 2;
+            lastNs = now;
+            calls = 0;
+        }
+
+        // Thread exit: publishes what is pending and settles whatever a full ring still refuses
+        void finish() {
+            if (!collector) return;
+            flush();
+            if (pending > 0) collector->settle(source, pending);
+            pending = 0;
+        }
+    };
+
+    // ============================================================================================
+    // WRITERS
+    // ============================================================================================
+
+    // One JSON object per tick: {"t":1.25,"sources":{"worker0":{"total":..,"rate":..},..},"gauges":{..}}
+    class JsonLinesWriter final : public Writer {
+        std::ofstream out;
+        std::string line;   // Reused between ticks
+
+    public:
+        explicit JsonLinesWriter(const std::string& path) : out(path) {}
+        bool ok() const { return static_cast<bool>(out); }
+
+        void begin(const Collector&) override {}
+
+        void tick(const Collector& collector, double elapsedSeconds) override {
+            line.clear();
+            line += "{\"t\":" + std::to_string(elapsedSeconds) + ",\"sources\":{";
+            bool first = true;
+            for (const auto& source : collector.allSources()) {
+                if (!first) line += ',';
+                first = false;
+                line += '"' + source->label + "\":{\"metric\":\"" + name(source->metric)
+                      + "\",\"total\":" + std::to_string(source->total.load(std::memory_order_relaxed))
+                      + ",\"rate\":" + std::to_string(source->rate.load(std::memory_order_relaxed)) + '}';
+            }
+            line += "},\"gauges\":{";
+            first = true;
+            for (const auto& gauge : collector.allGauges()) {
+                if (!first) line += ',';
+                first = false;
+                line += '"' + gauge->label + "\":" + std::to_string(gauge->value.load(std::memory_order_relaxed));
+            }
+            line += "}}\n";
+            out << line << std::flush;
+        }
+    };
+
+    // One row per tick: t, <source>_total, <source>_rate ..., <gauge> ...
+    class CsvWriter final : public Writer {
+        std::ofstream out;
+        std::string row;
+
+    public:
+        explicit CsvWriter(const std::string& path) : out(path) {}
+        bool ok() const { return static_cast<bool>(out); }
+
+        void begin(const Collector& collector) override {
+            row = "t";
+            for (const auto& source : collector.allSources()) row += ',' + source->label + "_total," + source->label + "_rate";
+            for (const auto& gauge : collector.allGauges()) row += ',' + gauge->label;
+            out << row << '\n';
+        }
+
+        void tick(const Collector& collector, double elapsedSeconds) override {
+            row = std::to_string(elapsedSeconds);
+            for (const auto& source : collector.allSources()) {
+                row += ',' + std::to_string(source->total.load(std::memory_order_relaxed))
+                     + ',' + std::to_string(source->rate.load(std::memory_order_relaxed));
+            }
+            for (const auto& gauge : collector.allGauges()) {
+                row += ',' + std::to_string(gauge->value.load(std::memory_order_relaxed));
+            }
+            out << row << '\n' << std::flush;
+        }
+    };
+}
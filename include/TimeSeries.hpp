@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic, the published row count.
+#include <vector>       //? Provides std::vector, the preallocated sample matrix.
+#include <cmath>        //! Provides std::sqrt, used for the coefficient of variation.
+#include <cstddef>      //! Provides size_t.
+#include <algorithm>    //? Provides std::sort, used for percentiles at the end of the run.
+
+/*
+ * Fixed-capacity time series: one row per collector interval, one column per series
+ * (e.g. per-worker ops/s). All storage is allocated up front; once the buffer is
+ * full further rows are dropped and counted, so recording never allocates.
+ *
+ * Only one thread records (the telemetry collector); readers use rows() after it
+ * has stopped.
+ */
+namespace TimeSeries {
+
+    class Recorder {
+        std::vector<float> values;      // capacity x columns, row-major
+        std::vector<double> times;      // Seconds since start, per row
+        size_t capacity = 0;
+        size_t columns = 0;
+        std::atomic<size_t> count{0};
+        size_t overflow = 0;
+
+    public:
+        Recorder() = default;
+        Recorder(size_t rows, size_t series) { reset(rows, series); }
+
+        // Allocates the whole buffer; call before recording starts
+        void reset(size_t rows, size_t series) {
+            capacity = rows;
+            columns = series;
+            values.assign(rows * series, 0.0f);
+            times.assign(rows, 0.0);
+            count = 0;
+            overflow = 0;
+        }
+
+        // [O(1)] Next row to fill, or nullptr when the buffer is full
+        float* beginRow(double seconds) {
+            const size_t row = count.load(std::memory_order_relaxed);
+            if (row >= capacity) {
+                ++overflow;
+                return nullptr;
+            }
+            times[row] = seconds;
+            return values.data() + row * columns;
+        }
+        void commitRow() { count.fetch_add(1, std::memory_order_release); }
+
+        size_t rows() const { return count.load(std::memory_order_acquire); }
+        size_t series() const { return columns; }
+        size_t dropped() const { return overflow; }
+        double time(size_t row) const { return times[row]; }
+        float at(size_t row, size_t column) const { return values[row * columns + column]; }
+
+        // Sum of all columns in a row (e.g. machine-wide ops/s)
+        double rowSum(size_t row) const {
+            double sum = 0.0;
+            for (size_t c = 0; c < columns; ++c) sum += values[row * columns + c];
+            return sum;
+        }
+    };
+
+    struct Summary {
+        double min = 0.0, p50 = 0.0, p99 = 0.0, max = 0.0;
+        double mean = 0.0;
+        double cv = 0.0;    // Standard deviation / mean
+        size_t samples = 0;
+    };
+
+    // Nearest-rank percentile of sorted data, 0 <= q <= 1
+    inline double percentile(const std::vector<double>& sorted, double q) {
+        if (sorted.empty()) return 0.0;
+        size_t rank = static_cast<size_t>(std::ceil(q * sorted.size()));
+        return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    // [O(n log n)] Summary of a sample set (sorted in place)
+    inline Summary summarize(std::vector<double>& data) {
+        Summary summary;
+        summary.samples = data.size();
+        if (data.empty()) return summary;
+
+        std::sort(data.begin(), data.end());
+        double sum = 0.0, squares = 0.0;
+        for (double value : data) {
+            sum += value;
+            squares += value * value;
+        }
+        summary.mean = sum / data.size();
+        const double variance = std::max(0.0, squares / data.size() - summary.mean * summary.mean);
+        summary.cv = summary.mean > 0.0 ? std::sqrt(variance) / summary.mean : 0.0;
+        summary.min = data.front();
+        summary.p50 = percentile(data, 0.50);
+        summary.p99 = percentile(data, 0.99);
+        summary.max = data.back();
+        return summary;
+    }
+
+    // [O(n)] Start (seconds) of the first `window`-row stretch whose average throughput is below
+    // `fraction` of the best earlier stretch, i.e. a sustained drop rather than one noisy interval.
+    // Returns a negative value when that never happened. Rows before `firstRow` (warm-up) are skipped.
+    inline double firstSustainedDrop(const Recorder& recorder, size_t firstRow, size_t window, double fraction) {
+        const size_t rows = recorder.rows();
+        if (window == 0 || rows < firstRow + 2 * window) return -1.0;
+
+        double rolling = 0.0, best = 0.0;
+        for (size_t row = firstRow; row < rows; ++row) {
+            rolling += recorder.rowSum(row);
+            if (row >= firstRow + window) rolling -= recorder.rowSum(row - window);
+            if (row + 1 < firstRow + window) continue;
+
+            const double average = rolling / window;
+            if (best > 0.0 && average < fraction * best) return recorder.time(row + 1 - window);
+            best = std::max(best, average);
+        }
+        return -1.0;
+    }
+}
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <vector>       //? Provides std::vector, used for CPU lists and placements.
+#include <string>       //? Provides std::string, used for sysfs paths and cpulist parsing.
+#include <fstream>      //? Provides std::ifstream, used for reading sysfs topology files.
+#include <algorithm>    //? Provides std::sort/std::stable_sort, used for ordering CPUs per affinity mode.
+#include <string_view>  //? Provides std::string_view, used for affinity mode names.
+#include <thread>       //! Provides std::thread::hardware_concurrency, the fallback CPU count.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <cpuid.h>          //> __get_cpuid / __cpuid_count for the cache sizes when sysfs has none.
+#endif
+
+#ifdef __linux__
+    #include <sched.h>          //> sched_getaffinity / sched_setaffinity for pinning.
+    #include <unistd.h>         //> syscall().
+    #include <sys/syscall.h>    //> SYS_set_mempolicy, SYS_mbind (no libnuma dependency).
+#elif defined(_WIN32)
+    #include <windows.h>        //> SetThreadAffinityMask.
+#endif
+
+/*
+ * CPU topology discovery and worker placement.
+ *
+ * On Linux the layout (logical CPU -> physical core, package, NUMA node) is read
+ * from sysfs and restricted to the CPUs this process may run on. Elsewhere every
+ * logical CPU is treated as its own core on package 0 / node 0.
+ */
+namespace Topology {
+
+    struct Cpu {
+        unsigned id = 0;    // Logical CPU number
+        int core = 0;       // Physical core id (unique across packages)
+        int package = 0;    // Socket
+        int node = 0;       // NUMA node
+        int thread = 0;     // SMT sibling index within its core (0 = first)
+        int llc = 0;        // Last-level cache instance (one per CCX on chiplet parts, unique across packages)
+    };
+
+    enum class Affinity { None, Compact, Scatter, Physical, List };
+
+    inline bool parseAffinity(std::string_view name, Affinity& mode) {
+        if (name == "none")          mode = Affinity::None;
+        else if (name == "compact")  mode = Affinity::Compact;
+        else if (name == "scatter")  mode = Affinity::Scatter;
+        else if (name == "physical") mode = Affinity::Physical;
+        else return false;
+        return true;
+    }
+
+    constexpr const char* name(Affinity mode) {
+        switch (mode) {
+            case Affinity::Compact:  return "compact";
+            case Affinity::Scatter:  return "scatter";
+            case Affinity::Physical: return "physical";
+            case Affinity::List:     return "list";
+            default:                 return "none";
+        }
+    }
+
+    constexpr unsigned MAX_CPU_ID = 8191;   // The kernel's largest NR_CPUS is 8192
+
+    // Parses a kernel-style CPU list ("0-3,8,10-11"); returns false on malformed input or ids past MAX_CPU_ID
+    inline bool parseCpuList(std::string_view text, std::vector<unsigned>& cpus) {
+        while (!text.empty() && (text.back() == '\n' || text.back() == ' ')) text.remove_suffix(1);
+        while (!text.empty()) {
+            std::string_view item = text.substr(0, text.find(','));
+            text.remove_prefix(std::min(text.size(), item.size() + 1));
+
+            size_t dash = item.find('-');
+            std::string first(item.substr(0, dash));
+            std::string last(dash == std::string_view::npos ? first : std::string(item.substr(dash + 1)));
+            if (first.empty() || last.empty() || first.find_first_not_of("0123456789") != std::string::npos
+                || last.find_first_not_of("0123456789") != std::string::npos
+                || first.size() > 5 || last.size() > 5) { // Longer cannot be a CPU id (and would overflow stoul)
+                return false;
+            }
+
+            unsigned lo = std::stoul(first), hi = std::stoul(last);
+            if (hi < lo || hi > MAX_CPU_ID) return false;
+            for (unsigned cpu = lo; cpu <= hi; ++cpu) cpus.push_back(cpu);
+        }
+        return true;
+    }
+
+    #ifdef __linux__
+    inline int readSysfsInt(const std::string& path, int fallback) {
+        std::ifstream file(path);
+        int value;
+        return (file >> value) ? value : fallback;
+    }
+    #endif
+
+    // Every logical CPU this process may run on, in id order
+    inline std::vector<Cpu> discover() {
+        std::vector<Cpu> cpus;
+
+    #ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        auto readList = [](const std::string& path) {
+            std::vector<unsigned> ids;
+            std::ifstream file(path);
+            std::string text;
+            if (std::getline(file, text)) parseCpuList(text, ids);
+            return ids;
+        };
+
+        // [O(nodes * cpus)] CPU -> node map from each node's cpulist
+        std::vector<int> nodeOf;
+        for (unsigned node : readList("/sys/devices/system/node/online")) {
+            for (unsigned id : readList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist")) {
+                if (id >= nodeOf.size()) nodeOf.resize(id + 1, 0);
+                nodeOf[id] = static_cast<int>(node);
+            }
+        }
+
+        for (unsigned id : readList("/sys/devices/system/cpu/online")) {
+            if (haveMask && id < CPU_SETSIZE && !CPU_ISSET(id, &allowed)) continue;
+
+            const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(id);
+            Cpu cpu;
+            cpu.id = id;
+            cpu.package = readSysfsInt(base + "/topology/physical_package_id", 0);
+            cpu.core = cpu.package * 65536 + readSysfsInt(base + "/topology/core_id", static_cast<int>(id));
+            cpu.node = id < nodeOf.size() ? nodeOf[id] : 0;
+            cpu.llc = cpu.package * 65536 + readSysfsInt(base + "/cache/index3/id", readSysfsInt(base + "/cache/index2/id", 0));
+            cpus.push_back(cpu);
+        }
+    #endif
+
+        if (cpus.empty()) { // Portable fallback: flat topology
+            for (unsigned id = 0; id < std::max(1u, std::thread::hardware_concurrency()); ++id) {
+                cpus.push_back({id, static_cast<int>(id), 0, 0, 0});
+            }
+        }
+
+        // [O(n log n)] Number SMT siblings within each core in id order
+        std::vector<Cpu> byCore = cpus;
+        std::stable_sort(byCore.begin(), byCore.end(), [](const Cpu& a, const Cpu& b) { return a.core < b.core; });
+        for (size_t k = 0; k < byCore.size(); ++k) {
+            int sibling = (k > 0 && byCore[k - 1].core == byCore[k].core) ? byCore[k - 1].thread + 1 : 0;
+            byCore[k].thread = sibling;
+            for (auto& cpu : cpus) if (cpu.id == byCore[k].id) cpu.thread = sibling;
+        }
+        return cpus;
+    }
+
+    inline const Cpu* find(const std::vector<Cpu>& cpus, unsigned id) {
+        for (const auto& cpu : cpus) if (cpu.id == id) return &cpu;
+        return nullptr;
+    }
+
+    // Logical CPU for each worker; the result's size is the worker count.
+    // None keeps one (unpinned) worker per CPU, so the ids are only used for reporting.
+    inline std::vector<unsigned> placement(const std::vector<Cpu>& cpus, Affinity mode, const std::vector<unsigned>& list) {
+        std::vector<Cpu> order = cpus;
+
+        switch (mode) {
+            case Affinity::List: {
+                std::vector<unsigned> chosen;
+                for (unsigned id : list) if (find(cpus, id)) chosen.push_back(id);
+                return chosen;
+            }
+            case Affinity::Compact: // Fill every sibling of a core, then the next core, then the next package
+                std::sort(order.begin(), order.end(), [](const Cpu& a, const Cpu& b) {
+                    return a.package != b.package ? a.package < b.package
+                         : a.core != b.core       ? a.core < b.core
+                         : a.thread < b.thread;
+                });
+                break;
+            case Affinity::Scatter: // First thread of every core before any sibling, alternating packages
+            case Affinity::Physical: {
+                // [O(n^2)] Rank of each CPU among same-sibling-index CPUs of its package
+                auto rank = [&](const Cpu& cpu) {
+                    int r = 0;
+                    for (const auto& other : cpus) {
+                        r += other.package == cpu.package && other.thread == cpu.thread && other.core < cpu.core;
+                    }
+                    return r;
+                };
+                std::vector<std::pair<int, const Cpu*>> keyed;
+                for (const auto& cpu : cpus) keyed.push_back({rank(cpu), &cpu});
+                std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) {
+                    return a.second->thread != b.second->thread ? a.second->thread < b.second->thread
+                         : a.first != b.first                   ? a.first < b.first
+                         : a.second->package < b.second->package;
+                });
+
+                order.clear();
+                for (const auto& [r, cpu] : keyed) {
+                    if (mode == Affinity::Physical && cpu->thread != 0) continue; // No SMT siblings
+                    order.push_back(*cpu);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        std::vector<unsigned> ids;
+        for (const auto& cpu : order) ids.push_back(cpu.id);
+        return ids;
+    }
+
+    // Pins the calling thread to one logical CPU
+    inline bool pinCurrentThread(unsigned cpu) {
+    #ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+    #elif defined(_WIN32)
+        return cpu < 64 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+    #else
+        (void)cpu;
+        return false;
+    #endif
+    }
+
+    // Makes the calling thread's future page allocations prefer `node` (first touch still applies)
+    inline bool preferNode(int node) {
+    #if defined(__linux__) && defined(SYS_set_mempolicy)
+        constexpr int MPOL_PREFERRED_MODE = 1;  // MPOL_PREFERRED from <linux/mempolicy.h>
+        unsigned long mask[16] = {};
+        if (node < 0 || node >= static_cast<int>(sizeof(mask) * 8)) return false;
+        mask[node / (sizeof(unsigned long) * 8)] |= 1ul << (node % (sizeof(unsigned long) * 8));
+        return syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, mask, sizeof(mask) * 8) == 0;
+    #else
+        (void)node;
+        return false;
+    #endif
+    }
+
+    // Data/unified cache sizes in bytes as seen by CPU 0 (per instance: L1d/L2 per core, LLC shared)
+    struct CacheSizes {
+        size_t l1d = 32 * 1024;             // Defaults used when neither sysfs nor CPUID answers
+        size_t l2 = 1024 * 1024;
+        size_t llc = 16 * 1024 * 1024;
+        unsigned llcSharing = 1;            // Logical CPUs sharing one LLC instance
+        const char* source = "defaults";    // "sysfs", "cpuid" or "defaults"
+    };
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // [O(cache levels)] Deterministic cache parameters: CPUID leaf 4 (Intel) or 0x8000001D (AMD/Hygon,
+    // needs TOPOEXT). Size = ways * partitions * line size * sets; the sharing count is the number of
+    // logical processor ids the cache serves, which can exceed the CPUs actually present.
+    inline bool cpuidCacheSizes(CacheSizes& sizes) {
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) return false;
+        const unsigned maxLeaf = eax;
+        const bool amd = ebx == 0x68747541 || ebx == 0x6F677948;   // "Auth"enticAMD, "Hygo"nGenuine
+        unsigned leaf = 4;
+        if (amd) {
+            if (__get_cpuid_max(0x80000000, nullptr) < 0x8000001D) return false;
+            __cpuid(0x80000001, eax, ebx, ecx, edx);
+            if (!(ecx & (1u << 22))) return false;
+            leaf = 0x8000001D;
+        } else if (maxLeaf < 4) {
+            return false;
+        }
+
+        size_t l1 = 0, l2 = 0, l3 = 0;
+        unsigned l2Sharing = 1, l3Sharing = 1;
+        for (unsigned index = 0; index < 16; ++index) {
+            __cpuid_count(leaf, index, eax, ebx, ecx, edx);
+            const unsigned type = eax & 0x1F;   // 0 = no more caches, 1 = data, 2 = instruction, 3 = unified
+            if (type == 0) break;
+            if (type == 2) continue;
+            const unsigned level = (eax >> 5) & 0x7;
+            const unsigned sharing = ((eax >> 14) & 0xFFF) + 1;
+            const size_t bytes = size_t((ebx >> 22) + 1) * (((ebx >> 12) & 0x3FF) + 1) * ((ebx & 0xFFF) + 1) * (size_t(ecx) + 1);
+            if (level == 1) l1 = bytes;
+            if (level == 2) { l2 = bytes; l2Sharing = sharing; }
+            if (level == 3) { l3 = bytes; l3Sharing = sharing; }
+        }
+        if (!l1 || !l2) return false;
+        sizes.l1d = l1;
+        sizes.l2 = l2;
+        sizes.llc = l3 ? l3 : l2;
+        sizes.llcSharing = std::max(1u, std::min(l3 ? l3Sharing : l2Sharing, std::thread::hardware_concurrency()));
+        sizes.source = "cpuid";
+        return true;
+    }
+#endif
+
+    // sysfs first (what the kernel enumerated, and the real sharing list), CPUID when it is missing
+    inline CacheSizes cacheSizes() {
+        CacheSizes sizes;
+    #ifdef __linux__
+        size_t l1 = 0, l2 = 0, l3 = 0;
+        std::string l2Shared, l3Shared;
+        for (int index = 0; index < 8; ++index) {
+            const std::string base = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index);
+            std::ifstream typeFile(base + "/type"), sizeFile(base + "/size"), sharedFile(base + "/shared_cpu_list");
+            std::string type, size, shared;
+            int level = readSysfsInt(base + "/level", 0);
+            if (!(typeFile >> type) || !(sizeFile >> size) || type == "Instruction") continue;
+            std::getline(sharedFile, shared);
+
+            size_t bytes = std::stoul(size);                        // "48K", "2048K", "32M"
+            if (size.back() == 'K') bytes *= 1024;
+            if (size.back() == 'M') bytes *= 1024 * 1024;
+
+            if (level == 1) l1 = bytes;
+            if (level == 2) { l2 = bytes; l2Shared = shared; }
+            if (level == 3) { l3 = bytes; l3Shared = shared; }
+        }
+        if (l1 && l2) {
+            std::vector<unsigned> sharing;
+            parseCpuList(l3 ? l3Shared : l2Shared, sharing);
+            sizes.l1d = l1;
+            sizes.l2 = l2;
+            sizes.llc = l3 ? l3 : l2;
+            sizes.llcSharing = std::max<unsigned>(1, static_cast<unsigned>(sharing.size()));
+            sizes.source = "sysfs";
+            return sizes;
+        }
+    #endif
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        cpuidCacheSizes(sizes);
+    #endif
+        return sizes;
+    }
+
+    // Number of distinct NUMA nodes among `cpus`
+    inline int nodeCount(const std::vector<Cpu>& cpus) {
+        int highest = 0;
+        for (const auto& cpu : cpus) highest = std::max(highest, cpu.node);
+        return highest + 1;
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>       //! Provides std::atomic, used for the lock-free deque indices and the active-worker word.
+#include <vector>       //? Provides std::vector, used to hold one deque per worker.
+#include <memory>       //! Provides std::unique_ptr, used because the cache-line-aligned deques are not movable.
+#include <cstdint>      //! Provides fixed-width integer types for packed tasks.
+#include <climits>      //? Provides UINT_MAX, used as the shutdown sentinel.
+
+/*
+ * Work-stealing scheduler for the CPU hash workers.
+ *
+ * Every worker owns a Chase-Lev deque of batched hash tasks. The owner pushes and pops
+ * at the bottom; idle workers steal from the top of other deques. When a worker's own
+ * deque and every victim are empty it refills its deque from a global index cursor,
+ * so the pool never runs dry.
+ *
+ * The number of active workers is a single atomic word. Workers above the limit park
+ * on it (std::atomic::wait) and hand their unfinished range back to their own deque,
+ * where the still-active workers steal it. Changing the limit never blocks the caller.
+ */
+namespace WorkStealing {
+
+    // A contiguous range of hash indices [begin, begin + count)
+    struct Task {
+        uint64_t begin = 0;
+        uint32_t count = 0;
+
+        // Packed into one word so deque slots can be plain atomics (40-bit begin, 24-bit count)
+        uint64_t pack() const { return (begin << 24) | count; }
+        static Task unpack(uint64_t word) { return {word >> 24, static_cast<uint32_t>(word & 0xFFFFFF)}; }
+    };
+
+    // Fixed-capacity Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for
+    // Weak Memory Models", 2013). Only the owner calls push/pop; anyone may call steal.
+    class TaskDeque {
+        static constexpr int64_t CAPACITY = 64;    // Power of two
+        static constexpr int64_t MASK = CAPACITY - 1;
+
+        alignas(64) std::atomic<int64_t> top{0};    // Thieves' end
+        alignas(64) std::atomic<int64_t> bottom{0}; // Owner's end
+        std::atomic<uint64_t> slots[CAPACITY];
+
+    public:
+        bool push(Task task) {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            if (b - t >= CAPACITY) return false;    // Full
+
+            slots[b & MASK].store(task.pack(), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool pop(Task& task) {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b) { // Empty
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            task = Task::unpack(slots[b & MASK].load(std::memory_order_relaxed));
+            if (t == b) { // Last element: race any thief for it
+                bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        bool steal(Task& task) {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) return false; // Empty
+
+            uint64_t word = slots[t & MASK].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false; // Lost the race to the owner or another thief
+            }
+            task = Task::unpack(word);
+            return true;
+        }
+    };
+
+    class Pool {
+        static constexpr unsigned REFILL = 4; // [O(1)] Tasks claimed from the global cursor at a time
+
+        std::vector<std::unique_ptr<TaskDeque>> deques;
+        alignas(64) std::atomic<uint64_t> cursor{0};     // Next unclaimed hash index
+        alignas(64) std::atomic<unsigned> activeLimit;   // Workers with id < activeLimit may run
+        std::atomic<uint64_t> stolenTasks{0};
+        uint32_t taskSize;
+
+    public:
+        Pool(unsigned workers, uint32_t taskSize) : activeLimit(workers), taskSize(taskSize) {
+            for (unsigned i = 0; i < workers; ++i) deques.push_back(std::make_unique<TaskDeque>());
+        }
+
+        unsigned size() const { return static_cast<unsigned>(deques.size()); }
+
+        // Next task for worker `self`: own deque first, then steal, then refill from the cursor
+        Task acquire(unsigned self) {
+            Task task;
+            if (deques[self]->pop(task)) return task;
+
+            for (unsigned k = 1; k < size(); ++k) { // [O(workers)] Victims in ring order after self
+                if (deques[(self + k) % size()]->steal(task)) {
+                    stolenTasks.fetch_add(1, std::memory_order_relaxed);
+                    return task;
+                }
+            }
+
+            uint64_t begin = cursor.fetch_add(uint64_t(REFILL) * taskSize, std::memory_order_relaxed);
+            for (unsigned r = 1; r < REFILL; ++r) {
+                deques[self]->push({begin + uint64_t(r) * taskSize, taskSize});
+            }
+            return {begin, taskSize};
+        }
+
+        // Gives back the unfinished part of a task; thieves pick it up while this worker is parked
+        // (cannot overflow: a deque never holds more than REFILL tasks)
+        void yield(unsigned self, Task rest) {
+            if (rest.count > 0) deques[self]->push(rest);
+        }
+
+        bool isActive(unsigned self) const { return self < activeLimit.load(std::memory_order_relaxed); }
+
+        // Blocks while worker `self` is above the active limit; returns immediately otherwise
+        void parkWhileInactive(unsigned self) {
+            unsigned limit = activeLimit.load(std::memory_order_acquire);
+            while (self >= limit) {
+                activeLimit.wait(limit, std::memory_order_acquire);
+                limit = activeLimit.load(std::memory_order_acquire);
+            }
+        }
+
+        // Non-blocking: parked workers are woken, surplus workers park after their current op
+        void setActive(unsigned workers) {
+            if (activeLimit.exchange(workers, std::memory_order_release) != workers) {
+                activeLimit.notify_all();
+            }
+        }
+
+        unsigned active() const {
+            unsigned limit = activeLimit.load(std::memory_order_relaxed);
+            return limit > size() ? size() : limit;
+        }
+
+        // Releases every parked worker so it can observe the stop flag
+        void shutdown() { setActive(UINT_MAX); }
+
+        uint64_t stolen() const { return stolenTasks.load(std::memory_order_relaxed); }
+    };
+}
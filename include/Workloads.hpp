@@ -0,0 +1,520 @@
+#pragma once
+
+#include <cmath>        //! Provides std::fma, used by the portable FP64 chain kernel.
+#include <memory>       //! Provides std::unique_ptr, used to hand out per-thread kernel instances.
+#include <vector>       //? Provides std::vector, used for per-thread kernel working sets.
+#include <cstdint>      //! Provides fixed-width integer types used by every kernel.
+#include <numeric>      //? Provides std::iota, used when building the pointer-chase cycle.
+#include <string_view>  //? Provides std::string_view, used for registry lookups by name.
+#include <utility>      //? Provides std::integer_sequence, used to unroll the chain kernels at compile time.
+
+#include "SimdHash.hpp" //* 4/8/16-lane SSE4.2/AVX2/AVX-512 variants of computeIntensiveHash.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>  //> x86 intrinsics (AVX2/AVX-512/SSE4.2/AES-NI), compiled per-function via target attributes.
+    #define STRESS_X86_TARGETS 1
+#else
+    #define STRESS_X86_TARGETS 0
+#endif
+
+/*
+ * CPU workload kernels.
+ *
+ * Each kernel is a Workload: one runOnce() call is one "op" and returns a value
+ * the caller must consume so the work cannot be optimised away. The registry
+ * below maps a name to a factory so a run can select kernels with --workload.
+ *
+ * ISA-specific kernels are compiled with per-function target attributes and are
+ * only offered when the running CPU reports the feature, so a single binary
+ * works on every x86-64 host.
+ */
+namespace Workloads {
+
+    class Workload {
+    public:
+        virtual ~Workload() = default;
+
+        // Performs one call for batch index `i` and returns its result.
+        virtual uint64_t runOnce(uint64_t i) = 0;
+
+        // Ops completed by one runOnce() call (lane count for the SIMD kernels).
+        virtual uint64_t opsPerRun() const { return 1; }
+    };
+
+    struct WorkloadInfo {
+        const char* name;                                       // Name used with --workload
+        const char* description;                                // One-line description for --list-workloads
+        bool (*isSupported)();                                  // Whether this CPU can run the kernel
+        std::unique_ptr<Workload> (*create)(unsigned threadId); // Per-thread factory
+    };
+
+    // ============================================================================================
+    // INTEGER MODEXP (the original computeIntensiveHash)
+    // ============================================================================================
+
+    //! MODULAR EXPONENTIATION: CORE OF PUBLIC-KEY CRYPTOGRAPHY
+    // Compute-intensive hash-like function that uses nested modular exponentiation.
+    // [O(exponent^2)] Time complexity is quadratic in 'exponent' due to the nested loop.
+    inline uint64_t computeIntensiveHash(uint64_t base, uint64_t exponent, uint64_t mod) {
+        uint64_t result = 1;       // [O(1)] Result of modular exponentiation
+        uint64_t nestedFactor = 1; // [O(1)] Additional factor to amplify computation complexity
+
+        for (uint64_t i = 0; i < exponent; ++i) { // [O(exponent)] Outer loop runs 'exponent' times
+            result = (result * base) % mod;                 // [O(1)] Base modular exponentiation
+            nestedFactor = (nestedFactor * result) % mod;   // [O(1)] Nested computation step
+
+            for (uint64_t j = 0; j < exponent; ++j) {       // [O(exponent)] Inner loop runs 'exponent' times
+                nestedFactor += i + j;                      // Add nestedFactor with the current iteration values.
+                result *= nestedFactor;                     // Multiply result by nestedFactor
+            }
+
+            if (i % 10 == 0) { // [O(1)] Condition check occurs on every iteration
+                result = (result + nestedFactor) % mod;     // [O(1)] Add nested result periodically
+            }
+        }
+        return result; // [O(1)] Return the final computed value
+    }
+
+    class ModExpWorkload final : public Workload {
+        unsigned threadId;
+    public:
+        explicit ModExpWorkload(unsigned threadId) : threadId(threadId) {}
+
+        uint64_t runOnce(uint64_t i) override {
+            // Generate pseudo-random input values for hashing.
+            volatile uint64_t randomBase = threadId * 123456789 + i * 987654321;         // [O(1)]
+            volatile uint64_t randomExponent = ((i % 2000) + 500) * (threadId % 10 + 1); // [O(1)]
+            volatile uint64_t randomModulus = 1e9 + 12347;                              // [O(1)]
+
+            return computeIntensiveHash(randomBase, randomExponent, randomModulus); // [O(randomExponent^2)]
+        }
+    };
+
+    // ============================================================================================
+    // MULTI-LANE MODEXP (SSE4.2 / AVX2 / AVX-512)
+    // ============================================================================================
+    // Call `i` hashes the lanes(ISA) consecutive indices starting at i * lanes(ISA), using the
+    // same base/exponent schedule as ModExpWorkload, so both cover the same loop counts.
+
+    template <SimdHash::Isa ISA>
+    class ModExpLanesWorkload final : public Workload {
+        static constexpr unsigned L = SimdHash::lanes(ISA);
+        unsigned threadId;
+
+    public:
+        explicit ModExpLanesWorkload(unsigned threadId) : threadId(threadId) {}
+
+        uint64_t runOnce(uint64_t i) override {
+            uint32_t base[L], exponent[L], out[L];
+            for (unsigned l = 0; l < L; ++l) {
+                uint64_t index = i * L + l;
+                base[l] = static_cast<uint32_t>(threadId * 123456789ull + index * 987654321ull);
+                exponent[l] = static_cast<uint32_t>(((index % 2000) + 500) * (threadId % 10 + 1));
+            }
+
+            SimdHash::hashLanes(ISA, base, exponent, out); // [O(max exponent^2)]
+
+            uint64_t folded = 0;
+            for (unsigned l = 0; l < L; ++l) folded ^= static_cast<uint64_t>(out[l]) << (l % 2 ? 32 : 0);
+            return folded;
+        }
+
+        uint64_t opsPerRun() const override { return L; }
+    };
+
+    // ============================================================================================
+    // FP64 FMA CHAINS
+    // ============================================================================================
+    // 32 independent x = x * a + b chains keep both FMA ports busy: with AVX2 that is eight 4-wide
+    // accumulators, enough to cover a 4-cycle FMA latency on two ports (latency x ports = 8 in
+    // flight). The constants keep every chain bounded (fixed point b / (1 - a)) so no value ever
+    // becomes denormal or infinite.
+
+    class FmaChainWorkload final : public Workload {
+        static constexpr int CHAINS = 32;
+        static constexpr int VECTORS = CHAINS / 4;  // 4-wide AVX2 accumulators (x0..x7 below)
+        static constexpr int ITERATIONS = 1 << 12; // [O(1)] FMAs per chain per op (2^17 per op, as before)
+        double seed;
+
+        static double sum(const double (&x)[CHAINS]) {
+            double total = 0.0;
+            for (int c = 0; c < CHAINS; ++c) total += x[c];
+            return total;
+        }
+
+        static double chainsPortable(double seed) {
+            double x[CHAINS];
+            for (int c = 0; c < CHAINS; ++c) x[c] = seed + c;
+
+            for (int it = 0; it < ITERATIONS; ++it) {   // [O(ITERATIONS * CHAINS)]
+                for (int c = 0; c < CHAINS; ++c) {
+                    x[c] = std::fma(x[c], 0.999999, 1e-6);
+                }
+            }
+            return sum(x);
+        }
+
+    #if STRESS_X86_TARGETS
+        __attribute__((target("avx2,fma")))
+        static double chainsHardware(double seed) {
+            __m256d a = _mm256_set1_pd(0.999999);
+            __m256d b = _mm256_set1_pd(1e-6);
+            // Named accumulators: an array indexed in an inner loop is kept in memory at -O2
+            const __m256d four = _mm256_set1_pd(4.0);
+            __m256d x0 = _mm256_setr_pd(seed, seed + 1, seed + 2, seed + 3);
+            __m256d x1 = _mm256_add_pd(x0, four), x2 = _mm256_add_pd(x1, four), x3 = _mm256_add_pd(x2, four);
+            __m256d x4 = _mm256_add_pd(x3, four), x5 = _mm256_add_pd(x4, four), x6 = _mm256_add_pd(x5, four);
+            __m256d x7 = _mm256_add_pd(x6, four);
+
+            for (int it = 0; it < ITERATIONS; ++it) {   // [O(ITERATIONS)] Eight 4-wide chains in flight
+                x0 = _mm256_fmadd_pd(x0, a, b);
+                x1 = _mm256_fmadd_pd(x1, a, b);
+                x2 = _mm256_fmadd_pd(x2, a, b);
+                x3 = _mm256_fmadd_pd(x3, a, b);
+                x4 = _mm256_fmadd_pd(x4, a, b);
+                x5 = _mm256_fmadd_pd(x5, a, b);
+                x6 = _mm256_fmadd_pd(x6, a, b);
+                x7 = _mm256_fmadd_pd(x7, a, b);
+            }
+
+            alignas(32) double x[CHAINS];
+            const __m256d all[VECTORS] = {x0, x1, x2, x3, x4, x5, x6, x7};
+            for (int v = 0; v < VECTORS; ++v) _mm256_store_pd(x + 4 * v, all[v]);
+            return sum(x);
+        }
+    #endif
+
+    public:
+        explicit FmaChainWorkload(unsigned threadId) : seed(1.0 + threadId) {}
+
+        uint64_t runOnce(uint64_t i) override {
+            double s = seed + static_cast<double>(i % 64);
+    #if STRESS_X86_TARGETS
+            static const bool hardwareFma = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            if (hardwareFma) return static_cast<uint64_t>(chainsHardware(s) * 1e6);
+    #endif
+            return static_cast<uint64_t>(chainsPortable(s) * 1e6);
+        }
+    };
+
+    // ============================================================================================
+    // DENSE GEMM (AVX2 / AVX-512)
+    // ============================================================================================
+    // One op is a full N x N x N double-precision multiply C += A * B on per-thread matrices
+    // that fit comfortably in L2, so the kernel is bound by the FMA units rather than memory.
+
+    template <int N>
+    class GemmState {
+    protected:
+        alignas(64) double a[N * N];
+        alignas(64) double b[N * N];
+        alignas(64) double c[N * N];
+
+        explicit GemmState(unsigned threadId) {
+            for (int k = 0; k < N * N; ++k) {
+                a[k] = 1.0 + ((k + threadId) % 7) * 1e-3;
+                b[k] = 1.0 - ((k * 3 + threadId) % 5) * 1e-3;
+                c[k] = 0.0;
+            }
+        }
+
+        uint64_t checksum() {
+            double sum = c[0] + c[N * N - 1];
+            // Rescale instead of zeroing so C stays bounded without a separate memset pass.
+            for (int k = 0; k < N * N; ++k) c[k] *= 1e-3;
+            return static_cast<uint64_t>(sum);
+        }
+    };
+
+    #if STRESS_X86_TARGETS
+    class GemmAvx2Workload final : public Workload, GemmState<64> {
+        static constexpr int N = 64;
+
+        __attribute__((target("avx2,fma")))
+        void multiply() {
+            for (int i = 0; i < N; ++i) {
+                for (int k = 0; k < N; ++k) {
+                    __m256d aik = _mm256_set1_pd(a[i * N + k]);
+                    for (int j = 0; j < N; j += 4) {
+                        __m256d cij = _mm256_load_pd(&c[i * N + j]);
+                        cij = _mm256_fmadd_pd(aik, _mm256_load_pd(&b[k * N + j]), cij);
+                        _mm256_store_pd(&c[i * N + j], cij);
+                    }
+                }
+            }
+        }
+
+    public:
+        explicit GemmAvx2Workload(unsigned threadId) : GemmState(threadId) {}
+
+        uint64_t runOnce(uint64_t) override {
+            multiply();
+            return checksum();
+        }
+    };
+
+    class GemmAvx512Workload final : public Workload, GemmState<64> {
+        static constexpr int N = 64;
+
+        __attribute__((target("avx512f")))
+        void multiply() {
+            for (int i = 0; i < N; ++i) {
+                for (int k = 0; k < N; ++k) {
+                    __m512d aik = _mm512_set1_pd(a[i * N + k]);
+                    for (int j = 0; j < N; j += 8) {
+                        __m512d cij = _mm512_load_pd(&c[i * N + j]);
+                        cij = _mm512_fmadd_pd(aik, _mm512_load_pd(&b[k * N + j]), cij);
+                        _mm512_store_pd(&c[i * N + j], cij);
+                    }
+                }
+            }
+        }
+
+    public:
+        explicit GemmAvx512Workload(unsigned threadId) : GemmState(threadId) {}
+
+        uint64_t runOnce(uint64_t) override {
+            multiply();
+            return checksum();
+        }
+    };
+    #endif
+
+    // ============================================================================================
+    // BRANCHY POINTER CHASE
+    // ============================================================================================
+    // A single random cycle (Sattolo's algorithm) over a few MB of nodes. Every hop is a
+    // dependent load followed by a data-dependent branch the predictor cannot learn.
+
+    class PointerChaseWorkload final : public Workload {
+        static constexpr size_t NODES = 1 << 20;   // 1M nodes * 4 B (uint32_t links) = 4 MB working set
+        static constexpr int HOPS = 1 << 14;       // [O(1)] Dependent loads per op
+
+        std::vector<uint32_t> next;
+        uint32_t cursor = 0;
+
+    public:
+        explicit PointerChaseWorkload(unsigned threadId) : next(NODES) {
+            std::iota(next.begin(), next.end(), 0u);
+            uint64_t state = 0x9E3779B97F4A7C15ull ^ threadId;
+            for (size_t k = NODES - 1; k > 0; --k) { // [O(NODES)] Sattolo shuffle: one cycle through all nodes
+                state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+                size_t r = state % k;
+                std::swap(next[k], next[r]);
+            }
+        }
+
+        uint64_t runOnce(uint64_t) override {
+            uint64_t acc = 0;
+            uint32_t p = cursor;
+            for (int h = 0; h < HOPS; ++h) { // [O(HOPS)]
+                p = next[p];
+                if (p & 1) {                 // Unpredictable: depends on the shuffled index
+                    acc += p;
+                } else if (p & 2) {
+                    acc ^= p << 3;
+                } else {
+                    acc -= p >> 1;
+                }
+            }
+            cursor = p;
+            return acc;
+        }
+    };
+
+    // ============================================================================================
+    // CRC32 / AES-NI
+    // ============================================================================================
+    // Both stream a per-thread 64 KB buffer (L2-resident) through the dedicated crypto units.
+
+    #if STRESS_X86_TARGETS
+    class Crc32Workload final : public Workload {
+        static constexpr size_t WORDS = 64 * 1024 / sizeof(uint64_t);
+        std::vector<uint64_t> buffer;
+
+    public:
+        explicit Crc32Workload(unsigned threadId) : buffer(WORDS) {
+            for (size_t k = 0; k < WORDS; ++k) buffer[k] = (k + 1) * 0x9E3779B97F4A7C15ull ^ threadId;
+        }
+
+        __attribute__((target("sse4.2")))
+        uint64_t runOnce(uint64_t i) override {
+            uint64_t crc = i;
+            for (size_t k = 0; k < WORDS; ++k) { // [O(WORDS)]
+                crc = _mm_crc32_u64(crc, buffer[k]);
+            }
+            return crc;
+        }
+    };
+
+    class AesWorkload final : public Workload {
+        static constexpr size_t BLOCKS = 64 * 1024 / 16;
+        std::vector<uint64_t> buffer; // Two words per 128-bit block
+
+    public:
+        explicit AesWorkload(unsigned threadId) : buffer(BLOCKS * 2) {
+            for (size_t k = 0; k < BLOCKS; ++k) {
+                buffer[2 * k] = threadId;
+                buffer[2 * k + 1] = k;
+            }
+        }
+
+        __attribute__((target("aes,sse4.1")))
+        uint64_t runOnce(uint64_t i) override {
+            __m128i key = _mm_set_epi64x(i, 0x0F1E2D3C4B5A6978ll);
+            __m128i state = _mm_setzero_si128();
+            for (size_t k = 0; k < BLOCKS; ++k) { // [O(BLOCKS)] Ten rounds per block, like AES-128
+                __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[2 * k])), state);
+                for (int round = 0; round < 10; ++round) {
+                    block = _mm_aesenc_si128(block, key);
+                }
+                state = block;
+            }
+            return static_cast<uint64_t>(_mm_extract_epi64(state, 0));
+        }
+    };
+    #endif
+
+    // ============================================================================================
+    // COMPILE-TIME SPECIALISED MODMUL CHAINS
+    // ============================================================================================
+    // One call runs CHAIN_STEPS modular multiplications split across CHAINS independent
+    // accumulators, with the step loop unrolled UNROLL times. MOD, UNROLL and CHAINS are
+    // template constants, so the modulo is strength-reduced to multiply/shift and the chains
+    // are scheduled side by side: CHAINS = 1 is bound by mul+reduce latency, many chains by
+    // multiplier throughput. The same total work per call keeps ops/s comparable across variants.
+
+    constexpr uint64_t MOD_PRIME30 = 1000012347ull;              // The original modexp modulus (1e9 + 12347)
+    constexpr uint64_t MOD_MERSENNE31 = (uint64_t(1) << 31) - 1; // Same field as the SIMD lane kernels
+    constexpr uint64_t MOD_MERSENNE61 = (uint64_t(1) << 61) - 1; // Needs a 128-bit product: heavier step
+    constexpr uint64_t CHAIN_STEPS = 1 << 16;                    // Multiplications per call, all chains together
+
+    template <uint64_t MOD>
+    inline uint64_t mulMod(uint64_t a, uint64_t b) {
+        if constexpr (MOD < (uint64_t(1) << 32)) {
+            return a * b % MOD; // [O(1)] Both operands < 2^32, product fits, constant divisor
+    #ifdef __SIZEOF_INT128__
+        } else if constexpr (MOD == MOD_MERSENNE61) {
+            unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            uint64_t folded = static_cast<uint64_t>(product & MOD) + static_cast<uint64_t>(product >> 61); // < 2^62
+            folded = (folded & MOD) + (folded >> 61);
+            return folded >= MOD ? folded - MOD : folded;
+        } else {
+            return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % MOD);
+    #endif
+        }
+    }
+
+    template <unsigned... U, typename Fn>
+    inline void unrolled(std::integer_sequence<unsigned, U...>, Fn&& fn) { (fn(U), ...); }
+
+    template <uint64_t MOD, unsigned UNROLL, unsigned CHAINS>
+    class ModMulChainWorkload final : public Workload {
+        static_assert(CHAIN_STEPS % (UNROLL * CHAINS) == 0, "steps must split evenly into chains and unrolled groups");
+        unsigned threadId;
+
+    public:
+        explicit ModMulChainWorkload(unsigned threadId) : threadId(threadId) {}
+
+        uint64_t runOnce(uint64_t i) override {
+            const uint64_t base = (threadId * 123456789ull + i * 987654321ull) % MOD | 1;
+            uint64_t acc[CHAINS];
+            for (unsigned c = 0; c < CHAINS; ++c) acc[c] = (base + c) % MOD;
+
+            // [O(CHAIN_STEPS)] Each chain only depends on itself
+            for (uint64_t s = 0; s < CHAIN_STEPS / CHAINS; s += UNROLL) {
+                unrolled(std::make_integer_sequence<unsigned, UNROLL>{}, [&](unsigned) {
+                    for (unsigned c = 0; c < CHAINS; ++c) acc[c] = mulMod<MOD>(acc[c], base + c);
+                });
+            }
+
+            uint64_t result = 0;
+            for (unsigned c = 0; c < CHAINS; ++c) result ^= acc[c];
+            return result;
+        }
+    };
+
+    // ============================================================================================
+    // REGISTRY
+    // ============================================================================================
+
+    template <typename T>
+    std::unique_ptr<Workload> make(unsigned threadId) { return std::make_unique<T>(threadId); }
+
+    // Instantiations offered at runtime (as --workload names), latency-bound to throughput-bound
+    struct ChainVariant {
+        const char* name;
+        const char* description;
+        std::unique_ptr<Workload> (*create)(unsigned threadId);
+    };
+
+    inline constexpr ChainVariant CHAIN_VARIANTS[] = {
+        {"chain-p30-c1-u1",  "Modmul chains: mod 1e9+12347, 1 chain, no unroll (latency-bound)", make<ModMulChainWorkload<MOD_PRIME30, 1, 1>>},
+        {"chain-p30-c1-u4",  "Modmul chains: mod 1e9+12347, 1 chain, unroll 4",                  make<ModMulChainWorkload<MOD_PRIME30, 4, 1>>},
+        {"chain-p30-c2-u4",  "Modmul chains: mod 1e9+12347, 2 chains, unroll 4",                 make<ModMulChainWorkload<MOD_PRIME30, 4, 2>>},
+        {"chain-p30-c4-u4",  "Modmul chains: mod 1e9+12347, 4 chains, unroll 4",                 make<ModMulChainWorkload<MOD_PRIME30, 4, 4>>},
+        {"chain-p30-c8-u4",  "Modmul chains: mod 1e9+12347, 8 chains, unroll 4",                 make<ModMulChainWorkload<MOD_PRIME30, 4, 8>>},
+        {"chain-p30-c16-u2", "Modmul chains: mod 1e9+12347, 16 chains, unroll 2 (throughput-bound)", make<ModMulChainWorkload<MOD_PRIME30, 2, 16>>},
+        {"chain-m31-c1-u4",  "Modmul chains: mod 2^31-1, 1 chain, unroll 4",                     make<ModMulChainWorkload<MOD_MERSENNE31, 4, 1>>},
+        {"chain-m31-c8-u4",  "Modmul chains: mod 2^31-1, 8 chains, unroll 4",                    make<ModMulChainWorkload<MOD_MERSENNE31, 4, 8>>},
+    #ifdef __SIZEOF_INT128__
+        {"chain-m61-c1-u4",  "Modmul chains: mod 2^61-1 (128-bit product), 1 chain, unroll 4",   make<ModMulChainWorkload<MOD_MERSENNE61, 4, 1>>},
+        {"chain-m61-c8-u4",  "Modmul chains: mod 2^61-1 (128-bit product), 8 chains, unroll 4",  make<ModMulChainWorkload<MOD_MERSENNE61, 4, 8>>},
+    #endif
+    };
+
+    inline bool always() { return true; }
+
+    template <SimdHash::Isa ISA>
+    bool hasIsa() { return SimdHash::isSupported(ISA); }
+
+    // Widest multi-lane modexp the CPU supports, chosen from CPUID at startup
+    inline std::unique_ptr<Workload> makeBestModExpLanes(unsigned threadId) {
+        switch (SimdHash::detectBest()) {
+            case SimdHash::Isa::Avx512: return make<ModExpLanesWorkload<SimdHash::Isa::Avx512>>(threadId);
+            case SimdHash::Isa::Avx2:   return make<ModExpLanesWorkload<SimdHash::Isa::Avx2>>(threadId);
+            case SimdHash::Isa::Sse42:  return make<ModExpLanesWorkload<SimdHash::Isa::Sse42>>(threadId);
+            default:                    return make<ModExpWorkload>(threadId);
+        }
+    }
+
+    #if STRESS_X86_TARGETS
+    inline bool hasAvx2()   { return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"); }
+    inline bool hasAvx512() { return __builtin_cpu_supports("avx512f"); }
+    inline bool hasSse42()  { return __builtin_cpu_supports("sse4.2"); }
+    inline bool hasAes()    { return __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse4.1"); }
+    #endif
+
+    inline const std::vector<WorkloadInfo>& registry() {
+        static const std::vector<WorkloadInfo> entries = [] {
+            std::vector<WorkloadInfo> list = {
+                {"modexp",        "Nested integer modular exponentiation (computeIntensiveHash)", always, make<ModExpWorkload>},
+                {"modexp-sse4.2", "4-lane modexp (mod 2^31-1) with SSE4.2",                       hasIsa<SimdHash::Isa::Sse42>,  make<ModExpLanesWorkload<SimdHash::Isa::Sse42>>},
+                {"modexp-avx2",   "8-lane modexp (mod 2^31-1) with AVX2",                         hasIsa<SimdHash::Isa::Avx2>,   make<ModExpLanesWorkload<SimdHash::Isa::Avx2>>},
+                {"modexp-avx512", "16-lane modexp (mod 2^31-1) with AVX-512",                     hasIsa<SimdHash::Isa::Avx512>, make<ModExpLanesWorkload<SimdHash::Isa::Avx512>>},
+                {"modexp-simd",   "Widest multi-lane modexp this CPU supports (CPUID dispatch)",  always, makeBestModExpLanes},
+                {"fma",           "FP64 FMA dependency chains (32 independent)",                  always, make<FmaChainWorkload>},
+    #if STRESS_X86_TARGETS
+                {"gemm-avx2",     "64x64 FP64 dense GEMM with AVX2 FMA",                          hasAvx2,   make<GemmAvx2Workload>},
+                {"gemm-avx512",   "64x64 FP64 dense GEMM with AVX-512 FMA",                       hasAvx512, make<GemmAvx512Workload>},
+    #endif
+                {"pointer-chase", "Branchy dependent-load walk over a 4 MB random cycle",         always, make<PointerChaseWorkload>},
+    #if STRESS_X86_TARGETS
+                {"crc32",         "SSE4.2 CRC32 over a 64 KB buffer",                             hasSse42, make<Crc32Workload>},
+                {"aes",           "AES-NI encryption rounds over a 64 KB buffer",                 hasAes,   make<AesWorkload>},
+    #endif
+            };
+            for (const auto& variant : CHAIN_VARIANTS) list.push_back({variant.name, variant.description, always, variant.create});
+            return list;
+        }();
+        return entries;
+    }
+
+    // Returns the registry entry called `name`, or nullptr if there is none.
+    inline const WorkloadInfo* find(std::string_view name) {
+        for (const auto& info : registry()) {
+            if (name == info.name) return &info;
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,332 @@
+#include <vector>       //? Provides std::vector, the device list and the GEMM input matrices.
+#include <string>       //? Provides std::string, device names and the build log.
+#include <chrono>       //! Provides steady_clock, the host's wall time of a round.
+#include <cstring>      //? Provides std::memset for the pinned staging buffer.
+#include <algorithm>    //? Provides std::clamp/std::min for the buffer sizes.
+
+#include "Gpu.hpp"          //* The backend interface main.cpp uses.
+
+#define CL_TARGET_OPENCL_VERSION 120
+#ifdef __APPLE__
+    #include <OpenCL/opencl.h>  //> Apple's OpenCL framework.
+#else
+    #include <CL/cl.h>          //> Khronos OpenCL 1.2 API (any ICD: ROCm, NVIDIA, Intel, PoCL).
+#endif
+
+// OpenCL backend of Gpu::Stress (see Gpu.hpp). Built as its own CMake target, only when
+// find_package(OpenCL) succeeds, so the rest of the tester never needs the SDK.
+namespace Gpu {
+
+    namespace {
+
+        constexpr size_t MODEXP_MAX_ITEMS = size_t(1) << 20;       // Result buffer size (8 MB)
+        constexpr double MODEXP_MIN_SECONDS = 0.05, MODEXP_MAX_SECONDS = 0.2;
+        constexpr size_t GEMM_N = 1024;                             // 2 GFLOP per launch
+        constexpr size_t COPY_MIN = size_t(16) << 20, COPY_MAX = size_t(256) << 20;
+        constexpr size_t TRANSFER_BYTES = size_t(64) << 20;
+
+        const char* const SOURCE = R"CL(
+            // computeIntensiveHash, line for line (Workloads.hpp)
+            __kernel void modexp(const ulong first, __global ulong* out) {
+                const ulong index = first + get_global_id(0);
+                const ulong base = index * 987654321UL;
+                const ulong exponent = index % 2000UL + 500UL;
+                const ulong mod = 1000012347UL;
+                ulong result = 1, nestedFactor = 1;
+                for (ulong i = 0; i < exponent; ++i) {
+                    result = (result * base) % mod;
+                    nestedFactor = (nestedFactor * result) % mod;
+                    for (ulong j = 0; j < exponent; ++j) {
+                        nestedFactor += i + j;
+                        result *= nestedFactor;
+                    }
+                    if (i % 10 == 0) result = (result + nestedFactor) % mod;
+                }
+                out[get_global_id(0)] = result;
+            }
+
+            // C = A * B, n a multiple of TILE, one TILE x TILE work group per output tile
+            __kernel __attribute__((reqd_work_group_size(TILE, TILE, 1)))
+            void gemm(const int n, __global const float* a, __global const float* b, __global float* c) {
+                __local float as[TILE][TILE], bs[TILE][TILE];
+                const int row = get_global_id(1), col = get_global_id(0);
+                const int lr = get_local_id(1), lc = get_local_id(0);
+                float sum = 0.0f;
+                for (int t = 0; t < n; t += TILE) {
+                    as[lr][lc] = a[row * n + t + lc];
+                    bs[lr][lc] = b[(t + lr) * n + col];
+                    barrier(CLK_LOCAL_MEM_FENCE);
+                    for (int k = 0; k < TILE; ++k) sum = fma(as[lr][k], bs[k][lc], sum);
+                    barrier(CLK_LOCAL_MEM_FENCE);
+                }
+                c[row * n + col] = sum;
+            }
+
+            __kernel void copy(__global const float4* from, __global float4* to) {
+                const size_t i = get_global_id(0);
+                to[i] = from[i];
+            }
+        )CL";
+
+        bool ok(cl_int status, const char* what, std::string& error) {
+            if (status == CL_SUCCESS) return true;
+            error = std::string(what) + " failed (OpenCL error " + std::to_string(status) + ")";
+            return false;
+        }
+
+        std::string deviceString(cl_device_id device, cl_device_info what) {
+            size_t size = 0;
+            if (clGetDeviceInfo(device, what, 0, nullptr, &size) != CL_SUCCESS || size == 0) return {};
+            std::string text(size, '\0');
+            clGetDeviceInfo(device, what, size, text.data(), nullptr);
+            while (!text.empty() && text.back() == '\0') text.pop_back();
+            return text;
+        }
+
+        std::string platformString(cl_platform_id platform, cl_platform_info what) {
+            size_t size = 0;
+            if (clGetPlatformInfo(platform, what, 0, nullptr, &size) != CL_SUCCESS || size == 0) return {};
+            std::string text(size, '\0');
+            clGetPlatformInfo(platform, what, size, text.data(), nullptr);
+            while (!text.empty() && text.back() == '\0') text.pop_back();
+            return text;
+        }
+
+        template <typename T>
+        T deviceValue(cl_device_id device, cl_device_info what) {
+            T value{};
+            clGetDeviceInfo(device, what, sizeof(value), &value, nullptr);
+            return value;
+        }
+
+        // Device time of a finished command, or from the start of `first` to the end of `last`
+        double seconds(cl_event first, cl_event last) {
+            cl_ulong start = 0, end = 0;
+            clGetEventProfilingInfo(first, CL_PROFILING_COMMAND_START, sizeof(start), &start, nullptr);
+            clGetEventProfilingInfo(last, CL_PROFILING_COMMAND_END, sizeof(end), &end, nullptr);
+            return end > start ? (end - start) / 1e9 : 0.0;
+        }
+
+        // Every event of a round, released however the round ends
+        struct Events {
+            cl_event written = nullptr, read = nullptr, modexp = nullptr, gemm = nullptr, copy = nullptr;
+            ~Events() {
+                for (cl_event event : {written, read, modexp, gemm, copy}) if (event) clReleaseEvent(event);
+            }
+        };
+    }
+
+    struct Stress::Impl {
+        Device device;
+        cl_context context = nullptr;
+        cl_command_queue compute = nullptr, transfer = nullptr;
+        cl_program program = nullptr;
+        cl_kernel modexp = nullptr, gemm = nullptr, copy = nullptr;
+        cl_mem modexpOut = nullptr, gemmA = nullptr, gemmB = nullptr, gemmC = nullptr;
+        cl_mem copyFrom = nullptr, copyTo = nullptr, transferDevice = nullptr, staging = nullptr;
+        void* stagingHost = nullptr;                // Pinned host side of the transfers (mapped `staging`)
+        size_t modexpItems = 0, tile = 16, copyBytes = 0, transferBytes = 0;
+        uint64_t nextIndex = 0;
+
+        ~Impl() {
+            if (stagingHost) {
+                clEnqueueUnmapMemObject(transfer, staging, stagingHost, 0, nullptr, nullptr);
+                clFinish(transfer);
+            }
+            for (cl_mem buffer : {modexpOut, gemmA, gemmB, gemmC, copyFrom, copyTo, transferDevice, staging}) {
+                if (buffer) clReleaseMemObject(buffer);
+            }
+            for (cl_kernel kernel : {modexp, gemm, copy}) if (kernel) clReleaseKernel(kernel);
+            if (program) clReleaseProgram(program);
+            for (cl_command_queue queue : {compute, transfer}) if (queue) clReleaseCommandQueue(queue);
+            if (context) clReleaseContext(context);
+        }
+
+        bool build(cl_device_id id, std::string& error) {
+            cl_int status = CL_SUCCESS;
+            const char* source = SOURCE;
+            program = clCreateProgramWithSource(context, 1, &source, nullptr, &status);
+            if (!ok(status, "clCreateProgramWithSource", error)) return false;
+            const std::string flags = "-DTILE=" + std::to_string(tile);
+            if (clBuildProgram(program, 1, &id, flags.c_str(), nullptr, nullptr) != CL_SUCCESS) {
+                size_t size = 0;
+                clGetProgramBuildInfo(program, id, CL_PROGRAM_BUILD_LOG, 0, nullptr, &size);
+                std::string log(size, '\0');
+                clGetProgramBuildInfo(program, id, CL_PROGRAM_BUILD_LOG, size, log.data(), nullptr);
+                error = "Kernel build failed: " + log.substr(0, log.find('\0'));
+                return false;
+            }
+            modexp = clCreateKernel(program, "modexp", &status);
+            if (!ok(status, "clCreateKernel(modexp)", error)) return false;
+            gemm = clCreateKernel(program, "gemm", &status);
+            if (!ok(status, "clCreateKernel(gemm)", error)) return false;
+            copy = clCreateKernel(program, "copy", &status);
+            return ok(status, "clCreateKernel(copy)", error);
+        }
+
+        bool allocate(std::string& error) {
+            cl_int status = CL_SUCCESS;
+            auto buffer = [&](cl_mem& target, cl_mem_flags flags, size_t bytes) {
+                target = clCreateBuffer(context, flags, bytes, nullptr, &status);
+                return ok(status, "clCreateBuffer", error);
+            };
+            const size_t matrix = GEMM_N * GEMM_N * sizeof(float);
+            if (!buffer(modexpOut, CL_MEM_WRITE_ONLY, MODEXP_MAX_ITEMS * sizeof(cl_ulong))
+                || !buffer(gemmA, CL_MEM_READ_ONLY, matrix) || !buffer(gemmB, CL_MEM_READ_ONLY, matrix)
+                || !buffer(gemmC, CL_MEM_WRITE_ONLY, matrix)
+                || !buffer(copyFrom, CL_MEM_READ_ONLY, copyBytes) || !buffer(copyTo, CL_MEM_WRITE_ONLY, copyBytes)
+                || !buffer(transferDevice, CL_MEM_READ_WRITE, transferBytes)
+                || !buffer(staging, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, transferBytes)) {
+                return false;
+            }
+
+            // [O(N^2 + buffers)] Inputs written once; the kernels never read anything uninitialised
+            std::vector<float> values(GEMM_N * GEMM_N);
+            for (size_t i = 0; i < values.size(); ++i) values[i] = 1.0f / static_cast<float>(1 + i % 7);
+            const float zero = 0.0f;
+            if (!ok(clEnqueueWriteBuffer(compute, gemmA, CL_TRUE, 0, matrix, values.data(), 0, nullptr, nullptr), "Writing A", error)
+                || !ok(clEnqueueWriteBuffer(compute, gemmB, CL_TRUE, 0, matrix, values.data(), 0, nullptr, nullptr), "Writing B", error)
+                || !ok(clEnqueueFillBuffer(compute, copyFrom, &zero, sizeof(zero), 0, copyBytes, 0, nullptr, nullptr),
+                       "clEnqueueFillBuffer", error)) {
+                return false;
+            }
+            stagingHost = clEnqueueMapBuffer(transfer, staging, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, transferBytes,
+                                             0, nullptr, nullptr, &status);
+            if (!ok(status, "clEnqueueMapBuffer", error)) return false;
+            std::memset(stagingHost, 0x5A, transferBytes);
+            return ok(clFinish(compute), "clFinish", error);
+        }
+    };
+
+    Stress::Stress() = default;
+    Stress::~Stress() = default;
+
+    const Device& Stress::device() const {
+        static const Device none;
+        return impl ? impl->device : none;
+    }
+
+    bool Stress::open(unsigned index, std::string& error) {
+        cl_uint platformCount = 0;
+        if (clGetPlatformIDs(0, nullptr, &platformCount) != CL_SUCCESS || platformCount == 0) {
+            error = "No OpenCL platform (is a GPU driver / ICD installed?)";
+            return false;
+        }
+        std::vector<cl_platform_id> platforms(platformCount);
+        clGetPlatformIDs(platformCount, platforms.data(), nullptr);
+
+        // [O(devices)] GPUs first, then CPUs and accelerators, so --gpu-device=0 is a GPU when there is one
+        std::vector<std::pair<cl_platform_id, cl_device_id>> gpus, others;
+        for (cl_platform_id platform : platforms) {
+            cl_uint count = 0;
+            if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 0, nullptr, &count) != CL_SUCCESS || count == 0) continue;
+            std::vector<cl_device_id> ids(count);
+            clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, count, ids.data(), nullptr);
+            for (cl_device_id id : ids) {
+                (deviceValue<cl_device_type>(id, CL_DEVICE_TYPE) & CL_DEVICE_TYPE_GPU ? gpus : others).emplace_back(platform, id);
+            }
+        }
+        gpus.insert(gpus.end(), others.begin(), others.end());
+        if (index >= gpus.size()) {
+            error = "OpenCL device " + std::to_string(index) + " does not exist (" + std::to_string(gpus.size()) + " found)";
+            return false;
+        }
+        const auto [platform, id] = gpus[index];
+
+        impl = std::make_unique<Impl>();
+        Impl& state = *impl;
+        state.device.name = deviceString(id, CL_DEVICE_NAME);
+        state.device.version = deviceString(id, CL_DEVICE_VERSION);
+        state.device.platform = platformString(platform, CL_PLATFORM_NAME);
+        state.device.memoryBytes = deviceValue<cl_ulong>(id, CL_DEVICE_GLOBAL_MEM_SIZE);
+        state.device.computeUnits = deviceValue<cl_uint>(id, CL_DEVICE_MAX_COMPUTE_UNITS);
+        const cl_ulong maxAlloc = deviceValue<cl_ulong>(id, CL_DEVICE_MAX_MEM_ALLOC_SIZE);
+        state.tile = deviceValue<size_t>(id, CL_DEVICE_MAX_WORK_GROUP_SIZE) >= 256 ? 16 : 8;
+        state.copyBytes = std::min<size_t>(std::clamp<size_t>(state.device.memoryBytes / 8, COPY_MIN, COPY_MAX), maxAlloc) / 16 * 16;
+        state.transferBytes = std::min<size_t>(TRANSFER_BYTES, maxAlloc);
+        state.modexpItems = std::clamp<size_t>(size_t(state.device.computeUnits) * 64, 64, MODEXP_MAX_ITEMS);
+        if (state.copyBytes == 0) {
+            error = "OpenCL device " + state.device.name + " reports no usable memory";
+            return false;
+        }
+
+        cl_int status = CL_SUCCESS;
+        const cl_context_properties properties[] = {CL_CONTEXT_PLATFORM, reinterpret_cast<cl_context_properties>(platform), 0};
+        state.context = clCreateContext(properties, 1, &id, nullptr, nullptr, &status);
+        if (!ok(status, "clCreateContext", error)) return false;
+        // Two in-order queues: transfers run on their own while the compute queue runs kernels
+        for (cl_command_queue* queue : {&state.compute, &state.transfer}) {
+            *queue = clCreateCommandQueue(state.context, id, CL_QUEUE_PROFILING_ENABLE, &status);
+            if (!ok(status, "clCreateCommandQueue", error)) return false;
+        }
+        return state.build(id, error) && state.allocate(error);
+    }
+
+    bool Stress::round(Round& done, std::string& error) {
+        if (!impl) {
+            error = "No OpenCL device open";
+            return false;
+        }
+        Impl& state = *impl;
+        Events events;
+        const auto start = std::chrono::steady_clock::now();
+
+        // Host -> device -> host through the pinned buffer, queued first so it overlaps every kernel
+        const cl_int written = clEnqueueWriteBuffer(state.transfer, state.transferDevice, CL_FALSE, 0, state.transferBytes,
+                                                    state.stagingHost, 0, nullptr, &events.written);
+        if (!ok(written, "Host-to-device transfer", error)
+            || !ok(clEnqueueReadBuffer(state.transfer, state.transferDevice, CL_FALSE, 0, state.transferBytes,
+                                       state.stagingHost, 0, nullptr, &events.read), "Device-to-host transfer", error)
+            || !ok(clFlush(state.transfer), "clFlush", error)) {
+            return false;
+        }
+
+        const cl_ulong first = state.nextIndex;
+        const cl_int n = static_cast<cl_int>(GEMM_N);
+        const size_t modexpItems = state.modexpItems;
+        const size_t gemmGlobal[2] = {GEMM_N, GEMM_N}, gemmLocal[2] = {state.tile, state.tile};
+        const size_t copyItems = state.copyBytes / 16;
+        cl_ulong firstResult = 0;
+        if (!ok(clSetKernelArg(state.modexp, 0, sizeof(first), &first), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.modexp, 1, sizeof(cl_mem), &state.modexpOut), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.gemm, 0, sizeof(n), &n), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.gemm, 1, sizeof(cl_mem), &state.gemmA), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.gemm, 2, sizeof(cl_mem), &state.gemmB), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.gemm, 3, sizeof(cl_mem), &state.gemmC), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.copy, 0, sizeof(cl_mem), &state.copyFrom), "clSetKernelArg", error)
+            || !ok(clSetKernelArg(state.copy, 1, sizeof(cl_mem), &state.copyTo), "clSetKernelArg", error)
+            || !ok(clEnqueueNDRangeKernel(state.compute, state.modexp, 1, nullptr, &modexpItems, nullptr, 0, nullptr,
+                                          &events.modexp), "modexp launch", error)
+            || !ok(clEnqueueNDRangeKernel(state.compute, state.gemm, 2, nullptr, gemmGlobal, gemmLocal, 0, nullptr,
+                                          &events.gemm), "GEMM launch", error)
+            || !ok(clEnqueueNDRangeKernel(state.compute, state.copy, 1, nullptr, &copyItems, nullptr, 0, nullptr,
+                                          &events.copy), "copy launch", error)
+            || !ok(clEnqueueReadBuffer(state.compute, state.modexpOut, CL_TRUE, 0, sizeof(firstResult), &firstResult,
+                                       0, nullptr, nullptr), "Reading the modexp result", error)
+            || !ok(clWaitForEvents(1, &events.read), "Waiting for the transfers", error)) {
+            return false;
+        }
+
+        done = Round{};
+        done.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        done.modexpOps = modexpItems;
+        done.modexpFirst = first;
+        done.modexpFirstResult = firstResult;
+        done.gemmFlops = 2.0 * GEMM_N * GEMM_N * GEMM_N;
+        done.deviceBytes = 2 * uint64_t(state.copyBytes);
+        done.transferBytes = 2 * uint64_t(state.transferBytes);
+        done.modexpSeconds = seconds(events.modexp, events.modexp);
+        done.gemmSeconds = seconds(events.gemm, events.gemm);
+        done.copySeconds = seconds(events.copy, events.copy);
+        done.transferSeconds = seconds(events.written, events.read);
+
+        // Keep a modexp launch around 100 ms: long enough to fill the device, short enough to stop promptly
+        state.nextIndex += modexpItems;
+        if (done.modexpSeconds < MODEXP_MIN_SECONDS && state.modexpItems < MODEXP_MAX_ITEMS) {
+            state.modexpItems = std::min(state.modexpItems * 2, MODEXP_MAX_ITEMS);
+        } else if (done.modexpSeconds > MODEXP_MAX_SECONDS && state.modexpItems > 64) {
+            state.modexpItems /= 2;
+        }
+        return true;
+    }
+}
@@ -5,7 +5,40 @@
 #include <atomic>       //! Provides std::atomic, enabling thread-safe access to shared counters and flags.
 #include <memory>       //! Provides std::unique_ptr, used for managing dynamically allocated memory.
 #include <cassert>      //! Provides assert(), used for runtime checks like ensuring system capabilities.
+#include <cstdlib>      //? Provides std::atoi, used for parsing numeric command-line values.
 #include <iostream>     //? Provides input/output functionality, used for displaying progress and results.
+#include <string>       //? Provides std::string, used for building option values and progress bars.
+#include <string_view>  //? Provides std::string_view, used for parsing command-line flags without copying.
+#include <algorithm>    //? Provides std::sort/std::unique/std::clamp, used for CPU sets and the load controller.
+#include <cmath>        //! Provides std::ceil, used for interval counts in the stability report.
+#include <latch>        //! Provides std::latch, used to start the cache-stress phases once every set is touched.
+
+#include "Config.hpp"       //* StressOptions and the command-line / config-file front end.
+#include "Workloads.hpp" //* CPU workload kernels and their registry.
+#include "WorkStealingPool.hpp" //* Per-worker task deques, stealing, and the active-worker limit.
+#include "Topology.hpp"     //* CPU/NUMA topology discovery, pinning and placement modes.
+#include "Arena.hpp"        //* Chunked mmap bump allocator backing the memory stress test.
+#include "MemoryFill.hpp"   //* Non-temporal bulk fill used by the parallel first-touch mode.
+#include "MemoryBench.hpp"  //* STREAM kernels and pointer-chase latency over the allocated blocks.
+#include "Telemetry.hpp"    //* Per-thread sample rings, the collector thread and its file writers.
+#include "CpuLoad.hpp"      //* Per-core utilisation from /proc/stat (GetSystemTimes on Windows).
+#include "PerfCounters.hpp" //* Per-worker hardware counters read with rdpmc (perf_event_open).
+#include "Sensors.hpp"      //* Clock, temperature, throttling and RAPL power polling thread.
+#include "TimeSeries.hpp"   //* Preallocated per-interval throughput matrix and its statistics.
+#include "Histogram.hpp"    //* Per-thread log-linear latency histograms for sampled kernel calls.
+#include "Storage.hpp"      //* Scratch file, O_DIRECT setup and raw-syscall io_uring for the storage test.
+#include "Async.hpp"        //* Coroutine executor on io_uring (--io-engine=coro).
+#include "Network.hpp"      //* Sockets, MSG_ZEROCOPY completions, mmsg batches and softirq counters.
+#include "Fleet.hpp"        //* Coordinator/agent handshake, common start time and binary telemetry frames.
+#include "MemoryVerify.hpp" //* Pattern write/verify loops for --mem-mode=verify.
+#include "CacheStress.hpp"  //* Cache-level working sets and read-modify-write laps for --cache-stress.
+#include "CoreLatency.hpp"  //* Core-to-core cache-line ping-pong matrix for --core-latency.
+#include "Profile.hpp"      //* Load-profile steps, square waves and the memory-side control word.
+#include "MemoryPressure.hpp" //* MemAvailable / cgroup limits, PSI and reclaim counters for --mem-mode=pressure.
+#include "Bench.hpp"        //* Outlier rejection, score files and baseline comparison for --bench.
+#include "Exporter.hpp"     //* Prometheus / OpenMetrics endpoint serving the collector's latest tick.
+#include "PageCache.hpp"    //* Shared sparse-file mapping, eviction and Dirty/Writeback state for --mem-mode=file.
+#include "Gpu.hpp"          //* Optional OpenCL backend (its own CMake target) for the --gpu load.
 
 /*
  * Platform-specific console initialization
@@ -52,183 +85,393 @@ namespace ConsoleColors {
 }
 
 
-    // Template class for a LinkedList
-    template <typename T>
-    class LinkedList {
-    private:
-    // Internal structure representing a node in the LinkedList
-    struct Node {
-        T data;       // Data stored in the node
-        Node *next;   // Pointer to the next node
-
-        // Constructor to initialize a node with given data (move semantics used for efficiency)
-        explicit Node(T &&data) : data(std::move(data)), next(nullptr) {}
-    };
-
-    Node *head;     // Pointer to the first node in the LinkedList
-    Node *tail;     // Pointer to the last node in the LinkedList
-    size_t size;    // Tracks the number of nodes in the LinkedList
-
-    public:
-    // Constructor: Initializes an empty LinkedList
-    LinkedList() : head(nullptr), tail(nullptr), size(0) {}
-
-    // Destructor: Clean up resources (not implemented here, relying on T to manage its own memory)
-    ~LinkedList() {}
-
-    // Adds a new element to the end of the LinkedList using move semantics
-    void push_back(T &&value) {
-        Node *newNode = new Node(std::move(value)); // Create a new node with the given value
-        if (!head) { // If the list is empty, initialize both head and tail to the new node
-        head = tail = newNode;
-        } else { // Otherwise, append the new node to the end of the list
-        tail->next = newNode;
-        tail = newNode;
-        }
-        ++size; // Increment the size of the list
-    }
-
-    // Returns the current size of the LinkedList
-    size_t getSize() const { return size; }
-    };
+/*
+ * Per-worker hash counter padded to its own cache line.
+ * Each worker is the only writer of its slot, so the hot path is a relaxed
+ * load + store instead of a locked RMW, and no two workers ever share a line.
+ */
+struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+};
 
+// One worker's latest hardware counter readings, on their own cache line(s)
+struct alignas(64) PerfSlot {
+    std::atomic<uint64_t> value[Perf::EVENT_COUNT] = {};
+};
 
 class SystemStressTest {
 private:
-    static constexpr int BAR_WIDTH = 30;                        // Progress bar width for time and memory displays
-    static constexpr int MULTIPLIER = 15;                        // Memory multiplier for stress test
-    static constexpr int TEST_DURATION = 30;                    // seconds
-    static constexpr size_t TARGET_MEMORY = 1024 * 1024 * 1024; //? 1 GB Scaling bytes -> Mega -> Giga
+    //? Duration, memory target, bar width and batch size come from StressOptions (see Config.hpp)
+    static constexpr size_t blockSize = 1024 * 1024;            // Memory test block size of 1 MB
 
     // Shared atomic variables to track system metrics
     std::atomic<bool> running{true};             // Flag to indicate if the test is running
     std::atomic<size_t> memoryAllocated{0};     // Memory allocated in bytes
-    std::atomic<uint64_t> hashOps{0};          // Total Hashing operations
+    std::atomic<uint64_t> hashOps{0};          // Total Hashing operations (--shared-counter mode only)
+    std::vector<PaddedCounter> threadCounters; // Per-worker hashing operations (default mode)
 
+    StressOptions options;
     std::mutex consoleMutex;
     std::vector<std::thread> cpuThreads;
-    int numCores;
-
-    // Helper to get current system CPU load (simplified version)
-    float getCurrentSystemLoad() {
-        //! This is a placeholder implementation
-        //? In a real implementation, you would:
-        //> 1. Sample CPU usage over a short period
-        //> 2. Compare previous and current measurements
-        //> 3. Return a value between 0.0 and 1.0
-
-        // For now, return a value based on hash operations rate
-        static uint64_t lastOps = 0;
-        static auto lastCheck = std::chrono::steady_clock::now();
-        auto currentTime = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastCheck).count();
-
-        if (duration == 0) return 0.5f;
-        uint64_t currentOps = hashOps.load(std::memory_order_relaxed);
-        float opsRate = static_cast<float>(currentOps - lastOps) / duration;
+    std::unique_ptr<WorkStealing::Pool> pool;   // Task deques shared by all CPU workers
+    unsigned numCores = 0;
+    std::vector<Topology::Cpu> cpus;            // Logical CPUs this process may use
+    std::vector<unsigned> workerCpus;           // Logical CPU for each worker (pinned unless affinity is none)
+    std::atomic<unsigned> pinFailures{0};       // Workers that could not be pinned or bound to their node
+
+    Memory::Arena arena;                        // Owns every memory-test block until the end of run()
+    double allocationSeconds = 0.0;             // Time the memory thread spent allocating + filling (set before join)
+    bool memoryReady = false;                   // --prefault: the blocks were faulted in before the clock started
+    double setupSeconds = 0.0;                  // Prompt to clock start: discovery, prepare*(), --prefault
+    double teardownSeconds = 0.0, unmapSeconds = 0.0; // Clock stop to results: joins, flushes, arena release
+
+    // Bandwidth mode (--mem-mode=bandwidth)
+    static constexpr int LATENCY_LEVELS = 4;                 // L1d, L2, LLC, DRAM working sets
+    static constexpr const char* LATENCY_NAMES[LATENCY_LEVELS] = {"L1", "L2", "LLC", "DRAM"};
+    Memory::Arena chaseArena{64 * blockSize};                // Latency working sets, separate from the blocks
+    char* chaseRegions[LATENCY_LEVELS] = {};                 // One linked chase per working set
+    std::atomic<double> latencyNs[LATENCY_LEVELS] = {};      // Latest ns/access per working set (0 = not measured)
+    std::mutex streamResultsMutex;                           // Guards the per-kernel totals below (thread exit only)
+    double streamRates[4] = {};                              // Sum over threads of each kernel's GB/s
+    std::chrono::steady_clock::time_point bandwidthStart;    // When the STREAM threads started
+    std::vector<unsigned> streamSources;                     // Telemetry source id per STREAM thread
+
+    // Verify mode (--mem-mode=verify)
+    std::vector<unsigned> verifySources;                     // Telemetry source id per verify thread
+    std::vector<std::unique_ptr<MemoryVerify::Results>> verifyResults; // Per verify thread (read after join)
+    std::atomic<uint64_t> verifyPasses{0}, verifyMismatches{0}; // For the console view
+    std::chrono::steady_clock::time_point verifyStart;
+
+    // Cache stress (--cache-stress)
+    Memory::Arena cacheArena{64 * blockSize};                // Cache-level working sets, separate from the blocks
+    Topology::CacheSizes cacheSizes;                         // Detected by prepareCache()
+    unsigned cacheShare = 1;                                 // Cache threads competing for one LLC instance
+    std::vector<CacheStress::Region> cacheRegions;           // LEVEL_COUNT per thread, touched only by that thread
+    std::vector<unsigned> cacheSources;                      // Telemetry source id per cache thread
+    std::vector<std::unique_ptr<CacheStress::Results>> cacheResults; // Per cache thread (read after join)
+    std::atomic<uint64_t> cacheErrors{0};                    // For the console view
+    std::chrono::steady_clock::time_point cacheStart;        // Phase 0 begins here, once every set is initialised
+    std::atomic<bool> cacheReady{false};                     // cacheStart is set (the console view may read it)
+
+    // Core-to-core latency (--core-latency)
+    std::vector<unsigned> latencyCpus;                       // CPUs of the matrix (available ones only)
+    std::vector<double> idleLatency, loadedLatency;          // One-way ns, row-major (see CoreLatency::matrix)
+    std::atomic<size_t> idlePairs{0}, loadedPairs{0};        // Pairs measured so far
+
+    // Load profile (--profile): the scheduler thread publishes each edge
+    std::atomic<uint64_t> loadWord{Profile::MEMORY_ON};      // Memory-side control word (see Profile.hpp)
+    double profileLatenessMs = 0.0;                          // Worst delay publishing an edge (read after join)
+
+    // Pressure mode (--mem-mode=pressure): sampled by the memory thread, read by the console view
+    struct PressureSnapshot {
+        MemoryPressure::VmCounters vm;
+        MemoryPressure::Psi psi;
+        uint64_t ownMajorFaults = 0;
+        std::chrono::steady_clock::time_point at;
+    };
+    MemoryPressure::Cgroup pressureCgroup;                   // Found by preparePressure()
+    uint64_t pressureBudget = 0;                             // Bytes the target is a fraction of
+    std::atomic<uint64_t> pressureAvailable{0}, pressureSwapUsed{0}; // Latest MemAvailable / swap in use
+    std::atomic<double> psiSome{0.0}, psiFull{0.0};          // Latest PSI avg10, %
+    std::atomic<double> majorFaultRate{0.0};                 // System-wide major faults/s, last second
+    std::atomic<unsigned> pressureSteps{0}, pressureBackoffs{0};
+    PressureSnapshot pressureBefore, pressureAfter;          // Around the pressure loop (read after join)
+    uint64_t pressureLowestAvailable = UINT64_MAX;           // Read after join
+    size_t pressurePeak = 0;                                 // Most bytes held at once (read after join)
+
+    // File-backed mode (--mem-mode=file): streamed by the memory thread, read after join unless atomic
+#ifdef __linux__
+    PageCache::Mapping fileMapping;                          // Created by prepareFileMapping()
+#endif
+    unsigned fileSource = 0;                                 // Telemetry source of the streaming thread
+    Histogram::LogLinear fileWriteLatency, fileSyncLatency;  // ns per window rewrite / per MS_SYNC flush
+    std::atomic<uint64_t> fileDirty{0}, fileWriteback{0};    // Latest Dirty / Writeback from /proc/meminfo
+    std::atomic<uint64_t> fileLastSyncNs{0}, fileLaps{0};
+    uint64_t filePeakDirty = 0, fileStreamBytes = 0, fileMajorFaults = 0, fileFailures = 0;
+    double fileFillSeconds = 0.0, fileStreamSeconds = 0.0;
+
+    // GPU load (--gpu): one host thread drives the device; the rates are the latest round's
+    Gpu::Stress gpu;
+    unsigned gpuSource = 0;                                  // Telemetry source of the modexp work items
+    std::atomic<double> gpuModexpRate{0.0}, gpuGflops{0.0}, gpuMemGbs{0.0}, gpuTransferGbs{0.0}, gpuOverlap{0.0};
+    Gpu::Round gpuTotals;                                    // Sum over every round (read after join)
+    uint64_t gpuRounds = 0, gpuMismatches = 0;               // Read after join
+    std::string gpuFailure;                                  // Why the GPU thread stopped early (read after join)
+
+    // Telemetry: workers and STREAM threads publish into their own rings, the collector aggregates
+    Telemetry::Collector telemetry;
+    std::vector<unsigned> workerSources;                     // Telemetry source id per worker
+    std::string displayFrame;                                // Console view buffer, reused every refresh
+    TimeSeries::Recorder throughput;                         // ops/s per worker per collector tick
+    std::vector<std::unique_ptr<Histogram::LogLinear>> callLatency; // Per worker, created by the worker (read after join)
+
+    // Measured utilisation (sampled by the monitoring loop) and the controller state built on it
+    std::unique_ptr<CpuLoad::Sampler> cpuLoad;
+    std::vector<unsigned> loadCpus;                          // CPUs the workers can run on (distinct ids)
+    std::atomic<double> workerUtilisation{0.0};              // Mean over loadCpus, last interval (0.0 - 1.0)
+    int loadCorrection = 0;                                  // Workers added/removed by the closed loop
+    int loadTargetPercent = -1;                              // Ramp step the correction belongs to
+
+    // Hardware counters (--perf), published by each worker once per task
+    std::vector<PerfSlot> perfTotals;
+    std::atomic<unsigned> perfWorkers{0};                    // Workers with at least one counter open
+    std::string perfFailure;                                 // Worker 0's open error (read after join)
+
+    std::unique_ptr<Sensors::Monitor> sensors;               // Polls clocks/thermals/power (--sensors)
+
+    // Storage test (--storage=DIR); each IoStats is written only by its submitting thread, read after join
+    struct IoStats {
+        uint64_t reads = 0, writes = 0, readBytes = 0, writeBytes = 0, errors = 0;
+        size_t peakInFlight = 0;                             // coro engine: most requests its executor had outstanding
+        Histogram::LogLinear readLatency, writeLatency;
+    };
+    Memory::Arena ioArena{16 * blockSize};                   // Request buffers (4 KB aligned for O_DIRECT)
+    Storage::File storageFile;
+    Storage::Engine storageEngine = Storage::Engine::Auto;   // Resolved engine (io_uring, threads or coro)
+    char* ioPrefillBuffer = nullptr;
+    char* ioBuffers = nullptr;                               // ioThreads x ioDepth x ioSize
+    std::vector<std::unique_ptr<IoStats>> ioStats;           // Per submitting thread
+    std::vector<unsigned> ioByteSources, ioOpSources;        // Telemetry source ids per submitting thread
+    double storagePrefillSeconds = 0.0, storageSeconds = 0.0;
+    std::string storageError;                                // Set by the storage thread (read after join)
+
+    // Network test (--net / --net-listen); each NetStats is written only by its flow thread, read after join
+    struct NetStats {
+        int fd = -1;                                         // TCP receivers in peer mode get theirs on accept
+        unsigned cpu = 0;                                    // Where the flow thread is pinned
+        char* buffer = nullptr;                              // Payload (senders) or receive space, from netArena
+        uint64_t bytes = 0, packets = 0, errors = 0;
+        Network::ZeroCopyCompletions zeroCopy;
+    };
+    Memory::Arena netArena{8 * blockSize};
+    std::vector<std::unique_ptr<NetStats>> netSenders, netReceivers;
+    std::vector<unsigned> netTxByteSources, netTxPacketSources, netRxByteSources, netRxPacketSources;
+    int netListener = -1;                                    // TCP listening socket (peer receivers)
+    bool netZeroCopy = false;                                // MSG_ZEROCOPY accepted on every sender
+    size_t netPayload = 0;                                   // Bytes per send / datagram
+    double netSeconds = 0.0;
+    uint64_t netSoftirqRx = 0, netSoftirqTx = 0;             // NET_RX / NET_TX raised during the run
+    bool netSoftirqsKnown = false;
+
+#ifdef __linux__
+    // Fleet agent (--agent): streams ticks to the coordinator, starts at the agreed moment
+    Fleet::AgentLink* fleet = nullptr;
+    int64_t fleetLatenessNs = 0;                             // How late this agent actually started
+
+    Exporter::Server metrics;                                // GET /metrics (--metrics-port)
+#endif
+
+    // Kernel assigned to a worker: the selected workloads are dealt out round-robin
+    const Workloads::WorkloadInfo* workloadFor(unsigned threadId) const {
+        return options.workloads[threadId % options.workloads.size()];
+    }
 
-        lastOps = currentOps;
-        lastCheck = currentTime;
+    // Sum of all hashing operations so far, regardless of the counter mode
+    uint64_t totalHashOps() const {
+        if (options.sharedCounter) return hashOps.load(std::memory_order_relaxed);
 
-        // Normalize the rate to a value between 0.0 and 1.0
-        return std::min(1.0f, std::max(0.0f, opsRate / 1000.0f));
+        uint64_t total = 0;
+        for (const auto& counter : threadCounters) { // [O(threads)] One cache line read per worker
+            total += counter.value.load(std::memory_order_relaxed);
+        }
+        return total;
     }
 
     // Display helper methods
-    void clearLine() const {
-        std::cout << "\r\033[K"; // Clear the current console line
-    }
-
     void moveCursor(int lines, bool up) const {
         std::cout << "\033[" << lines << (up ? 'A' : 'B'); // Move the cursor up or down
     }
 
-    void displayMemoryStatus() const {
-        // [O(1)] Calculate adjusted target memory based on the multiplier.
-        float adjustedTargetMemory = TARGET_MEMORY * MULTIPLIER;
+    // [O(options.barWidth)] Appends a bar of `pos` filled cells; one color escape per run, not per cell.
+    void appendBar(std::string& out, const char* label, const char* color, int pos) const {
+        pos = std::clamp(pos, 0, options.barWidth);
+        out += label;
+        out += "[";
+        out += color;
+        for (int i = 0; i < pos; ++i) out += "■";
+        out += ConsoleColors::RESET;
+        for (int i = pos; i < options.barWidth; ++i) out += "□";
+        out += "] ";
+    }
+
+    static void appendNumber(std::string& out, double value, int decimals) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        out += buffer;
+    }
+
+    void displayMemoryStatus(std::string& out) const {
+        // [O(1)] Target memory from the run options.
+        float adjustedTargetMemory = options.memoryTarget;
 
         // [O(1)] Calculate memory usage progress as a percentage (0.0 to 1.0).
         float progress = static_cast<float>(memoryAllocated) / adjustedTargetMemory;
 
-        // [O(1)] Calculate the number of filled positions in the progress bar.
-        int pos = static_cast<int>(BAR_WIDTH * progress);
+        // [O(options.barWidth)] Build the memory usage progress bar and memory usage details.
+        out += "\r\033[K"; // Clear the current console line
+        appendBar(out, "Memory: ", ConsoleColors::GREEN, static_cast<int>(options.barWidth * progress));
+        out += std::to_string(memoryAllocated / (1024 * 1024)) + "MB / " // Convert bytes to MB
+             + std::to_string(options.memoryTarget / (1024 * 1024)) + "MB";
+    }
 
-        // [O(BAR_WIDTH)] Build the memory usage progress bar.
-        std::string progressBar = "Memory: [";
-        for (int i = 0; i < BAR_WIDTH; ++i) { // Iterate over BAR_WIDTH positions
-            progressBar += (i < pos) ? // Add filled or empty bar segments
-                std::string(ConsoleColors::GREEN) + "■" + ConsoleColors::RESET :
-                "□";
-        }
+    void displayTimeProgress(std::string& out, int elapsedSeconds) const {
+        // Clamp elapsedSeconds to not exceed the test duration.
+        elapsedSeconds = std::min(elapsedSeconds, options.durationSeconds);
 
-        // [O(1)] Clear the current console line to prepare for new output.
-        clearLine();
+        // Calculate the progress as a fraction of the total test duration.
+        float progress = static_cast<float>(elapsedSeconds) / options.durationSeconds;
 
-        // [O(1)] Display the memory progress bar and memory usage details.
-        std::cout << progressBar << "] "
-                  << memoryAllocated / (1024 * 1024) << "MB / " // Convert bytes to MB
-                  << adjustedTargetMemory / (1024 * 1024) << "MB" << std::flush;
+        // Append the progress bar, current elapsed time, and total test duration.
+        out += "\r\033[K"; // Clear the current console line
+        appendBar(out, "Time:   ", ConsoleColors::CYAN, static_cast<int>(options.barWidth * progress));
+        out += std::to_string(elapsedSeconds) + "s / " + std::to_string(options.durationSeconds) + "s";
     }
 
-    void displayTimeProgress(int elapsedSeconds) const {
-        // Clamp elapsedSeconds to not exceed TEST_DURATION.
-        elapsedSeconds = std::min(elapsedSeconds, TEST_DURATION);
+    // Console view of the telemetry collector. Runs on the monitoring thread only; the frame is built
+    // in a reused buffer and written with one call, and nothing here is shared with the workers.
+    void updateDisplay(int elapsedSeconds) {
+        displayFrame.clear();
+
+        displayTimeProgress(displayFrame, elapsedSeconds);
+        displayFrame += '\n';
+        displayMemoryStatus(displayFrame);
+        displayFrame += '\n';
+
+        // [O(sources)] Totals and rates as of the collector's latest tick
+        displayFrame += "\r\033[KHASH OPS: " + std::to_string(telemetry.total(Telemetry::Metric::HashOps)) + " ops (";
+        appendNumber(displayFrame, telemetry.rate(Telemetry::Metric::HashOps), 0);
+        displayFrame += " ops/s) | Workers: " + std::to_string(pool->active()) + "/" + std::to_string(numCores);
+        if (!options.profile.empty()) {
+            displayFrame += " | Step " + std::to_string(Profile::stepOf(loadWord.load(std::memory_order_relaxed)) + 1)
+                          + "/" + std::to_string(options.profile.size());
+        }
+        if (perfWorkers.load(std::memory_order_relaxed) > 0) {
+            uint64_t cycles = 0, instructions = 0;
+            for (const auto& slot : perfTotals) { // [O(threads)]
+                cycles += slot.value[Perf::Cycles].load(std::memory_order_relaxed);
+                instructions += slot.value[Perf::Instructions].load(std::memory_order_relaxed);
+            }
+            displayFrame += " | IPC: ";
+            appendNumber(displayFrame, cycles ? static_cast<double>(instructions) / cycles : 0.0, 2);
+        }
+        if (cpuLoad->available()) {
+            double lowest = 1.0;
+            for (unsigned id : loadCpus) lowest = std::min(lowest, cpuLoad->core(id)); // [O(cores)]
+            displayFrame += " | CPU: ";
+            appendNumber(displayFrame, workerUtilisation.load(std::memory_order_relaxed) * 100.0, 0);
+            displayFrame += "% (min ";
+            appendNumber(displayFrame, lowest * 100.0, 0);
+            displayFrame += "%)";
+        }
+
+        if (options.gpu) {
+            displayFrame += '\n';
+            displayGpuStatus(displayFrame);
+        }
 
-        // Calculate the progress as a fraction of the total test duration.
-        float progress = static_cast<float>(elapsedSeconds) / TEST_DURATION;
+        if (options.memoryBandwidth) {
+            displayFrame += '\n';
+            displayBandwidthStatus(displayFrame);
+        }
 
-        // Map the progress fraction to a position on the progress bar.
-        int pos = static_cast<int>(BAR_WIDTH * progress);
+        if (options.memoryVerify) {
+            displayFrame += '\n';
+            displayVerifyStatus(displayFrame);
+        }
 
-        // Initialize the progress bar string with a label "Time:   [".
-        std::string progressBar = "Time:   [";
+        if (options.memoryPressure) {
+            displayFrame += '\n';
+            displayPressureStatus(displayFrame);
+        }
 
-        // Build the visual representation of the progress bar.
-        for (int i = 0; i < BAR_WIDTH; ++i) {
-            if (i < pos) {
-                // Add a filled segment (■) for positions less than `pos`.
-                progressBar += std::string(ConsoleColors::CYAN) + "■" + ConsoleColors::RESET;
-            } else {
-                // Add an empty segment (□) for positions greater than or equal to `pos`.
-                progressBar += "□";
-            }
+        if (options.memoryFile) {
+            displayFrame += '\n';
+            displayFileStatus(displayFrame);
         }
 
-        // Clear the current console line (to overwrite the previous progress bar).
-        clearLine();
+        if (options.cacheStress) {
+            displayFrame += '\n';
+            displayCacheStatus(displayFrame);
+        }
 
-        // Output the progress bar, current elapsed time, and total test duration.
-        std::cout << progressBar << "] "
-                << elapsedSeconds << "s / "
-                << TEST_DURATION << "s" << std::flush;
-    }
+        if (showSensors()) {
+            displayFrame += '\n';
+            displaySensorStatus(displayFrame);
+        }
 
+        if (!ioStats.empty()) {
+            displayFrame += '\n';
+            displayStorageStatus(displayFrame);
+        }
 
+        if (networkEnabled()) {
+            displayFrame += '\n';
+            displayNetworkStatus(displayFrame);
+        }
 
-    void updateDisplay(int elapsedSeconds) {
-        // [O(1)] Lock the console to prevent concurrent access by multiple threads.
-        std::lock_guard<std::mutex> lock(consoleMutex); // Prevent concurrent console access
+        // [O(1)] The console is shared with error messages from the memory thread
+        std::lock_guard<std::mutex> lock(consoleMutex);
+        std::cout.write(displayFrame.data(), static_cast<std::streamsize>(displayFrame.size()));
+        std::cout.flush();
+    }
 
-        // [O(1)] Clear the current console line to prepare for updated output.
-        clearLine();
+    // Number of lines updateDisplay() prints (the monitoring loop moves the cursor back over them)
+    int displayLines() const {
+        return 3 + (options.gpu ? 1 : 0) + (options.memoryBandwidth ? 1 : 0) + (options.memoryVerify ? 1 : 0) + (options.memoryPressure ? 1 : 0)
+             + (options.memoryFile ? 1 : 0) + (options.cacheStress ? 1 : 0)
+             + (showSensors() ? 1 : 0) + (ioStats.empty() ? 0 : 1)
+             + (networkEnabled() ? 1 : 0);
+    }
 
-        // [O(1)] Display the elapsed time in seconds as part of the progress.
-        displayTimeProgress(elapsedSeconds);
+    bool networkEnabled() const {
+        return !netSenders.empty() || !netReceivers.empty();
+    }
 
-        // [O(1)] Output a newline to separate sections.
-        std::cout << std::endl;
+    bool showSensors() const {
+        return sensors && sensors->anyAvailable();
+    }
 
-        // [O(1)] Display current memory usage status.
-        displayMemoryStatus();
+    void displaySensorStatus(std::string& out) const {
+        out += "\r\033[KSENSORS:";
+        if (sensors->hasClock()) {
+            out += " ";
+            appendNumber(out, sensors->meanMhz(), 0);
+            out += " MHz (";
+            appendNumber(out, sensors->lowMhz(), 0);
+            out += "-";
+            appendNumber(out, sensors->highMhz(), 0);
+            out += ")";
+        }
+        if (sensors->hasTemperature()) {
+            out += " | ";
+            appendNumber(out, sensors->packageCelsius(), 1);
+            out += " C";
+        }
+        if (sensors->hasPower()) {
+            out += " | ";
+            appendNumber(out, sensors->packageWatts(), 1);
+            out += " W pkg + ";
+            appendNumber(out, sensors->dramWatts(), 1);
+            out += " W dram";
+        }
+        if (sensors->hasThrottle()) out += " | throttle events: " + std::to_string(sensors->throttleEventCount());
+    }
 
-        // [O(1)] Output a newline for separation.
-        std::cout << std::endl;
+    uint64_t totalBandwidthBytes() const {
+        return telemetry.total(Telemetry::Metric::StreamBytes);
+    }
 
-        // [O(1)] Display the total number of hash operations performed.
-        // `hashOps.load()` is a single atomic operation, which is O(1).
-        std::cout << "HASH OPS: "
-                  << hashOps.load(std::memory_order_relaxed) // Fetch current hash operations count atomically
-                  << " ops" << std::flush;
+    void displayBandwidthStatus(std::string& out) const {
+        out += "\r\033[KMEM BW: ";
+        appendNumber(out, telemetry.rate(Telemetry::Metric::StreamBytes) / 1e9, 2);
+        out += " GB/s | Latency:";
+        for (int level = 0; level < LATENCY_LEVELS; ++level) {
+            double ns = latencyNs[level].load(std::memory_order_relaxed);
+            out += " ";
+            out += LATENCY_NAMES[level];
+            out += " ";
+            if (ns > 0.0) { appendNumber(out, ns, 1); out += "ns"; } else out += "-";
+        }
     }
 
 
@@ -249,11 +492,23 @@ private:
     //            |
     //            v
     // +---------------------------------------+
-    // | Process BATCH_SIZE Hash Operations:   |
+    // | Park while above the active limit     |
+    // +---------------------------------------+
+    //            |
+    //            v
+    // +---------------------------------------+
+    // | Acquire a task of batchSize ops:      |
+    // | own deque -> steal -> global refill   |
+    // +---------------------------------------+
+    //            |
+    //            v
+    // +---------------------------------------+
+    // | Process the task's hash operations:   |
     // | - Generate pseudo-random inputs       |
     // | - Compute hash value                  |
     // | - Increment operation counters        |
     // | - Update shared counter periodically  |
+    // | - Hand the rest back if deactivated   |
     // +---------------------------------------+
     //            |
     //            v
@@ -275,76 +530,114 @@ private:
     // ============================================================================================
 
 
-    // Function to simulate a compute-intensive CPU stress test using a custom hash-like operation.
+    // Function to simulate a compute-intensive CPU stress test using the selected workload kernel.
     // [O(1)] This function is designed to run on a specific thread and perform a large number of operations
-    // [O(1)] involving modular exponentiation and nested computation to simulate high CPU load.
+    // [O(1)] with the kernel assigned to it (by default the nested modular exponentiation hash).
 
-    void cpuHashStressTest(int threadId) {
-        constexpr int BATCH_SIZE = 4500; // [O(1)] Total number of hash operations in a batch.
+    void cpuHashStressTest(unsigned threadId) {
         constexpr int CHUNK_SIZE = 1;       // [O(1)] Number of operations after which shared counter is updated.
 
+        //! 1. PLACEMENT AND KERNEL SELECTION
+        // Pin first and prefer the local node, so the kernel's working set is first-touched on this worker's node.
+        if (options.affinity != Topology::Affinity::None) {
+            const Topology::Cpu* cpu = Topology::find(cpus, workerCpus[threadId]);
+            bool placed = Topology::pinCurrentThread(workerCpus[threadId]);
+            if (Topology::nodeCount(cpus) > 1) placed = Topology::preferNode(cpu->node) && placed;
+            if (!placed) pinFailures.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        //! 1. MODULAR EXPONENTIATION: CORE OF PUBLIC-KEY CRYPTOGRAPHY
-        // Define a compute-intensive hash-like function that uses nested modular exponentiation.
-        // [O(exponent)] Time complexity depends on the value of 'exponent' due to the nested loop.
-        auto computeIntensiveHash = [](  uint64_t  base,  uint64_t exponent,  uint64_t mod) -> uint64_t {
-            uint64_t result = 1;       // [O(1)] Result of modular exponentiation
-            uint64_t nestedFactor = 1; // [O(1)] Additional factor to amplify computation complexity
-
-            for (uint64_t i = 0; i < exponent; ++i) { // [O(exponent)] Outer loop runs 'exponent' times
-                result = (result * base) % mod;                 // [O(1)] Base modular exponentiation
-                nestedFactor = (nestedFactor * result) % mod;   // [O(1)] Nested computation step
-
-                for (uint64_t j = 0; j < exponent; ++j) {       // [O(exponent)] Inner loop runs 'exponent' times
-                    nestedFactor += i + j;                      // Add nestedFactor with the current iteration values.
-                    result *= nestedFactor;                     // Multiply result by nestedFactor
-                }
+        // Each worker owns its kernel instance, so any working set lives in this thread's memory.
+        std::unique_ptr<Workloads::Workload> workload = workloadFor(threadId)->create(threadId);
+        const uint64_t opsPerRun = workload->opsPerRun(); // [O(1)] Lane count for the multi-lane kernels
+
+        // Hardware counters for this thread only; read once per task (6 rdpmc), never per operation.
+        std::unique_ptr<Perf::ThreadCounters> counters;
+        if (options.perfCounters) {
+            counters = std::make_unique<Perf::ThreadCounters>();
+            if (counters->available()) perfWorkers.fetch_add(1, std::memory_order_relaxed);
+            if (threadId == 0) perfFailure = counters->openFailure();
+            if (!counters->available()) counters.reset();
+        }
+        // Call latency: every latencySample-th kernel call is timed into this worker's own histogram.
+        Histogram::LogLinear* latency = nullptr;
+        if (options.latencySample > 0) {
+            callLatency[threadId] = std::make_unique<Histogram::LogLinear>();
+            latency = callLatency[threadId].get();
+        }
+        unsigned untilTimed = 1; // [O(1)] Countdown, cheaper than a modulo per call
 
-                if (i % 10 == 0) { // [O(1)] Condition check occurs on every iteration
-                    result = (result + nestedFactor) % mod;     // [O(1)] Add nested result periodically
-                }
+        auto publishCounters = [&] {
+            uint64_t values[Perf::EVENT_COUNT];
+            counters->read(values);
+            for (int event = 0; event < Perf::EVENT_COUNT; ++event) {
+                perfTotals[threadId].value[event].store(values[event], std::memory_order_relaxed);
             }
-            return result; // [O(1)] Return the final computed value
         };
 
         uint64_t localHashOps = 0; // [O(1)] Local count of hash operations performed by this thread.
+        std::atomic<uint64_t>& ownCounter = threadCounters[threadId].value; // [O(1)] This worker's padded slot
+        Telemetry::Producer samples(telemetry, workerSources[threadId]);    // [O(1)] This worker's sample ring
+
+        // Publish to either the shared atomic or this worker's own cache line.
+        auto publish = [&](uint64_t ops) {
+            if (options.sharedCounter) {
+                hashOps.fetch_add(ops, std::memory_order_relaxed); // [O(1)] Contended atomic RMW
+            } else {
+                // Single writer: a plain relaxed store is enough, no lock prefix needed.
+                ownCounter.store(ownCounter.load(std::memory_order_relaxed) + ops, std::memory_order_relaxed);
+            }
+        };
 
-        // 3. PSEUDO-RANDOM INPUT
+        // 2. SCHEDULING
         // Main loop for stress testing
         while (running) { // [O(∞)] Runs indefinitely unless 'running' is set to false externally
-            volatile uint64_t hashValue = 0; // [O(1)] Temporary variable to store intermediate hash results.
-
-            // Perform a batch of hash operations.
-            for (int i = 0; i < BATCH_SIZE && running; ++i) { // [O(BATCH_SIZE)] Outer loop runs BATCH_SIZE times
-                // Generate pseudo-random input values for hashing.
-                volatile uint64_t randomBase = threadId * 123456789 + i * 987654321;  // [O(1)]
-                volatile uint64_t randomExponent = ((i % 2000) + 500) * (threadId % 10 + 1); // [O(1)]
-                volatile uint64_t randomModulus = 1e9 + 12347; // [O(1)]
+            pool->parkWhileInactive(threadId); // [O(1)] Returns at once while this worker is active
+            if (!running) break;
 
+            const WorkStealing::Task task = pool->acquire(threadId); // [O(workers)] Worst case: probe every victim
+            const uint64_t end = task.begin + task.count;
+            volatile uint64_t hashValue = 0; // [O(1)] Temporary variable to store intermediate hash results.
 
+            // 3. PSEUDO-RANDOM INPUT
+            // Perform the task's batch of hash operations.
+            uint64_t i = task.begin;
+            for (; i < end && running && pool->isActive(threadId); ++i) { // [O(batchSize)] Up to batchSize iterations
                 // 4. NESTED COMPUTATION AND HASHING
-                // Compute the hash-like value with the custom function.
-                hashValue = computeIntensiveHash(randomBase, randomExponent, randomModulus); // [O(randomExponent)]
+                // Run one operation of the selected kernel (inputs are derived from threadId and i).
+                if (latency && --untilTimed == 0) {
+                    untilTimed = options.latencySample;
+                    const uint64_t started = Telemetry::nowNs();
+                    hashValue = workload->runOnce(i); // [O(kernel)]
+                    latency->record(Telemetry::nowNs() - started); // [O(1)] Plain increment, no lock
+                } else {
+                    hashValue = workload->runOnce(i); // [O(kernel)]
+                }
 
                 // Additional operation to avoid compiler optimizations on hashValue.
                 if (hashValue % 1024 == 0) { // [O(1)] Condition check and operation
-                    hashValue = (hashValue + threadId) * (randomBase % 7); // [O(1)]
+                    hashValue = (hashValue + threadId) * (i % 7); // [O(1)]
                 }
 
-                ++localHashOps; // [O(1)] Increment local hash operation counter.
+                localHashOps += opsPerRun; // [O(1)] Increment local hash operation counter.
+                samples.add(opsPerRun);    // [O(1)] Telemetry: batched, wait-free push into this worker's own ring
 
                 // Update shared counter periodically to reduce contention.
-                if (localHashOps % CHUNK_SIZE == 0) { // [O(1)] Condition check every CHUNK_SIZE iterations
-                    hashOps.fetch_add(CHUNK_SIZE, std::memory_order_relaxed); // [O(1)] Atomic counter update
+                if (localHashOps >= CHUNK_SIZE) { // [O(1)] Condition check every CHUNK_SIZE operations
+                    publish(localHashOps); // [O(1)] Counter update
                     localHashOps = 0; // [O(1)] Reset local counter.
                 }
             }
 
+            // Scaled down mid-task: the unfinished range goes back to this worker's deque for thieves.
+            pool->yield(threadId, {i, static_cast<uint32_t>(end - i)});
+
             // Add any remaining operations in the local counter to the shared counter.
             if (localHashOps > 0) { // [O(1)] Condition check at the end of the batch
-                hashOps.fetch_add(localHashOps, std::memory_order_relaxed); // [O(1)] Atomic counter update
+                publish(localHashOps); // [O(1)] Counter update
                 localHashOps = 0; // [O(1)] Reset local counter.
             }
+            samples.flush(); // [O(1)] Published before parking (a value a full ring refused waits for the next flush)
+            if (counters) publishCounters(); // [O(events)] One batch of reads per task
         }
     }
 
@@ -353,41 +646,52 @@ private:
 
 makes something like this:
 
-+-------------------+     +-------------------+     +-------------------+
-| std::vector<int>  | --> | std::vector<int>  | --> | std::vector<int>  | --> NULL
-| {1, 1, 1, ...}    |     | {1, 1, 1, ...}    |     | {1, 1, 1, ...}    |
-+-------------------+     +-------------------+     +-------------------+
+Arena chunk list (one node per 256 MB chunk, not per block):
+
++-------------------------------------+     +-------------------------------------+
+| chunk 0: [1 MB][1 MB][1 MB] ... [ ] | --> | chunk 1: [1 MB][1 MB][  free     ]  | --> NULL
+|          {1, 1, 1, ...} per block   |     |          ^ bump pointer             |
++-------------------------------------+     +-------------------------------------+
 
 */
     // Function to stress test memory allocation
     void memoryStressTest() {
-        // Linked list to store memory blocks (using unique_ptr for automatic memory management)
-        LinkedList<std::unique_ptr<std::vector<int>>> memoryBlocks;
+        if (options.memoryPressure) {
+            memoryPressureTest();
+            return;
+        }
+        if (options.memoryFile) {
+            memoryFileTest();
+            return;
+        }
+        if (memoryReady) {
+            if (options.memoryBandwidth) memoryBandwidthTest();
+            if (options.memoryVerify) memoryVerifyTest();
+            return;
+        }
+        if (options.memoryBandwidth) prepareLatencyChase();
+
+        auto allocationStart = std::chrono::steady_clock::now();
+
+        if (options.parallelFill) {
+            parallelMemoryFill();
+            allocationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - allocationStart).count();
+            if (options.memoryBandwidth) memoryBandwidthTest();
+            if (options.memoryVerify) memoryVerifyTest();
+            return;
+        }
 
         try {
             // Loop to allocate memory until the target threshold is reached or the test is stopped
-            while (running && memoryAllocated < MULTIPLIER * TARGET_MEMORY) {
-                static constexpr size_t blockSize = 1024 * 1024; // Block size of 1 MB
-
-                // Create a unique pointer to a dynamically allocated vector of integers.
-                // The vector will simulate a block of memory for operations like memory testing or simulation.
-                auto block = std::make_unique<std::vector<int>>(
-                    blockSize / sizeof(int),  // The size of the vector is determined by dividing blockSize by sizeof(int).
-                                                // This calculates how many integers can fit into the given block size.
-                                                // Example: If blockSize is 1024 bytes and sizeof(int) is 4 bytes,
-                                                // the vector will have 1024 / 4 = 256 elements.
-
-                    1                // The initial value of each element in the vector.
-                                           // Here, all elements of the vector are initialized to the value 1.
-                                           // This ensures the block is filled with a known value, which may
-                                           // be useful for certain simulations or tests.
-                );
+            while (running && memoryAllocated < options.memoryTarget) {
+                // [O(1)] Carve the next block out of the current chunk: no per-block malloc or header.
+                int* block = static_cast<int*>(arena.allocate(blockSize));
+
+                // Fill every element with 1 so each page is actually touched (committed) now.
+                std::fill_n(block, blockSize / sizeof(int), 1);
 
                 // Update the total allocated memory counter
                 memoryAllocated += blockSize;
-
-                // Store the allocated block in the linked list to maintain ownership and prevent deallocation
-                memoryBlocks.push_back(std::move(block));
             }
         } catch (const std::bad_alloc &e) {
             // Handle memory allocation failure
@@ -397,162 +701,2682 @@ makes something like this:
                     << "Memory allocation failed: " << e.what()
                     << ConsoleColors::RESET << std::endl;
         }
+
+        // Blocks stay mapped until run() releases the arena, so the memory is held for the whole test.
+        allocationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - allocationStart).count();
+        if (options.memoryBandwidth) memoryBandwidthTest();
+        if (options.memoryVerify) memoryVerifyTest();
+    }
+
+    // CPUs for memory-side threads: where the workers are, or scattered across cores/nodes when unpinned
+    std::vector<unsigned> memoryThreadCpus() const {
+        return options.affinity != Topology::Affinity::None
+            ? workerCpus : Topology::placement(cpus, Topology::Affinity::Scatter, {});
+    }
+
+    // Pins a memory-side thread and makes its allocations prefer the CPU's node
+    void placeMemoryThread(unsigned cpu) const {
+        Topology::pinCurrentThread(cpu);
+        if (const Topology::Cpu* info = Topology::find(cpus, cpu); info && Topology::nodeCount(cpus) > 1) {
+            Topology::preferNode(info->node);
+        }
+    }
+
+    // [O(chunks)] Calls fn(base, bytes) for each contiguous piece of slice t (of `threads`) of the
+    // arena's blocks. Slices are block-granular and identical for every caller, so the thread that
+    // fills slice t and the thread that later streams over slice t touch the same pages.
+    template <typename Fn>
+    void forEachSlicePiece(unsigned t, unsigned threads, Fn&& fn) const {
+        size_t totalBlocks = 0;
+        arena.forEachChunk([&](char*, size_t used) { totalBlocks += used / blockSize; });
+
+        const size_t first = totalBlocks * t / threads, last = totalBlocks * (t + 1) / threads;
+        size_t chunkStart = 0;
+        arena.forEachChunk([&](char* base, size_t used) {
+            size_t chunkBlocks = used / blockSize;
+            size_t from = std::max(first, chunkStart), to = std::min(last, chunkStart + chunkBlocks);
+            if (from < to) fn(base + (from - chunkStart) * blockSize, (to - from) * blockSize);
+            chunkStart += chunkBlocks;
+        });
+    }
+
+    // [O(target / chunk)] Reserves the whole target as arena regions, one arena call per 256 MB;
+    // returns the bytes reserved (less than the target when the OS refuses a chunk)
+    size_t reserveMemory() {
+        size_t reservedBytes = 0;
+        const size_t target = options.memoryTarget;
+
+        try {
+            while (reservedBytes < target) {
+                size_t size = std::min<size_t>(256 * blockSize, target - reservedBytes);
+                arena.allocate(size, 4096);
+                reservedBytes += size;
+            }
+        } catch (const std::bad_alloc &e) {
+            std::lock_guard<std::mutex> lock(consoleMutex); // Ensure thread-safe console output
+            std::cout << "\n"
+                    << ConsoleColors::RED
+                    << "Memory reservation stopped at " << reservedBytes / (1024 * 1024) << "MB: " << e.what()
+                    << ConsoleColors::RESET << std::endl;
+        }
+        return reservedBytes;
     }
 
-        void manageThreadPool() {
-        while (running) {
-            float systemLoad = getCurrentSystemLoad();
-
-            std::lock_guard<std::mutex> lock(consoleMutex);
-
-            if (systemLoad > 0.75f && cpuThreads.size() < static_cast<size_t>(numCores)) {
-                // Add a new thread if load is high
-                cpuThreads.emplace_back(&SystemStressTest::cpuHashStressTest, this, cpuThreads.size());
-                std::cout << ConsoleColors::YELLOW 
-                         << "\nAdding thread due to high load (" 
-                         << systemLoad << ")" 
-                         << ConsoleColors::RESET << std::flush;
-            } 
-            else if (systemLoad < 0.25f && cpuThreads.size() > 1) {
-                // Remove a thread if load is low, but keep at least one
-                if (cpuThreads.back().joinable()) {
-                    cpuThreads.back().join();
+    // Parallel first-touch fill:
+    //   1. Reserve the whole target as arena regions (mapped, not yet touched).
+    //   2. Split the reserved blocks into one contiguous slice per fill thread.
+    //   3. Each thread pins itself, then faults in and fills only its own slice with
+    //      non-temporal stores, so every page is first touched on that thread's NUMA node.
+    void parallelMemoryFill() {
+        reserveMemory();
+
+        const std::vector<unsigned> fillCpus = memoryThreadCpus();
+        const unsigned threads = std::max(1u, options.fillThreads ? options.fillThreads : numCores);
+
+        auto fillSlice = [&](unsigned t) {
+            placeMemoryThread(fillCpus[t % fillCpus.size()]);
+            forEachSlicePiece(t, threads, [&](char* base, size_t bytes) {
+                for (size_t offset = 0; offset < bytes && running; offset += blockSize) { // [O(slice)]
+                    Memory::fillStreaming(reinterpret_cast<uint32_t*>(base + offset), blockSize / sizeof(uint32_t), 1);
+                    memoryAllocated += blockSize;
                 }
-                cpuThreads.pop_back();
-                std::cout << ConsoleColors::YELLOW 
-                         << "\nRemoving thread due to low load (" 
-                         << systemLoad << ")" 
-                         << ConsoleColors::RESET << std::flush;
-            }
+            });
+        };
+
+        std::vector<std::thread> fillers;
+        for (unsigned t = 0; t < threads; ++t) fillers.emplace_back(fillSlice, t);
+        for (auto& filler : fillers) filler.join();
+    }
 
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+    // --prefault, in run() before the clock starts: the whole target is mapped and faulted in up front,
+    // so the test measures a machine that is already holding its memory. Serial fill lets the kernel
+    // populate each chunk as it is mapped (no page fault per 4 KB store); --fill=parallel runs the
+    // parallel first-touch fill as usual, just before the clock instead of during the run.
+    void prefaultMemory() {
+        if (options.memoryBandwidth) prepareLatencyChase();
+
+        auto start = std::chrono::steady_clock::now();
+        if (options.parallelFill) {
+            parallelMemoryFill();
+        } else {
+            arena.setPopulate(true);
+            memoryAllocated += reserveMemory() / blockSize * blockSize;
+            arena.setPopulate(false);
         }
+        allocationSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        memoryReady = true;
     }
 
-public:
-    void run() {
-        // Initialize the console (platform-specific setup, e.g., enable colored output on Windows)
-        ConsoleInitializer::initialize();
+    // Maps and links the latency working sets before any block is allocated, so they always fit.
+    // They live in their own arena so they are never part of a STREAM slice.
+    void prepareLatencyChase() {
+        const Topology::CacheSizes caches = Topology::cacheSizes();
+        const size_t workingSets[LATENCY_LEVELS] = {
+            caches.l1d / 2, caches.l2 / 2, caches.llc / 2, std::max<size_t>(4 * caches.llc, 64 * blockSize)};
+        try {
+            for (int level = 0; level < LATENCY_LEVELS; ++level) {
+                chaseRegions[level] = static_cast<char*>(chaseArena.allocate(workingSets[level], 4096));
+                MemoryBench::buildChase(chaseRegions[level], workingSets[level], 0x9E3779B97F4A7C15ull + level);
+            }
+        } catch (const std::bad_alloc &) {
+            // Run STREAM only, skip the latency chase
+            for (auto& region : chaseRegions) region = nullptr;
+        }
+    }
 
-        // Display the start banner for the stress test
-        std::cout << ConsoleColors::MAGENTA
-                << "\n=== System Stress Test Starting ==="
-                << ConsoleColors::RESET << std::endl;
+    // Bandwidth mode: keeps the allocated blocks busy until the test stops.
+    //   - STREAM threads: each runs copy/scale/add/triad over its own slice (split into a, b, c).
+    //   - This thread: pointer-chase latency over L1d/L2/LLC/DRAM sized working sets, round robin.
+    void memoryBandwidthTest() {
+        const std::vector<unsigned> streamCpus = memoryThreadCpus();
+        const unsigned threads = static_cast<unsigned>(streamSources.size());
+
+        bandwidthStart = std::chrono::steady_clock::now();
+
+        auto streamSlice = [&](unsigned t) {
+            placeMemoryThread(streamCpus[t % streamCpus.size()]);
+
+            struct Arrays { double *a, *b, *c; size_t n; };
+            std::vector<Arrays> pieces;
+            forEachSlicePiece(t, threads, [&](char* base, size_t bytes) {
+                size_t n = bytes / 3 / sizeof(double) / 8 * 8; // Thirds, multiple of a cache line
+                auto* a = reinterpret_cast<double*>(base);
+                pieces.push_back({a, a + n, a + 2 * n, n});
+                MemoryBench::streamInit(a, a + n, a + 2 * n, n);
+            });
+
+            const unsigned source = streamSources[t];
+            double kernelBytes[4] = {}, kernelSeconds[4] = {};
+            uint64_t unpublished = 0; // Bytes a full ring refused, retried with the next pass
+            while (running && !pieces.empty()) {
+                // Profile steps without mem park the STREAM threads between passes
+                for (uint64_t word = loadWord.load(std::memory_order_acquire); running && !(word & Profile::MEMORY_ON);
+                     word = loadWord.load(std::memory_order_acquire)) {
+                    loadWord.wait(word, std::memory_order_acquire);
+                }
+                for (int k = 0; k < 4; ++k) {
+                    auto start = std::chrono::steady_clock::now();
+                    size_t moved = 0;
+                    for (const auto& p : pieces) { // [O(slice)] One full pass per kernel
+                        moved += MemoryBench::streamPass(MemoryBench::STREAM_KERNELS[k], p.a, p.b, p.c, p.n, MemoryBench::STREAM_SCALAR);
+                    }
+                    kernelSeconds[k] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    kernelBytes[k] += moved;
+                    unpublished += moved;
+                    if (telemetry.publish(source, unpublished)) unpublished = 0; // [O(1)] Wait-free; kept when the ring is full
+                    if (!running) break;
+                }
+            }
 
-        // Display a warning message about the test duration
-        std::cout << ConsoleColors::YELLOW
-                << "Warning: This program will stress your system for "
-                << TEST_DURATION << " seconds."
-                << ConsoleColors::RESET << std::endl;
+            if (unpublished > 0) telemetry.settle(source, unpublished); // Counted at the next tick
 
-        // Prompt the user to continue
-        std::cout << "Press Enter to continue...";
-        std::cin.get(); // Wait for user input
+            std::lock_guard<std::mutex> lock(streamResultsMutex); // Once per thread, after the measured loop
+            for (int k = 0; k < 4; ++k) {
+                if (kernelSeconds[k] > 0.0) streamRates[k] += kernelBytes[k] / kernelSeconds[k] / 1e9;
+            }
+        };
 
-        // Detect the number of CPU cores available on the system
-        const auto numCores = std::thread::hardware_concurrency();
-        assert(numCores > 0 && "Failed to detect CPU cores"); // Ensure the number of cores is valid
+        std::vector<std::thread> streamers;
+        for (unsigned t = 0; t < threads; ++t) streamers.emplace_back(streamSlice, t);
 
-        // Display the number of detected CPU cores
-        std::cout << ConsoleColors::BLUE << "\nDetected "
-                << numCores << " CPU cores"
-                << ConsoleColors::RESET << std::endl;
+        constexpr size_t CHASE_STEPS = 1 << 20; // [O(1)] Dependent loads per measurement
+        while (running && chaseRegions[LATENCY_LEVELS - 1]) {
+            for (int level = 0; level < LATENCY_LEVELS && running; ++level) {
+                latencyNs[level] = MemoryBench::chaseNanoseconds(chaseRegions[level], CHASE_STEPS);
+            }
+        }
 
-        // Inform the user that the stress test is starting
-        std::cout << "\nStarting stress test...\n\n" << std::flush;
+        for (auto& streamer : streamers) streamer.join();
+    }
 
-        // Record the starting time of the test
-        auto startTime = std::chrono::steady_clock::now();
+    // ============================================================================================
+    // MEMORY VERIFICATION (--mem-mode=verify)
+    // ============================================================================================
+    // Every verify thread owns one slice of the blocks (the same slices STREAM and the parallel
+    // fill use) and cycles through the selected patterns on it until the test stops:
+    //
+    //   walking     write 1<<k ............................ verify
+    //   inversions  write p ... verify p/write ~p (up) ... verify ~p/write p (down)
+    //   address     write addr ^ inv ...................... verify
+    //   random      write splitmix(seed, index) ........... verify
+    //
+    // A pass cut short by the end of the test is dropped before its verify phase, so an
+    // interrupted write is never reported as a mismatch.
 
-        // ===================================================================
-        // CPU STRESS TEST SETUP
-        // ===================================================================
-        // Launch a thread for each CPU core to perform the CPU stress test
-        std::vector<std::thread> cpuThreads;
-        for (unsigned int i = 0; i < numCores; ++i) {
-            cpuThreads.emplace_back(&SystemStressTest::cpuHashStressTest, this, i); // Launch CPU hashing threads
+    // Contiguous pieces of one thread's slice, as 64-bit words
+    struct VerifyPiece {
+        uint64_t* words;
+        size_t count;
+    };
+
+    // [O(slice)] Calls fn(words, count) per block in address order (or reversed); false once stopped
+    template <typename Fn>
+    bool forEachVerifyBlock(const std::vector<VerifyPiece>& pieces, bool descending, Fn&& fn) {
+        constexpr size_t BLOCK_WORDS = blockSize / sizeof(uint64_t);
+        for (size_t k = 0; k < pieces.size(); ++k) {
+            const VerifyPiece& piece = pieces[descending ? pieces.size() - 1 - k : k];
+            const size_t blocks = piece.count / BLOCK_WORDS;
+            for (size_t b = 0; b < blocks; ++b) {
+                if (!running.load(std::memory_order_relaxed)) return false;
+                fn(piece.words + (descending ? blocks - 1 - b : b) * BLOCK_WORDS, BLOCK_WORDS);
+            }
         }
+        return true;
+    }
 
-        // Launch a separate thread for memory stress testing
-        std::thread memThread(&SystemStressTest::memoryStressTest, this);
+    // One write + verify pass of `pattern`; false when the test stopped part-way
+    bool verifyPass(int pattern, uint64_t pass, const std::vector<VerifyPiece>& pieces,
+                    MemoryVerify::Results& results, Telemetry::Producer& progress) {
+        const uint64_t before = results.mismatches;
+        auto counted = [&](auto&& step) {
+            return [&, step](uint64_t* p, size_t n) mutable {
+                step(p, n);
+                results.bytes += n * sizeof(uint64_t);
+                progress.add(n * sizeof(uint64_t));
+            };
+        };
 
-        // ===================================================================
-        // MONITORING LOOP
-        // ===================================================================
-        int elapsedSeconds = 0;
-        while (elapsedSeconds <= TEST_DURATION) { // Run the loop until the test duration is reached
-            // Calculate the elapsed time since the start
-            auto elapsedTime = std::chrono::steady_clock::now() - startTime;
-            elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(elapsedTime).count();
+        bool complete = false;
+        switch (pattern) {
+            case MemoryVerify::WalkingOnes: {
+                const uint64_t bit = uint64_t(1) << (pass % 64);
+                complete = forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) { MemoryVerify::writeLinear(p, n, bit, 0, 0); })) &&
+                           forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) {
+                               MemoryVerify::verifyLinear(p, n, bit, 0, 0, results, pattern, pass); }));
+                break;
+            }
+            case MemoryVerify::MovingInversions: {
+                const uint64_t value = MemoryVerify::inversionPattern(pass);
+                complete = forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) { MemoryVerify::writeLinear(p, n, value, 0, 0); })) &&
+                           forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) {
+                               MemoryVerify::verifyWriteAscending(p, n, value, ~value, results, pattern, pass); })) &&
+                           forEachVerifyBlock(pieces, true, counted([&](uint64_t* p, size_t n) {
+                               MemoryVerify::verifyWriteDescending(p, n, ~value, value, results, pattern, pass); }));
+                break;
+            }
+            case MemoryVerify::AddressInAddress: {
+                const uint64_t invert = pass % 2 ? ~uint64_t(0) : 0;
+                complete = forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) {
+                               MemoryVerify::writeLinear(p, n, reinterpret_cast<uintptr_t>(p), sizeof(uint64_t), invert); })) &&
+                           forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) {
+                               MemoryVerify::verifyLinear(p, n, reinterpret_cast<uintptr_t>(p), sizeof(uint64_t), invert,
+                                                          results, pattern, pass); }));
+                break;
+            }
+            default: {
+                const uint64_t seed = MemoryVerify::splitmix64(options.verifySeed + pass);
+                auto index = [](const uint64_t* p) { return reinterpret_cast<uintptr_t>(p) / sizeof(uint64_t); };
+                complete = forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) { MemoryVerify::writeRandom(p, n, index(p), seed); })) &&
+                           forEachVerifyBlock(pieces, false, counted([&](uint64_t* p, size_t n) {
+                               MemoryVerify::verifyRandom(p, n, index(p), seed, results, pattern, pass); }));
+                break;
+            }
+        }
+        if (results.mismatches != before) verifyMismatches.fetch_add(results.mismatches - before, std::memory_order_relaxed);
+        return complete;
+    }
 
-            // Update the console display with the current progress
-            updateDisplay(elapsedSeconds);
+    void memoryVerifyTest() {
+        const std::vector<unsigned> verifyCpus = memoryThreadCpus();
+        const unsigned threads = static_cast<unsigned>(verifySources.size());
+        verifyStart = std::chrono::steady_clock::now();
+
+        auto verifySlice = [&](unsigned t) {
+            placeMemoryThread(verifyCpus[t % verifyCpus.size()]);
+            std::vector<VerifyPiece> pieces;
+            forEachSlicePiece(t, threads, [&](char* base, size_t bytes) {
+                pieces.push_back({reinterpret_cast<uint64_t*>(base), bytes / sizeof(uint64_t)});
+            });
+
+            MemoryVerify::Results& results = *verifyResults[t];
+            Telemetry::Producer progress(telemetry, verifySources[t]);
+            uint64_t passes[MemoryVerify::PATTERN_COUNT] = {};
+            while (running && !pieces.empty()) {
+                for (int pattern : options.verifyPatterns) {
+                    if (!verifyPass(pattern, passes[pattern]++, pieces, results, progress)) break;
+                    ++results.passes[pattern];
+                    verifyPasses.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            progress.flush();
+        };
 
-            // Sleep briefly to reduce the frequency of updates
-            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        std::vector<std::thread> verifiers;
+        for (unsigned t = 0; t < threads; ++t) verifiers.emplace_back(verifySlice, t);
+        for (auto& verifier : verifiers) verifier.join();
+    }
 
-            // Move the cursor up to overwrite the previous output in the console
-            moveCursor(2, true);
+    void displayVerifyStatus(std::string& out) const {
+        out += "\r\033[KVERIFY: ";
+        appendNumber(out, telemetry.rate(Telemetry::Metric::VerifyBytes) / 1e9, 2);
+        out += " GB/s | passes ";
+        out += std::to_string(verifyPasses.load(std::memory_order_relaxed));
+        const uint64_t errors = verifyMismatches.load(std::memory_order_relaxed);
+        out += " | ";
+        out += errors ? ConsoleColors::RED : ConsoleColors::GREEN;
+        out += std::to_string(errors);
+        out += " mismatches";
+        out += ConsoleColors::RESET;
+    }
+
+    // Passes per pattern and, for every mismatch kept, where it was and which bits flipped
+    void reportMemoryVerify(std::chrono::steady_clock::time_point endTime) const {
+        MemoryVerify::Results total;
+        std::vector<MemoryVerify::Mismatch> kept;
+        for (const auto& results : verifyResults) {
+            for (int p = 0; p < MemoryVerify::PATTERN_COUNT; ++p) total.passes[p] += results->passes[p];
+            for (int bit = 0; bit < 64; ++bit) total.bitFlips[bit] += results->bitFlips[bit];
+            total.bytes += results->bytes;
+            total.mismatches += results->mismatches;
+            kept.insert(kept.end(), results->kept, results->kept + results->keptCount);
         }
 
-        // Signal all threads to stop their work
-        running = false;
+        const double seconds = std::chrono::duration<double>(endTime - verifyStart).count();
+        std::cout << ConsoleColors::CYAN << "Memory verification: " << total.bytes / std::max(seconds, 1e-9) / 1e9
+                  << " GB/s written + checked (" << verifySources.size() << " threads, seed " << options.verifySeed
+                  << "), passes:";
+        for (int pattern : options.verifyPatterns) std::cout << " " << MemoryVerify::name(pattern) << "=" << total.passes[pattern];
+        std::cout << ConsoleColors::RESET << std::endl;
 
-        // ===================================================================
-        // THREAD CLEANUP
-        // ===================================================================
-        // Wait for all CPU threads to complete
-        for (auto& thread : cpuThreads) {
-            if (thread.joinable()) { // Ensure the thread is joinable before joining
-                thread.join();
-            }
+        if (total.mismatches == 0) {
+            std::cout << ConsoleColors::GREEN << "  No mismatches" << ConsoleColors::RESET << std::endl;
+            return;
         }
+        std::cout << ConsoleColors::RED << "  " << total.mismatches << " words read back wrong" << ConsoleColors::RESET << std::endl;
+        for (const auto& miss : kept) {
+            std::cout << ConsoleColors::RED << std::hex << "  0x" << miss.address;
+            if (miss.physical) std::cout << " (physical 0x" << miss.physical << ")";
+            std::cout << ": expected 0x" << miss.expected << ", read 0x" << miss.actual << std::dec << ", bits";
+            for (int bit = 0; bit < 64; ++bit) if (((miss.expected ^ miss.actual) >> bit) & 1) std::cout << " " << bit;
+            std::cout << " (" << MemoryVerify::name(miss.pattern) << " pass " << miss.pass << ")" << ConsoleColors::RESET << std::endl;
+        }
+        std::cout << ConsoleColors::RED << "  flips per bit:";
+        for (int bit = 0; bit < 64; ++bit) if (total.bitFlips[bit]) std::cout << " " << bit << "=" << total.bitFlips[bit];
+        std::cout << ConsoleColors::RESET << std::endl;
+    }
 
-        // Wait for the memory stress test thread to complete
-        if (memThread.joinable()) {
-            memThread.join();
+    // ============================================================================================
+    // MEMORY PRESSURE (--mem-mode=pressure)
+    // ============================================================================================
+    // Grows resident memory one step at a time to a share of what the machine (or the cgroup) had
+    // available at the start, then holds it there while the rest of the system lives with the
+    // shortage (see MemoryPressure.hpp):
+    //
+    //   every tick   sample MemAvailable, cgroup usage, PSI; re-touch TOUCH_PAGES held pages
+    //   headroom < 0 give the last step back now (madvise, the range stays mapped for reuse)
+    //   PSI full     give the last step back, at most once per dwell
+    //   otherwise    one more step per dwell while under the target and the step fits
+    //
+    // The step given back is always the newest, so the held steps are a prefix of `steps`.
+
+    // Reads the budget and turns --pressure-target into the memory target before any thread starts
+    bool preparePressure() {
+        const MemoryPressure::Meminfo info = MemoryPressure::meminfo();
+        if (!info.ok) {
+            std::cout << ConsoleColors::RED << "Pressure mode needs MemAvailable from /proc/meminfo (Linux)"
+                      << ConsoleColors::RESET << std::endl;
+            return false;
+        }
+        pressureCgroup = MemoryPressure::cgroup();
+        pressureBudget = std::min<uint64_t>(info.available, pressureCgroup.headroom());
+
+        uint64_t target = pressureBudget / 100 * static_cast<uint64_t>(options.pressureTargetPercent);
+        if (options.pressureTargetPercent > 100) {
+            target = std::min<uint64_t>(target, pressureBudget + info.swapFree / 10 * 9);
+            if (info.swapTotal == 0) {
+                std::cout << ConsoleColors::YELLOW << "No swap or zram configured: the pressure target stops at the budget"
+                          << ConsoleColors::RESET << std::endl;
+            }
+        }
+        options.pressureStep = std::max(blockSize, options.pressureStep / blockSize * blockSize);
+        options.memoryTarget = std::max<size_t>(target / blockSize * blockSize, blockSize);
+        pressureAvailable = info.available;
+
+        std::cout << ConsoleColors::BLUE << "Memory pressure: target " << options.memoryTarget / (1024 * 1024) << " MB of "
+                  << pressureBudget / (1024 * 1024) << " MB available (";
+        if (pressureCgroup.limit != MemoryPressure::UNLIMITED) {
+            std::cout << "cgroup " << (pressureCgroup.v2 ? "v2" : "v1") << " limit " << pressureCgroup.limit / (1024 * 1024)
+                      << " MB, " << pressureCgroup.usage / (1024 * 1024) << " MB used";
+        } else {
+            std::cout << "no cgroup limit";
         }
+        std::cout << ", swap " << info.swapFree / (1024 * 1024) << " MB free) in " << options.pressureStep / (1024 * 1024)
+                  << " MB steps" << ConsoleColors::RESET << std::endl;
+        if (!MemoryPressure::pressure().ok) {
+            std::cout << ConsoleColors::YELLOW << "/proc/pressure/memory is not available: no PSI stall times or PSI back-off"
+                      << ConsoleColors::RESET << std::endl;
+        }
+        return true;
+    }
 
-        // ===================================================================
-        // DISPLAY TEST RESULTS
-        // ===================================================================
-        // Calculate the total duration of the test
-        auto endTime = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    PressureSnapshot pressureSnapshot() const {
+        return {MemoryPressure::vmstat(), MemoryPressure::pressure(), MemoryPressure::ownMajorFaults(),
+                std::chrono::steady_clock::now()};
+    }
 
-        // Print an empty line for spacing
-        std::cout << std::endl;
+    void memoryPressureTest() {
+        constexpr size_t PAGE = 4096;
+        constexpr size_t TOUCH_PAGES = 16384;                   // Re-touched per tick (64 MB of 4 KB pages)
+        constexpr auto TICK = std::chrono::milliseconds(50);
+        const size_t step = options.pressureStep;
+        const auto dwell = std::chrono::milliseconds(options.pressureDwellMs);
 
-        // Display the test results banner
-        std::cout << "\n\n" << ConsoleColors::MAGENTA
-                << "=== Test Results ==="
-                << ConsoleColors::RESET << std::endl;
+        std::vector<char*> steps;                  // Every step mapped so far; [0, held) are resident
+        size_t held = 0;
+        size_t sweepStep = 0, sweepOffset = 0;     // Where the next re-touch continues
+        bool canGrow = true;                       // False once the arena refuses another step
 
-        // Display the total number of hashing operations performed
-        std::cout << ConsoleColors::CYAN
-                << "Total hashing operations: " << hashOps.load(std::memory_order_relaxed) 
-                << " ops" << ConsoleColors::RESET << std::endl;
+        pressureBefore = pressureSnapshot();
+        PressureSnapshot lastSecond = pressureBefore;
+        auto nextChange = pressureBefore.at;       // First step right away
 
-        // Display the total execution time in seconds
-        std::cout << ConsoleColors::CYAN
-                << "Total execution time: " << duration.count() / 1000.0
-                << " seconds" << ConsoleColors::RESET << std::endl;
+        while (running) {
+            const auto now = std::chrono::steady_clock::now();
+            const MemoryPressure::Meminfo info = MemoryPressure::meminfo();
+            const MemoryPressure::Psi psi = MemoryPressure::pressure();
+            const int64_t headroom = MemoryPressure::headroom(info, MemoryPressure::cgroup(), options.pressureSwap);
+            pressureAvailable.store(info.available, std::memory_order_relaxed);
+            pressureSwapUsed.store(info.swapTotal - info.swapFree, std::memory_order_relaxed);
+            psiSome.store(psi.someAvg10, std::memory_order_relaxed);
+            psiFull.store(psi.fullAvg10, std::memory_order_relaxed);
+            pressureLowestAvailable = std::min(pressureLowestAvailable, info.available);
+            if (now - lastSecond.at >= std::chrono::seconds(1)) {
+                const MemoryPressure::VmCounters vm = MemoryPressure::vmstat();
+                majorFaultRate.store((vm.majorFaults - lastSecond.vm.majorFaults)
+                                     / std::chrono::duration<double>(now - lastSecond.at).count(), std::memory_order_relaxed);
+                lastSecond.vm = vm;
+                lastSecond.at = now;
+            }
 
-        // Display the maximum amount of memory allocated during the test
-        std::cout << ConsoleColors::CYAN
-                << "Maximum memory allocated: " << memoryAllocated / (1024 * 1024)
-                << "MB" << ConsoleColors::RESET << std::endl;
+            const bool stalled = options.pressureBackoffPercent > 0 && psi.fullAvg10 >= options.pressureBackoffPercent;
+            if (held > 0 && (headroom < 0 || (stalled && now >= nextChange))) {
+                // [O(step / page)] The newest step goes first; its range is kept for the next growth
+                MemoryPressure::discard(steps[--held], step);
+                memoryAllocated -= step;
+                pressureSteps.store(static_cast<unsigned>(held), std::memory_order_relaxed);
+                pressureBackoffs.fetch_add(1, std::memory_order_relaxed);
+                nextChange = now + dwell;
+            } else if (canGrow && !stalled && now >= nextChange && memoryAllocated + step <= options.memoryTarget
+                       && headroom >= static_cast<int64_t>(step)) {
+                try {
+                    if (held == steps.size()) steps.push_back(static_cast<char*>(arena.allocate(step, PAGE)));
+                    for (size_t offset = 0; offset < step && running; offset += blockSize) { // [O(step)] Fault it in
+                        std::fill_n(reinterpret_cast<int*>(steps[held] + offset), blockSize / sizeof(int), 1);
+                        memoryAllocated += blockSize;
+                    }
+                    ++held;
+                    pressureSteps.store(static_cast<unsigned>(held), std::memory_order_relaxed);
+                    pressurePeak = std::max(pressurePeak, memoryAllocated.load());
+                } catch (const std::bad_alloc&) {
+                    canGrow = false;
+                }
+                nextChange = now + dwell;
+            }
 
-        // Display the number of CPU cores utilized
-        std::cout << ConsoleColors::CYAN
-                << "CPU cores utilized: " << numCores
-                << ConsoleColors::RESET << std::endl;
+            // [O(TOUCH_PAGES)] Keep every held page recently used, so reclaim has to look elsewhere
+            for (size_t touched = 0; touched < TOUCH_PAGES && held > 0 && running; ++touched) {
+                if (sweepStep >= held) sweepStep = 0, sweepOffset = 0;
+                steps[sweepStep][sweepOffset] += 1;
+                if ((sweepOffset += PAGE) >= step) ++sweepStep, sweepOffset = 0;
+            }
+            std::this_thread::sleep_for(TICK);
+        }
+        pressureAfter = pressureSnapshot();
     }
 
-};
+    void displayPressureStatus(std::string& out) const {
+        out += "\r\033[KPRESSURE: " + std::to_string(pressureSteps.load(std::memory_order_relaxed)) + " steps held | avail "
+             + std::to_string(pressureAvailable.load(std::memory_order_relaxed) / (1024 * 1024)) + " MB | swap "
+             + std::to_string(pressureSwapUsed.load(std::memory_order_relaxed) / (1024 * 1024)) + " MB | PSI some ";
+        appendNumber(out, psiSome.load(std::memory_order_relaxed), 1);
+        out += "% full ";
+        appendNumber(out, psiFull.load(std::memory_order_relaxed), 1);
+        out += "% | major faults ";
+        appendNumber(out, majorFaultRate.load(std::memory_order_relaxed), 0);
+        out += "/s | back-offs " + std::to_string(pressureBackoffs.load(std::memory_order_relaxed));
+    }
+
+    void reportPressure() const {
+        const double seconds = std::chrono::duration<double>(pressureAfter.at - pressureBefore.at).count();
+        if (seconds <= 0.0) return;
+        const MemoryPressure::VmCounters& before = pressureBefore.vm;
+        const MemoryPressure::VmCounters& after = pressureAfter.vm;
+        const uint64_t majorFaults = after.majorFaults - before.majorFaults;
+
+        std::cout << ConsoleColors::CYAN << "Memory pressure: peak " << pressurePeak / (1024 * 1024) << " MB held of a "
+                  << options.memoryTarget / (1024 * 1024) << " MB target, lowest MemAvailable "
+                  << pressureLowestAvailable / (1024 * 1024) << " MB, " << pressureBackoffs.load() << " back-offs"
+                  << ConsoleColors::RESET << std::endl;
+        std::cout << ConsoleColors::CYAN << "  major faults: " << majorFaults << " system-wide (" << majorFaults / seconds
+                  << "/s), " << pressureAfter.ownMajorFaults - pressureBefore.ownMajorFaults << " in this process"
+                  << ConsoleColors::RESET << std::endl;
+        std::cout << ConsoleColors::CYAN << "  swap: " << (after.swapIns - before.swapIns) * 4096 / (1024 * 1024) << " MB in, "
+                  << (after.swapOuts - before.swapOuts) * 4096 / (1024 * 1024) << " MB out; reclaim: "
+                  << after.pagesReclaimed - before.pagesReclaimed << " pages, "
+                  << after.directReclaims - before.directReclaims << " direct-reclaim stalls" << ConsoleColors::RESET << std::endl;
+        if (pressureBefore.psi.ok && pressureAfter.psi.ok) {
+            const double some = (pressureAfter.psi.someUs - pressureBefore.psi.someUs) / 1e6;
+            const double full = (pressureAfter.psi.fullUs - pressureBefore.psi.fullUs) / 1e6;
+            std::cout << ConsoleColors::CYAN << "  PSI memory stall: some " << some << " s (" << some / seconds * 100.0
+                      << "% of the run), full " << full << " s (" << full / seconds * 100.0 << "%)"
+                      << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // ============================================================================================
+    // FILE-BACKED MEMORY (--mem-mode=file)
+    // ============================================================================================
+    // The blocks are a shared mapping of a sparse file (see PageCache.hpp) instead of arena chunks:
+    //
+    //   fill     write every block once, counted like the arena blocks; each store dirties a
+    //            page-cache page
+    //   stream   window w       WILLNEED on w + 1, read-modify-write w (timed), msync(MS_ASYNC) w
+    //            window w - LAG msync(MS_SYNC) (timed), then DONTNEED from the mapping and the cache
+    //
+    // A slow rewrite is the kernel throttling this writer for dirty pages, or reading an evicted
+    // window back; a slow MS_SYNC is the filesystem's writeback falling behind.
+
+    // Creates and maps the backing file before any thread starts (a full disk is refused here)
+    bool prepareFileMapping() {
+    #ifdef __linux__
+        const size_t bytes = std::max(blockSize, options.memoryTarget / blockSize * blockSize);
+        std::string error;
+        if (!PageCache::create(options.memoryFileDirectory, bytes, fileMapping, error)) {
+            std::cout << ConsoleColors::RED << error << ConsoleColors::RESET << std::endl;
+            return false;
+        }
+        options.memoryFileWindow = std::clamp(options.memoryFileWindow / blockSize * blockSize, blockSize, bytes);
+        std::cout << ConsoleColors::BLUE << "File-backed memory: " << bytes / (1024 * 1024) << " MB sparse file "
+                  << fileMapping.path << ", " << options.memoryFileWindow / (1024 * 1024) << " MB windows"
+                  << ConsoleColors::RESET << std::endl;
+        return true;
+    #else
+        std::cout << ConsoleColors::RED << "File-backed memory is only implemented for Linux" << ConsoleColors::RESET << std::endl;
+        return false;
+    #endif
+    }
+
+    void memoryFileTest() {
+    #ifdef __linux__
+        constexpr auto SAMPLE_EVERY = std::chrono::milliseconds(100);  // Dirty / Writeback reads
+        char* const base = fileMapping.base;
+        const size_t bytes = fileMapping.bytes, window = options.memoryFileWindow;
+        const size_t windows = (bytes + window - 1) / window;
+        const size_t lag = std::min(PageCache::LAG, windows - 1);     // 0: a one-window file drops what it just wrote
+        auto span = [&](size_t w) { return std::min(window, bytes - w * window); };
+        auto nanos = [](auto duration) { return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()); };
+        Telemetry::Producer progress(telemetry, fileSource);
+
+        if (madvise(base, bytes, MADV_SEQUENTIAL) != 0) ++fileFailures;
+        const auto fillStart = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < bytes && running; offset += blockSize) { // [O(file)]
+            std::fill_n(reinterpret_cast<uint32_t*>(base + offset), blockSize / sizeof(uint32_t), 1u);
+            memoryAllocated += blockSize;
+            progress.add(blockSize);
+        }
+        const auto streamStart = std::chrono::steady_clock::now();
+        fileFillSeconds = std::chrono::duration<double>(streamStart - fillStart).count();
+
+        const uint64_t faultsBefore = MemoryPressure::ownMajorFaults();
+        auto lastSample = streamStart - SAMPLE_EVERY;
+        for (size_t w = 0; running; w = (w + 1) % windows) {
+            const size_t offset = w * window, length = span(w), next = (w + 1) % windows;
+            if (madvise(base + next * window, span(next), MADV_WILLNEED) != 0) ++fileFailures;
+
+            // [O(window)] Read every word back (a fault if it was evicted) and store it again (dirty)
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t block = 0; block < length && running; block += blockSize) {
+                uint32_t* words = reinterpret_cast<uint32_t*>(base + offset + block);
+                for (size_t i = 0; i < blockSize / sizeof(uint32_t); ++i) words[i] += 1;
+                progress.add(blockSize);
+                fileStreamBytes += blockSize;
+            }
+            fileWriteLatency.record(nanos(std::chrono::steady_clock::now() - start));
+            if (msync(base + offset, length, MS_ASYNC) != 0) ++fileFailures;
+
+            const size_t old = (w + windows - lag) % windows;
+            const auto syncStart = std::chrono::steady_clock::now();
+            if (msync(base + old * window, span(old), MS_SYNC) != 0) ++fileFailures;
+            const auto synced = std::chrono::steady_clock::now();
+            fileSyncLatency.record(nanos(synced - syncStart));
+            fileLastSyncNs.store(nanos(synced - syncStart), std::memory_order_relaxed);
+            if (!PageCache::evict(fileMapping, old * window, span(old))) ++fileFailures;
+
+            if (next == 0) fileLaps.fetch_add(1, std::memory_order_relaxed);
+            if (synced - lastSample >= SAMPLE_EVERY) {
+                const PageCache::Writeback state = PageCache::writeback();
+                fileDirty.store(state.dirty, std::memory_order_relaxed);
+                fileWriteback.store(state.writeback, std::memory_order_relaxed);
+                filePeakDirty = std::max(filePeakDirty, state.dirty);
+                lastSample = synced;
+            }
+        }
+        progress.flush();
+        fileStreamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - streamStart).count();
+        fileMajorFaults = MemoryPressure::ownMajorFaults() - faultsBefore;
+    #endif
+    }
+
+    void displayFileStatus(std::string& out) const {
+        out += "\r\033[KFILE: ";
+        appendNumber(out, telemetry.rate(Telemetry::Metric::FileBytes) / (1024.0 * 1024.0), 0);
+        out += " MB/s | dirty " + std::to_string(fileDirty.load(std::memory_order_relaxed) / (1024 * 1024))
+             + " MB, writeback " + std::to_string(fileWriteback.load(std::memory_order_relaxed) / (1024 * 1024))
+             + " MB | msync ";
+        appendNumber(out, fileLastSyncNs.load(std::memory_order_relaxed) / 1e6, 1);
+        out += " ms | laps " + std::to_string(fileLaps.load(std::memory_order_relaxed));
+    }
+
+    void reportFile() const {
+        auto millis = [](uint64_t ns) { return ns / 1e6; };
+        std::cout << ConsoleColors::CYAN << "File-backed memory: " << memoryAllocated / (1024 * 1024) << " MB filled in "
+                  << fileFillSeconds << " s, then " << fileLaps.load() << " laps of " << options.memoryFileWindow / (1024 * 1024)
+                  << " MB windows";
+        if (fileStreamSeconds > 0.0) std::cout << " at " << fileStreamBytes / fileStreamSeconds / (1024.0 * 1024.0) << " MB/s";
+        std::cout << ConsoleColors::RESET << std::endl;
+        if (fileWriteLatency.count() > 0) {
+            std::cout << ConsoleColors::CYAN << "  window rewrite: p50 " << millis(fileWriteLatency.percentile(0.50))
+                      << " ms, p99 " << millis(fileWriteLatency.percentile(0.99)) << " ms, max "
+                      << millis(fileWriteLatency.max()) << " ms (dirty throttling and read-back faults)"
+                      << ConsoleColors::RESET << std::endl;
+            std::cout << ConsoleColors::CYAN << "  msync(MS_SYNC): p50 " << millis(fileSyncLatency.percentile(0.50))
+                      << " ms, p99 " << millis(fileSyncLatency.percentile(0.99)) << " ms, max "
+                      << millis(fileSyncLatency.max()) << " ms" << ConsoleColors::RESET << std::endl;
+        }
+        std::cout << ConsoleColors::CYAN << "  peak Dirty " << filePeakDirty / (1024 * 1024) << " MB system-wide, "
+                  << fileMajorFaults << " major faults reading evicted windows back";
+        if (fileFailures > 0) std::cout << ", " << fileFailures << " failed madvise/msync calls";
+        std::cout << ConsoleColors::RESET << std::endl;
+    }
+
+    // ============================================================================================
+    // GPU LOAD (--gpu)
+    // ============================================================================================
+    // One host thread keeps the device busy (see Gpu.hpp): every round queues a host <-> device
+    // transfer pair on one queue and a modexp, a GEMM and a device copy on the other, then waits
+    // for both. The host recomputes each round's first modexp item, so a device that computes
+    // wrong (or a kernel that is not equivalent) is reported rather than scored.
+
+    bool prepareGpu() {
+        std::string error;
+        if (!gpu.open(options.gpuDevice, error)) {
+            std::cout << ConsoleColors::RED << "GPU: " << error << ConsoleColors::RESET << std::endl;
+            return false;
+        }
+        const Gpu::Device& device = gpu.device();
+        std::cout << ConsoleColors::BLUE << "GPU: " << device.name << " (" << device.platform << ", " << device.version
+                  << ", " << device.computeUnits << " compute units, " << device.memoryBytes / (1024 * 1024) << " MB)"
+                  << ConsoleColors::RESET << std::endl;
+        return true;
+    }
+
+    void gpuStressTest() {
+        Telemetry::Producer progress(telemetry, gpuSource);
+        Gpu::Round round;
+        std::string error;
+        while (running) {
+            if (!gpu.round(round, error)) {
+                gpuFailure = error;
+                break;
+            }
+            // [O(exponent^2)] Same inputs, same loop on the CPU
+            const uint64_t expected = Workloads::computeIntensiveHash(Gpu::modexpBase(round.modexpFirst),
+                                                                      Gpu::modexpExponent(round.modexpFirst), Gpu::MODEXP_MODULUS);
+            if (expected != round.modexpFirstResult) ++gpuMismatches;
+            progress.add(round.modexpOps);
+            gpuTotals.add(round);
+            ++gpuRounds;
+
+            auto perSecond = [](double amount, double seconds) { return seconds > 0.0 ? amount / seconds : 0.0; };
+            gpuModexpRate.store(perSecond(round.modexpOps, round.modexpSeconds), std::memory_order_relaxed);
+            gpuGflops.store(perSecond(round.gemmFlops, round.gemmSeconds) / 1e9, std::memory_order_relaxed);
+            gpuMemGbs.store(perSecond(round.deviceBytes, round.copySeconds) / 1e9, std::memory_order_relaxed);
+            gpuTransferGbs.store(perSecond(round.transferBytes, round.transferSeconds) / 1e9, std::memory_order_relaxed);
+            gpuOverlap.store(round.overlap(), std::memory_order_relaxed);
+        }
+        progress.flush();
+    }
+
+    void displayGpuStatus(std::string& out) const {
+        out += "\r\033[KGPU: " + std::to_string(telemetry.total(Telemetry::Metric::GpuOps)) + " ops (";
+        appendNumber(out, gpuModexpRate.load(std::memory_order_relaxed), 0);
+        out += " ops/s) | GEMM ";
+        appendNumber(out, gpuGflops.load(std::memory_order_relaxed), 0);
+        out += " GFLOP/s | memory ";
+        appendNumber(out, gpuMemGbs.load(std::memory_order_relaxed), 1);
+        out += " GB/s | host<->device ";
+        appendNumber(out, gpuTransferGbs.load(std::memory_order_relaxed), 1);
+        out += " GB/s (";
+        appendNumber(out, gpuOverlap.load(std::memory_order_relaxed) * 100.0, 0);
+        out += "% overlapped)";
+    }
+
+    void reportGpu() const {
+        const Gpu::Round& total = gpuTotals;
+        auto perSecond = [](double amount, double seconds) { return seconds > 0.0 ? amount / seconds : 0.0; };
+        std::cout << ConsoleColors::CYAN << "GPU operations: " << total.modexpOps << " ops ("
+                  << perSecond(total.modexpOps, total.modexpSeconds) << " ops/s of kernel time, " << gpuRounds
+                  << " rounds on " << gpu.device().name << ")" << ConsoleColors::RESET << std::endl;
+        std::cout << ConsoleColors::CYAN << "  GEMM: " << perSecond(total.gemmFlops, total.gemmSeconds) / 1e9
+                  << " GFLOP/s, device memory: " << perSecond(total.deviceBytes, total.copySeconds) / 1e9
+                  << " GB/s, host<->device: " << perSecond(total.transferBytes, total.transferSeconds) / 1e9
+                  << " GB/s (" << total.overlap() * 100.0 << "% hidden behind the kernels)" << ConsoleColors::RESET << std::endl;
+        if (gpuMismatches > 0) {
+            std::cout << ConsoleColors::RED << "  GPU modexp disagreed with the CPU in " << gpuMismatches << " of "
+                      << gpuRounds << " checked rounds" << ConsoleColors::RESET << std::endl;
+        }
+        if (!gpuFailure.empty()) {
+            std::cout << ConsoleColors::RED << "  GPU load stopped early: " << gpuFailure << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // ============================================================================================
+    // CACHE STRESS (--cache-stress)
+    // ============================================================================================
+    // Every cache thread owns one working set per level (see CacheStress.hpp) and all of them go
+    // through the same phases at the same time, derived from the clock rather than a barrier:
+    //
+    //   L1d seq | L1d rand | L2 seq | L2 rand | LLC seq | LLC rand | >LLC seq | >LLC rand | L1d seq ...
+    //   <----- cachePhaseMs ----->
+    //
+    // so the LLC sets of all threads share the LLC together and the >LLC sets overflow it together.
+    // The clock starts once every thread has first-touched its sets on its own CPU. At the end of a
+    // phase the set is read back against its lap count (outside the timed loop).
+
+    // Sizes the working sets for the thread count and maps them before the run starts
+    bool prepareCache() {
+        cacheSizes = Topology::cacheSizes();
+        const unsigned threads = std::max(1u, options.cacheThreads ? options.cacheThreads : numCores);
+        const unsigned available = std::max(1u, static_cast<unsigned>(cpus.size()));
+        cacheShare = std::clamp((threads * cacheSizes.llcSharing + available - 1) / available, 1u, cacheSizes.llcSharing);
+
+        try {
+            cacheRegions.resize(size_t(threads) * CacheStress::LEVEL_COUNT);
+            for (size_t r = 0; r < cacheRegions.size(); ++r) { // [O(threads * levels)] Mapped here, touched by the owner
+                CacheStress::Region& region = cacheRegions[r];
+                region.bytes = CacheStress::workingSet(CacheStress::Level(r % CacheStress::LEVEL_COUNT), cacheSizes, cacheShare);
+                region.words = static_cast<uint64_t*>(cacheArena.allocate(region.bytes, 4096));
+                region.lines = static_cast<char*>(cacheArena.allocate(region.bytes, 4096));
+            }
+        } catch (const std::bad_alloc&) {
+            std::cout << ConsoleColors::RED << "Cannot allocate the cache-stress working sets" << ConsoleColors::RESET << std::endl;
+            return false;
+        }
+
+        std::cout << ConsoleColors::BLUE << "Caches (" << cacheSizes.source << "): L1d " << cacheSizes.l1d / 1024
+                  << " KB, L2 " << cacheSizes.l2 / 1024 << " KB, LLC " << cacheSizes.llc / 1024 << " KB shared by "
+                  << cacheSizes.llcSharing << " CPUs" << ConsoleColors::RESET << std::endl;
+        return true;
+    }
+
+    // [O(1)] Phase index (level * ACCESS_COUNT + access) at `now`
+    int cachePhaseAt(std::chrono::steady_clock::time_point now) const {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - cacheStart).count();
+        return static_cast<int>(elapsed / options.cachePhaseMs % CacheStress::PHASE_COUNT);
+    }
+
+    void cacheStressTest() {
+        const std::vector<unsigned> cacheCpus = memoryThreadCpus();
+        const unsigned threads = static_cast<unsigned>(cacheSources.size());
+        std::latch initialised(threads), go(1);
+
+        auto stress = [&](unsigned t) {
+            placeMemoryThread(cacheCpus[t % cacheCpus.size()]);
+            CacheStress::Region* regions = &cacheRegions[size_t(t) * CacheStress::LEVEL_COUNT];
+            auto seed = [t](int level) { return 0xC2B2AE3D27D4EB4Full + uint64_t(t) * CacheStress::LEVEL_COUNT + level; };
+            for (int level = 0; level < CacheStress::LEVEL_COUNT; ++level) CacheStress::reset(regions[level], seed(level));
+            initialised.count_down();
+            go.wait();
+
+            CacheStress::Results& results = *cacheResults[t];
+            Telemetry::Producer progress(telemetry, cacheSources[t]);
+            while (running) {
+                const auto phaseStart = std::chrono::steady_clock::now();
+                const int phase = cachePhaseAt(phaseStart);
+                const auto level = CacheStress::Level(phase / CacheStress::ACCESS_COUNT);
+                const auto access = CacheStress::Access(phase % CacheStress::ACCESS_COUNT);
+                CacheStress::Region& region = regions[level];
+
+                // Laps between clock reads: a small L1d set would otherwise spend its time in now()
+                const size_t lapsPerCheck = std::max<size_t>(1, (256 * 1024) / region.bytes);
+                double moved = 0.0;
+                bool broken = false;
+                auto now = phaseStart;
+                while (running && !broken && cachePhaseAt(now) == phase) {
+                    for (size_t lap = 0; lap < lapsPerCheck; ++lap) { // [O(set)] per lap
+                        const size_t bytes = access == CacheStress::Sequential ? CacheStress::sequentialLap(region)
+                                                                               : CacheStress::scatteredLap(region);
+                        if (bytes == 0) { broken = true; break; }
+                        moved += static_cast<double>(bytes);
+                        progress.add(bytes);
+                    }
+                    now = std::chrono::steady_clock::now();
+                }
+                results.seconds[level][access] += std::chrono::duration<double>(now - phaseStart).count();
+                results.bytes[level][access] += moved;
+
+                // A wrong word is counted once, then the set starts again from zero
+                const uint64_t wrong = broken ? 1 : CacheStress::check(region, access);
+                if (wrong) {
+                    results.errors[level] += wrong;
+                    cacheErrors.fetch_add(wrong, std::memory_order_relaxed);
+                    CacheStress::reset(region, seed(level));
+                }
+            }
+            progress.flush();
+        };
+
+        std::vector<std::thread> stressors;
+        for (unsigned t = 0; t < threads; ++t) stressors.emplace_back(stress, t);
+        initialised.wait();
+        cacheStart = std::chrono::steady_clock::now();
+        cacheReady.store(true, std::memory_order_release);
+        go.count_down();
+        for (auto& stressor : stressors) stressor.join();
+    }
+
+    void displayCacheStatus(std::string& out) const {
+        if (!cacheReady.load(std::memory_order_acquire)) {
+            out += "\r\033[KCACHE: initialising working sets";
+            return;
+        }
+        const int phase = cachePhaseAt(std::chrono::steady_clock::now());
+        out += "\r\033[KCACHE: ";
+        out += CacheStress::name(CacheStress::Level(phase / CacheStress::ACCESS_COUNT));
+        out += " ";
+        out += CacheStress::name(CacheStress::Access(phase % CacheStress::ACCESS_COUNT));
+        out += " | ";
+        appendNumber(out, telemetry.rate(Telemetry::Metric::CacheBytes) / 1e9, 2);
+        out += " GB/s | errors: " + std::to_string(cacheErrors.load(std::memory_order_relaxed));
+    }
+
+    // Per-level bandwidth (summed over threads) for both access patterns, and read-back errors
+    void reportCache() const {
+        const unsigned threads = static_cast<unsigned>(cacheResults.size());
+        std::cout << ConsoleColors::CYAN << "Cache stress (" << threads << " threads, " << cacheShare
+                  << " per LLC, " << options.cachePhaseMs << " ms phases):" << ConsoleColors::RESET << std::endl;
+
+        uint64_t errors[CacheStress::LEVEL_COUNT] = {}, totalErrors = 0;
+        for (int level = 0; level < CacheStress::LEVEL_COUNT; ++level) {
+            double rates[CacheStress::ACCESS_COUNT] = {};
+            for (const auto& results : cacheResults) { // [O(threads)]
+                for (int access = 0; access < CacheStress::ACCESS_COUNT; ++access) {
+                    if (results->seconds[level][access] > 0.0) {
+                        rates[access] += results->bytes[level][access] / results->seconds[level][access] / 1e9;
+                    }
+                }
+                errors[level] += results->errors[level];
+            }
+            totalErrors += errors[level];
+            const size_t bytes = cacheRegions[level].bytes;
+            std::cout << ConsoleColors::CYAN << "  " << CacheStress::name(CacheStress::Level(level)) << " ("
+                      << bytes / 1024 << " KB/thread): " << CacheStress::name(CacheStress::Sequential) << " "
+                      << rates[CacheStress::Sequential] << " GB/s, " << CacheStress::name(CacheStress::Scattered) << " "
+                      << rates[CacheStress::Scattered] << " GB/s" << ConsoleColors::RESET << std::endl;
+        }
+
+        if (totalErrors == 0) {
+            std::cout << ConsoleColors::CYAN << "  Read-back errors: 0" << ConsoleColors::RESET << std::endl;
+            return;
+        }
+        std::cout << ConsoleColors::RED << "  Read-back errors: " << totalErrors << " (";
+        for (int level = 0; level < CacheStress::LEVEL_COUNT; ++level) {
+            std::cout << (level ? ", " : "") << CacheStress::name(CacheStress::Level(level)) << " " << errors[level];
+        }
+        std::cout << ")" << ConsoleColors::RESET << std::endl;
+    }
+
+    // ============================================================================================
+    // CORE-TO-CORE LATENCY (--core-latency)
+    // ============================================================================================
+    // The same matrix is measured twice: before the workers start (idle machine) and again on
+    // its own thread while the hash load runs, so the report shows what the load adds per pair.
+
+    // [O(n^2)] Idle matrix, before the run; false when fewer than two of the CPUs are available
+    bool measureIdleCoreLatency() {
+        latencyCpus.clear();
+        if (options.coreLatencyCpus.empty()) {
+            for (const auto& cpu : cpus) latencyCpus.push_back(cpu.id);
+        } else {
+            for (unsigned id : options.coreLatencyCpus) if (Topology::find(cpus, id)) latencyCpus.push_back(id);
+        }
+        if (latencyCpus.size() < 2) {
+            std::cout << ConsoleColors::YELLOW << "Core-to-core latency needs at least two available CPUs"
+                      << ConsoleColors::RESET << std::endl;
+            latencyCpus.clear();
+            return false;
+        }
+
+        const size_t pairs = latencyCpus.size() * (latencyCpus.size() - 1) / 2;
+        std::cout << ConsoleColors::BLUE << "Core-to-core latency: " << latencyCpus.size() << " CPUs, " << pairs
+                  << " pairs (idle pass)..." << ConsoleColors::RESET << std::endl;
+        idleLatency = CoreLatency::matrix(latencyCpus, running, idlePairs);
+        return true;
+    }
+
+    // Loaded matrix: starts once the workers had a second to ramp up, ends with the test
+    void coreLatencyUnderLoad() {
+        const auto begin = std::chrono::steady_clock::now();
+        while (running && std::chrono::steady_clock::now() - begin < std::chrono::seconds(1)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        if (running) loadedLatency = CoreLatency::matrix(latencyCpus, running, loadedPairs);
+    }
+
+    // Rows of `cells` (one-way ns) with the CPU ids as headers; "-" for pairs never reached
+    void printLatencyMatrix(const char* title, const std::vector<double>& cells) const {
+        const size_t n = latencyCpus.size();
+        constexpr size_t WIDTH = 6;
+        auto pad = [](std::string& out, const std::string& text) {
+            out.append(text.size() < WIDTH ? WIDTH - text.size() : 1, ' ');
+            out += text;
+        };
+
+        std::cout << ConsoleColors::CYAN << title << " (one-way ns):" << ConsoleColors::RESET << std::endl;
+        std::string line = "      ";
+        for (unsigned id : latencyCpus) pad(line, "cpu" + std::to_string(id));
+        std::cout << line << std::endl;
+        for (size_t i = 0; i < n; ++i) { // [O(n^2)]
+            line.clear();
+            pad(line, "cpu" + std::to_string(latencyCpus[i]));
+            for (size_t j = 0; j < n; ++j) {
+                const double ns = cells[i * n + j];
+                std::string cell;
+                if (i == j) cell = ".";
+                else if (ns < 0.0) cell = "-";
+                else appendNumber(cell, ns, 0);
+                pad(line, cell);
+            }
+            std::cout << line << std::endl;
+        }
+    }
+
+    // Both matrices, then the median / min / max one-way latency per topology relation
+    void reportCoreLatency() const {
+        const size_t n = latencyCpus.size();
+        printLatencyMatrix("Core-to-core latency, idle", idleLatency);
+        if (!loadedLatency.empty()) {
+            printLatencyMatrix("Core-to-core latency under load", loadedLatency);
+            const size_t pairs = n * (n - 1) / 2, done = loadedPairs.load();
+            if (done < pairs) {
+                std::cout << ConsoleColors::YELLOW << "Only " << done << " of " << pairs
+                          << " pairs were measured under load before the test ended" << ConsoleColors::RESET << std::endl;
+            }
+        }
+
+        auto summary = [](std::vector<double>& values, std::string& out) {
+            if (values.empty()) { out += "-"; return; }
+            std::sort(values.begin(), values.end()); // [O(p log p)]
+            appendNumber(out, values[values.size() / 2], 0);
+            out += " ns (min ";
+            appendNumber(out, values.front(), 0);
+            out += ", max ";
+            appendNumber(out, values.back(), 0);
+            out += ")";
+        };
+        for (int r = 0; r < CoreLatency::RELATION_COUNT; ++r) {
+            std::vector<double> idle, loaded;
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = i + 1; j < n; ++j) {
+                    if (CoreLatency::relation(*Topology::find(cpus, latencyCpus[i]), *Topology::find(cpus, latencyCpus[j])) != r) continue;
+                    if (idleLatency[i * n + j] >= 0.0) idle.push_back(idleLatency[i * n + j]);
+                    if (!loadedLatency.empty() && loadedLatency[i * n + j] >= 0.0) loaded.push_back(loadedLatency[i * n + j]);
+                }
+            }
+            if (idle.empty() && loaded.empty()) continue;
+            std::string line = "  " + std::string(CoreLatency::name(CoreLatency::Relation(r))) + " ("
+                             + std::to_string(idle.size()) + " pairs): idle ";
+            summary(idle, line);
+            line += ", under load ";
+            summary(loaded, line);
+            std::cout << ConsoleColors::CYAN << line << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // ============================================================================================
+    // STORAGE STRESS TEST
+    // ============================================================================================
+    // Runs next to the CPU and memory load on a scratch file (--storage=DIR):
+    //   1. prepareStorage() (run(), before any thread): create the O_DIRECT file, pick the engine,
+    //      carve every request buffer out of ioArena, size the per-thread stats.
+    //   2. storageStressTest() (own thread): write the file once, then start the engine threads.
+    //   3. io_uring engine: one ring per thread, io-depth requests always in flight.
+    //      threads engine: io-threads x io-depth blocking pread/pwrite loops.
+    //      coro engine: one executor per thread, io-depth coroutines each awaiting one request.
+
+    bool prepareStorage() {
+    #ifdef __linux__
+        std::string error;
+        if (!Storage::createFile(options.storagePath, options.storageSize, storageFile, error)) {
+            std::cout << ConsoleColors::RED << error << ConsoleColors::RESET << std::endl;
+            return false;
+        }
+
+        storageEngine = options.ioEngine;
+        if (storageEngine != Storage::Engine::Threads) {
+            Storage::Uring probe;
+            if (probe.setup(options.ioDepth, error)) {
+                if (storageEngine == Storage::Engine::Auto) storageEngine = Storage::Engine::IoUring;
+            } else if (storageEngine != Storage::Engine::Auto) {
+                std::cout << ConsoleColors::RED << "io_uring unavailable (" << error << ")" << ConsoleColors::RESET << std::endl;
+                Storage::removeFile(storageFile);
+                return false;
+            } else {
+                storageEngine = Storage::Engine::Threads;
+            }
+        }
+
+        // One producer per submitting thread: a ring, an executor, or one blocking loop per queue slot
+        const unsigned producers = storageEngine == Storage::Engine::Threads ? options.ioThreads * options.ioDepth : options.ioThreads;
+        try {
+            ioPrefillBuffer = static_cast<char*>(ioArena.allocate(blockSize, 4096));
+            std::fill_n(ioPrefillBuffer, blockSize, static_cast<char>(0x5A));
+            ioBuffers = static_cast<char*>(ioArena.allocate(size_t(options.ioThreads) * options.ioDepth * options.ioSize, 4096));
+        } catch (const std::bad_alloc&) {
+            std::cout << ConsoleColors::RED << "Cannot allocate the I/O buffers" << ConsoleColors::RESET << std::endl;
+            Storage::removeFile(storageFile);
+            return false;
+        }
+        for (unsigned t = 0; t < producers; ++t) ioStats.push_back(std::make_unique<IoStats>());
+        return true;
+    #else
+        std::cout << ConsoleColors::RED << "The storage test is only implemented for Linux" << ConsoleColors::RESET << std::endl;
+        return false;
+    #endif
+    }
+
+#ifdef __linux__
+    void storageStressTest() {
+        auto prefillStart = std::chrono::steady_clock::now();
+        if (!Storage::prefill(storageFile, ioPrefillBuffer, blockSize, running)) {
+            storageError = std::string("prefill failed: ") + std::strerror(errno);
+            return;
+        }
+        storagePrefillSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - prefillStart).count();
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> submitters;
+        for (unsigned t = 0; t < ioStats.size(); ++t) {
+            if (storageEngine == Storage::Engine::IoUring) submitters.emplace_back(&SystemStressTest::ioUringLoop, this, t);
+            else if (storageEngine == Storage::Engine::Coroutines) submitters.emplace_back(&SystemStressTest::ioCoroutineLoop, this, t);
+            else submitters.emplace_back(&SystemStressTest::ioBlockingLoop, this, t);
+        }
+        for (auto& submitter : submitters) submitter.join();
+        storageSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Counts one finished request into the owner's stats and telemetry
+    void completeIo(IoStats& stats, Telemetry::Producer& bytes, Telemetry::Producer& ops,
+                    bool read, int64_t result, uint64_t latencyNs) {
+        if (result != static_cast<int64_t>(options.ioSize)) {
+            ++stats.errors;
+            return;
+        }
+        (read ? stats.reads : stats.writes) += 1;
+        (read ? stats.readBytes : stats.writeBytes) += options.ioSize;
+        (read ? stats.readLatency : stats.writeLatency).record(latencyNs); // [O(1)]
+        bytes.add(options.ioSize);
+        ops.add(1);
+    }
+
+    // One ring per thread, ioDepth requests kept in flight until the test stops
+    void ioUringLoop(unsigned t) {
+        Storage::Uring ring;
+        std::string error;
+        if (!ring.setup(options.ioDepth, error)) {
+            ++ioStats[t]->errors;
+            return;
+        }
+
+        IoStats& stats = *ioStats[t];
+        Telemetry::Producer bytes(telemetry, ioByteSources[t]), ops(telemetry, ioOpSources[t]);
+        const uint64_t blocks = storageFile.size / options.ioSize;
+        Storage::Pattern pattern(t + 1, storageFile.size, options.ioSize, options.ioReadPercent, options.ioRandom,
+                                 blocks * t / ioStats.size());
+
+        const unsigned depth = std::min(options.ioDepth, ring.depth());
+        char* buffers = ioBuffers + size_t(t) * options.ioDepth * options.ioSize;
+        std::vector<uint64_t> issuedAt(depth);
+        std::vector<bool> isRead(depth);
+
+        auto issue = [&](unsigned slot) {
+            isRead[slot] = pattern.nextIsRead();
+            issuedAt[slot] = Telemetry::nowNs();
+            ring.queue(isRead[slot], storageFile.fd, buffers + size_t(slot) * options.ioSize,
+                       static_cast<uint32_t>(options.ioSize), pattern.nextOffset(), slot);
+        };
+
+        unsigned inFlight = depth;
+        for (unsigned slot = 0; slot < depth; ++slot) issue(slot);
+
+        while (inFlight > 0) {
+            if (!ring.submit(1)) { // [O(1)] One syscall submits the refills and waits for a completion
+                ++stats.errors;
+                break;
+            }
+            const bool refill = running.load(std::memory_order_relaxed);
+            ring.reap([&](uint64_t slot, int result) { // [O(completions)]
+                completeIo(stats, bytes, ops, isRead[slot], result, Telemetry::nowNs() - issuedAt[slot]);
+                if (refill) issue(static_cast<unsigned>(slot));
+                else --inFlight;
+            });
+        }
+        bytes.flush();
+        ops.flush();
+    }
+
+    // One request slot of the coro engine, written as the blocking loop it replaces
+    Async::Task ioRequest(Async::Executor& executor, IoStats& stats, Storage::Pattern& pattern, char* buffer,
+                          Telemetry::Producer& bytes, Telemetry::Producer& ops) {
+        while (running.load(std::memory_order_relaxed)) {
+            const bool read = pattern.nextIsRead();
+            const uint64_t offset = pattern.nextOffset();
+            const uint64_t started = Telemetry::nowNs();
+            const int result = read ? co_await executor.read(storageFile.fd, buffer, static_cast<uint32_t>(options.ioSize), offset)
+                                    : co_await executor.write(storageFile.fd, buffer, static_cast<uint32_t>(options.ioSize), offset);
+            completeIo(stats, bytes, ops, read, result, Telemetry::nowNs() - started);
+        }
+    }
+
+    // One executor per thread: ioDepth coroutines share its ring and keep a request each in flight
+    void ioCoroutineLoop(unsigned t) {
+        IoStats& stats = *ioStats[t];
+        Telemetry::Producer bytes(telemetry, ioByteSources[t]), ops(telemetry, ioOpSources[t]);
+        const uint64_t blocks = storageFile.size / options.ioSize;
+        Storage::Pattern pattern(t + 1, storageFile.size, options.ioSize, options.ioReadPercent, options.ioRandom,
+                                 blocks * t / ioStats.size());
+
+        Async::Executor executor;
+        std::string error;
+        if (!executor.setup(options.ioDepth, error)) {
+            ++stats.errors;
+            return;
+        }
+        const unsigned depth = std::min(options.ioDepth, executor.capacity());
+        char* buffers = ioBuffers + size_t(t) * options.ioDepth * options.ioSize;
+        for (unsigned slot = 0; slot < depth; ++slot) {
+            executor.spawn(ioRequest(executor, stats, pattern, buffers + size_t(slot) * options.ioSize, bytes, ops));
+        }
+        if (!executor.run()) ++stats.errors;
+        stats.peakInFlight = executor.peakInFlight();
+        bytes.flush();
+        ops.flush();
+    }
+
+    // Thread-pool fallback: every queue slot is a thread issuing blocking pread/pwrite
+    void ioBlockingLoop(unsigned p) {
+        IoStats& stats = *ioStats[p];
+        Telemetry::Producer bytes(telemetry, ioByteSources[p]), ops(telemetry, ioOpSources[p]);
+        const uint64_t blocks = storageFile.size / options.ioSize;
+        Storage::Pattern pattern(p + 1, storageFile.size, options.ioSize, options.ioReadPercent, options.ioRandom,
+                                 blocks * p / ioStats.size());
+        char* buffer = ioBuffers + size_t(p) * options.ioSize;
+
+        while (running.load(std::memory_order_relaxed)) {
+            const bool read = pattern.nextIsRead();
+            const off_t offset = static_cast<off_t>(pattern.nextOffset());
+            const uint64_t started = Telemetry::nowNs();
+            const ssize_t result = read ? pread(storageFile.fd, buffer, options.ioSize, offset)
+                                        : pwrite(storageFile.fd, buffer, options.ioSize, offset);
+            completeIo(stats, bytes, ops, read, result, Telemetry::nowNs() - started);
+        }
+        bytes.flush();
+        ops.flush();
+    }
+#endif
+
+    void displayStorageStatus(std::string& out) const {
+        out += "\r\033[KSTORAGE: ";
+        appendNumber(out, telemetry.rate(Telemetry::Metric::IoOps), 0);
+        out += " IOPS | ";
+        appendNumber(out, telemetry.rate(Telemetry::Metric::IoBytes) / (1024.0 * 1024.0), 1);
+        out += " MB/s (";
+        out += Storage::name(storageEngine);
+        out += storageFile.direct ? ", O_DIRECT)" : ", buffered)";
+    }
+
+    // IOPS, bandwidth and per-direction latency percentiles of the storage test
+    void reportStorage() const {
+        if (!storageError.empty()) {
+            std::cout << ConsoleColors::RED << "Storage test: " << storageError << ConsoleColors::RESET << std::endl;
+            return;
+        }
+        IoStats total;
+        for (const auto& stats : ioStats) {
+            total.reads += stats->reads;
+            total.writes += stats->writes;
+            total.readBytes += stats->readBytes;
+            total.writeBytes += stats->writeBytes;
+            total.errors += stats->errors;
+            total.peakInFlight = std::max(total.peakInFlight, stats->peakInFlight);
+            total.readLatency.merge(stats->readLatency);
+            total.writeLatency.merge(stats->writeLatency);
+        }
+        if (storageSeconds <= 0.0) return;
+
+        std::cout << ConsoleColors::CYAN << "Storage (" << Storage::name(storageEngine)
+                  << (storageFile.direct ? ", O_DIRECT" : ", buffered") << ", " << options.ioSize << " B "
+                  << (options.ioRandom ? "random" : "sequential") << ", QD " << options.ioDepth << " x "
+                  << options.ioThreads << " threads, " << options.ioReadPercent << "% reads): "
+                  << (total.reads + total.writes) / storageSeconds << " IOPS, "
+                  << (total.readBytes + total.writeBytes) / storageSeconds / (1024.0 * 1024.0) << " MB/s"
+                  << ConsoleColors::RESET << std::endl;
+        std::cout << ConsoleColors::CYAN << "  prefill: " << storageFile.size / (1024 * 1024) << " MB in "
+                  << storagePrefillSeconds << " s" << ConsoleColors::RESET << std::endl;
+        if (storageEngine == Storage::Engine::Coroutines) {
+            std::cout << ConsoleColors::CYAN << "  coroutines: " << options.ioDepth << " per executor, up to "
+                      << total.peakInFlight << " requests in flight at once" << ConsoleColors::RESET << std::endl;
+        }
+
+        auto latencyLine = [](const char* label, const Histogram::LogLinear& latency) {
+            if (latency.count() == 0) return;
+            std::cout << ConsoleColors::CYAN << "  " << label << " latency (" << latency.count() << " ops): p50 "
+                      << latency.percentile(0.50) / 1000.0 << " us, p99 " << latency.percentile(0.99) / 1000.0
+                      << " us, p99.9 " << latency.percentile(0.999) / 1000.0 << " us, max "
+                      << latency.max() / 1000.0 << " us" << ConsoleColors::RESET << std::endl;
+        };
+        latencyLine("read", total.readLatency);
+        latencyLine("write", total.writeLatency);
+        if (total.errors > 0) {
+            std::cout << ConsoleColors::YELLOW << "  failed or short requests: " << total.errors
+                      << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // ============================================================================================
+    // NETWORK STRESS TEST
+    // ============================================================================================
+    // Flows next to the CPU load (--net=loopback|HOST:PORT, --net-listen=PORT):
+    //   1. prepareNetwork() (run(), before any thread): bind the receivers, connect the senders,
+    //      give every flow thread a CPU (senders and receivers of a flow on different cores).
+    //   2. networkStressTest() (own thread): start one thread per sender and receiver; in peer
+    //      mode it keeps accepting TCP connections into the free receiver slots until the end.
+    //   3. Senders push the same payload with send / sendmmsg (MSG_ZEROCOPY when available),
+    //      receivers drain with recv / recvmmsg; the softirq totals bracket the whole run.
+
+    bool prepareNetwork() {
+    #ifdef __linux__
+        const bool loopback = options.netTarget == "loopback";
+        const bool udp = options.netProtocol == Network::Protocol::Udp;
+        netPayload = options.netMessageSize ? options.netMessageSize : udp ? Network::UDP_PAYLOAD : Network::TCP_CHUNK;
+        const size_t receiveBytes = udp ? 65536 : 4 * Network::TCP_CHUNK;
+        std::string error;
+        auto fail = [&](const std::string& message) {
+            std::cout << ConsoleColors::RED << message << ConsoleColors::RESET << std::endl;
+            closeNetwork();
+            return false;
+        };
+        if (udp && netPayload > 65507) return fail("UDP datagrams are limited to 65507 bytes");
+
+        auto flow = [&](size_t bytes, unsigned cpu) {
+            auto stats = std::make_unique<NetStats>();
+            stats->buffer = static_cast<char*>(netArena.allocate(bytes, 4096));
+            std::fill_n(stats->buffer, bytes, static_cast<char>(0xA5));
+            stats->cpu = cpu;
+            return stats;
+        };
+        const size_t cpuCount = cpus.size();
+
+        // Receivers first, so loopback senders have a port to connect to
+        uint16_t port = loopback ? 0 : static_cast<uint16_t>(options.netListenPort);
+        if (loopback || options.netListenPort != 0) {
+            if (!udp && (netListener = Network::openReceiver(options.netProtocol, loopback, port, error)) < 0) return fail(error);
+            for (unsigned f = 0; f < options.netFlows; ++f) {
+                netReceivers.push_back(flow(receiveBytes, cpus[(f + cpuCount / 2) % cpuCount].id));
+                if (udp && (netReceivers.back()->fd = Network::openReceiver(options.netProtocol, loopback, port, error)) < 0) {
+                    return fail(error);
+                }
+            }
+        }
+
+        if (!options.netTarget.empty()) {
+            sockaddr_in peer;
+            std::string host = "127.0.0.1";
+            if (!loopback) Network::splitEndpoint(options.netTarget, host, port);
+            if (!Network::resolve(host, port, peer, error)) return fail(error);
+
+            netZeroCopy = options.netZeroCopy;
+            for (unsigned f = 0; f < options.netFlows; ++f) {
+                netSenders.push_back(flow(netPayload, cpus[f % cpuCount].id));
+                bool zeroCopy = options.netZeroCopy;
+                if ((netSenders.back()->fd = Network::connectFlow(options.netProtocol, peer, zeroCopy, error)) < 0) {
+                    return fail("Cannot reach " + host + ":" + std::to_string(port) + " (" + error + ")");
+                }
+                netZeroCopy = netZeroCopy && zeroCopy;
+            }
+        }
+
+        // Loopback TCP: every connection is already waiting in the backlog
+        if (loopback && !udp) {
+            for (auto& receiver : netReceivers) {
+                if ((receiver->fd = accept4(netListener, nullptr, nullptr, SOCK_CLOEXEC)) < 0) {
+                    return fail(std::string("accept: ") + std::strerror(errno));
+                }
+                Network::setTimeouts(receiver->fd);
+            }
+            close(netListener);
+            netListener = -1;
+        }
+        return true;
+    #else
+        std::cout << ConsoleColors::RED << "The network test is only implemented for Linux" << ConsoleColors::RESET << std::endl;
+        return false;
+    #endif
+    }
+
+    void closeNetwork() {
+    #ifdef __linux__
+        for (auto* flows : {&netSenders, &netReceivers}) {
+            for (auto& flow : *flows) {
+                if (flow->fd >= 0) close(flow->fd);
+                flow->fd = -1;
+            }
+        }
+        if (netListener >= 0) close(netListener);
+        netListener = -1;
+    #endif
+    }
+
+#ifdef __linux__
+    void networkStressTest() {
+        Network::SoftirqCounter softirqs;
+        uint64_t rxBefore = 0, txBefore = 0;
+        const bool haveSoftirqs = softirqs.read(rxBefore, txBefore);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> flows;
+        for (unsigned f = 0; f < netSenders.size(); ++f) flows.emplace_back(&SystemStressTest::netSendLoop, this, f);
+        for (unsigned f = 0; f < netReceivers.size(); ++f) {
+            if (netReceivers[f]->fd >= 0) flows.emplace_back(&SystemStressTest::netReceiveLoop, this, f);
+        }
+
+        // Peer TCP: accept returns every TIMEOUT_MS (SO_RCVTIMEO) so the end of the run is noticed
+        for (unsigned next = 0; netListener >= 0 && next < netReceivers.size() && running.load(std::memory_order_relaxed);) {
+            const int fd = accept4(netListener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) continue;
+            Network::setTimeouts(fd);
+            netReceivers[next]->fd = fd;
+            flows.emplace_back(&SystemStressTest::netReceiveLoop, this, next++);
+        }
+
+        for (auto& flow : flows) flow.join();
+        netSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        uint64_t rxAfter = 0, txAfter = 0;
+        if (haveSoftirqs && softirqs.read(rxAfter, txAfter)) {
+            netSoftirqRx = rxAfter - rxBefore;
+            netSoftirqTx = txAfter - txBefore;
+            netSoftirqsKnown = true;
+        }
+    }
+
+    void netSendLoop(unsigned f) {
+        NetStats& flow = *netSenders[f];
+        Topology::pinCurrentThread(flow.cpu);
+        Telemetry::Producer bytes(telemetry, netTxByteSources[f]), packets(telemetry, netTxPacketSources[f]);
+        const bool udp = options.netProtocol == Network::Protocol::Udp;
+        const int flags = MSG_NOSIGNAL | (netZeroCopy ? MSG_ZEROCOPY : 0);
+        Network::Datagrams batch(flow.buffer, netPayload);
+        uint64_t segmentsOut = 0, segmentsIn = 0;
+
+        // Segment counters and zero-copy notifications are collected every 64 calls
+        auto collect = [&] {
+            if (netZeroCopy) Network::reapZeroCopy(flow.fd, flow.zeroCopy);
+            if (udp) return;
+            const uint64_t previous = segmentsOut;
+            Network::tcpSegments(flow.fd, segmentsOut, segmentsIn);
+            flow.packets += segmentsOut - previous;
+            packets.add(segmentsOut - previous);
+        };
+
+        for (uint64_t calls = 1; running.load(std::memory_order_relaxed); ++calls) {
+            const ssize_t sent = udp ? sendmmsg(flow.fd, batch.data(), Network::BATCH, flags)
+                                     : send(flow.fd, flow.buffer, netPayload, flags);
+            if (sent > 0) {
+                const uint64_t payload = udp ? uint64_t(sent) * netPayload : uint64_t(sent);
+                flow.bytes += payload;
+                bytes.add(payload);
+                if (udp) {
+                    flow.packets += uint64_t(sent);
+                    packets.add(uint64_t(sent));
+                }
+            } else if (errno == ENOBUFS) {
+                Network::reapZeroCopy(flow.fd, flow.zeroCopy); // Out of option memory: notifications pile up
+            } else if (errno != EAGAIN && errno != EINTR) {
+                ++flow.errors;
+                if (!udp) break; // Peer gone (ECONNRESET, EPIPE)
+            }
+            if (calls % 64 == 0) collect();
+        }
+        collect();
+        if (!udp) shutdown(flow.fd, SHUT_WR);
+        bytes.flush();
+        packets.flush();
+    }
+
+    void netReceiveLoop(unsigned f) {
+        NetStats& flow = *netReceivers[f];
+        Topology::pinCurrentThread(flow.cpu);
+        Telemetry::Producer bytes(telemetry, netRxByteSources[f]), packets(telemetry, netRxPacketSources[f]);
+        const bool udp = options.netProtocol == Network::Protocol::Udp;
+        const size_t capacity = udp ? 65536 : 4 * Network::TCP_CHUNK;
+        Network::Datagrams batch(flow.buffer, capacity);
+        uint64_t segmentsOut = 0, segmentsIn = 0;
+
+        for (uint64_t calls = 1; running.load(std::memory_order_relaxed); ++calls) {
+            if (udp) {
+                // Blocks for the first datagram only, then takes whatever else is queued
+                const int received = recvmmsg(flow.fd, batch.data(), Network::BATCH, MSG_WAITFORONE, nullptr);
+                if (received <= 0) {
+                    if (errno != EAGAIN && errno != EINTR) ++flow.errors;
+                    continue;
+                }
+                uint64_t payload = 0;
+                for (int i = 0; i < received; ++i) payload += batch.length(static_cast<unsigned>(i));
+                flow.bytes += payload;
+                flow.packets += uint64_t(received);
+                bytes.add(payload);
+                packets.add(uint64_t(received));
+            } else {
+                const ssize_t received = recv(flow.fd, flow.buffer, capacity, 0);
+                if (received == 0) break; // Sender finished
+                if (received < 0) {
+                    if (errno == EAGAIN || errno == EINTR) continue;
+                    ++flow.errors;
+                    break;
+                }
+                flow.bytes += uint64_t(received);
+                bytes.add(uint64_t(received));
+                if (calls % 64 == 0) {
+                    const uint64_t previous = segmentsIn;
+                    Network::tcpSegments(flow.fd, segmentsOut, segmentsIn);
+                    flow.packets += segmentsIn - previous;
+                    packets.add(segmentsIn - previous);
+                }
+            }
+        }
+        if (!udp) {
+            const uint64_t previous = segmentsIn;
+            Network::tcpSegments(flow.fd, segmentsOut, segmentsIn);
+            flow.packets += segmentsIn - previous;
+            packets.add(segmentsIn - previous);
+        }
+        bytes.flush();
+        packets.flush();
+    }
+#endif
+
+    void displayNetworkStatus(std::string& out) const {
+        out += "\r\033[KNETWORK:";
+        auto direction = [&](const char* label, Telemetry::Metric bytes, Telemetry::Metric packets) {
+            out += label;
+            appendNumber(out, telemetry.rate(bytes) * 8.0 / 1e9, 2);
+            out += " Gbps, ";
+            appendNumber(out, telemetry.rate(packets) / 1000.0, 0);
+            out += " kpps";
+        };
+        if (!netSenders.empty()) direction(" tx ", Telemetry::Metric::NetTxBytes, Telemetry::Metric::NetTxPackets);
+        if (!netSenders.empty() && !netReceivers.empty()) out += " |";
+        if (!netReceivers.empty()) direction(" rx ", Telemetry::Metric::NetRxBytes, Telemetry::Metric::NetRxPackets);
+        out += " (";
+        out += Network::name(options.netProtocol);
+        out += ", ";
+        out += std::to_string(options.netFlows);
+        out += netZeroCopy ? " flows, zerocopy)" : " flows)";
+    }
+
+    // Gbps and packet rates per direction, flow fairness, zero-copy outcome and softirq load
+    void reportNetwork() const {
+        if (netSeconds <= 0.0) return;
+        const bool udp = options.netProtocol == Network::Protocol::Udp;
+        const char* unit = udp ? " datagrams/s" : " segments/s";
+
+        uint64_t txBytes = 0, txPackets = 0, rxBytes = 0, rxPackets = 0, errors = 0;
+        Network::ZeroCopyCompletions zeroCopy;
+        double slowest = -1.0, fastest = 0.0;
+        for (const auto& flow : netSenders) {
+            txBytes += flow->bytes;
+            txPackets += flow->packets;
+            errors += flow->errors;
+            zeroCopy.completed += flow->zeroCopy.completed;
+            zeroCopy.copied += flow->zeroCopy.copied;
+        }
+        for (const auto& flow : netReceivers) {
+            rxBytes += flow->bytes;
+            rxPackets += flow->packets;
+            errors += flow->errors;
+            const double gbps = flow->bytes * 8.0 / netSeconds / 1e9;
+            if (slowest < 0.0 || gbps < slowest) slowest = gbps;
+            fastest = std::max(fastest, gbps);
+        }
+
+        std::cout << ConsoleColors::CYAN << "Network (" << Network::name(options.netProtocol) << ", "
+                  << (options.netTarget.empty() ? "listening" : options.netTarget) << ", " << options.netFlows << " flows";
+        if (!netSenders.empty()) std::cout << ", " << netPayload << " B " << (netZeroCopy ? "MSG_ZEROCOPY" : "copying") << " sends";
+        std::cout << "):" << ConsoleColors::RESET << std::endl;
+        if (!netSenders.empty()) {
+            std::cout << ConsoleColors::CYAN << "  tx: " << txBytes * 8.0 / netSeconds / 1e9 << " Gbps, "
+                      << txPackets / netSeconds << unit << ConsoleColors::RESET << std::endl;
+        }
+        if (!netReceivers.empty()) {
+            std::cout << ConsoleColors::CYAN << "  rx: " << rxBytes * 8.0 / netSeconds / 1e9 << " Gbps, "
+                      << rxPackets / netSeconds << unit << " (per flow " << std::max(0.0, slowest) << " - "
+                      << fastest << " Gbps)" << ConsoleColors::RESET << std::endl;
+        }
+        if (udp && options.netTarget == "loopback" && txPackets > 0) {
+            std::cout << ConsoleColors::CYAN << "  datagrams lost: "
+                      << (txPackets > rxPackets ? (txPackets - rxPackets) * 100.0 / txPackets : 0.0) << "%"
+                      << ConsoleColors::RESET << std::endl;
+        }
+        if (netZeroCopy) {
+            std::cout << ConsoleColors::CYAN << "  zero-copy: " << zeroCopy.completed << " sends completed, "
+                      << zeroCopy.copied << " copied by the kernel (loopback always copies)"
+                      << ConsoleColors::RESET << std::endl;
+        }
+        if (netSoftirqsKnown) {
+            std::cout << ConsoleColors::CYAN << "  softirqs: NET_RX " << netSoftirqRx / netSeconds << "/s, NET_TX "
+                      << netSoftirqTx / netSeconds << "/s (all CPUs)" << ConsoleColors::RESET << std::endl;
+        }
+        if (errors > 0) {
+            std::cout << ConsoleColors::YELLOW << "  socket errors: " << errors << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // Target-utilisation controller: maps the current ramp step to a number of active workers.
+    // Called from the monitoring loop; setActive() never blocks, surplus workers park themselves.
+    void applyLoadTarget(int elapsedSeconds) {
+        if (!options.profile.empty()) return; // The profile scheduler owns the active-worker limit
+
+        int percent = 100;
+        if (!options.rampSteps.empty()) {
+            size_t step = static_cast<size_t>(elapsedSeconds) * options.rampSteps.size() / options.durationSeconds;
+            percent = options.rampSteps[std::min(step, options.rampSteps.size() - 1)];
+        }
+
+        // [O(1)] Round up so any non-zero target keeps at least one worker busy
+        int workers = static_cast<int>((static_cast<unsigned>(percent) * numCores + 99) / 100);
+
+        // Closed loop: measured utilisation of the workers' CPUs moves the count one worker at a time,
+        // and only when that gets closer to the target (half a worker's share of hysteresis).
+        if (percent != loadTargetPercent) {
+            loadTargetPercent = percent;
+            loadCorrection = 0;
+        } else if (percent < 100 && cpuLoad && cpuLoad->available() && !loadCpus.empty()) {
+            const double measured = workerUtilisation.load(std::memory_order_relaxed) * 100.0;
+            const double share = 100.0 / static_cast<double>(loadCpus.size());
+            if (measured < percent - share / 2 && workers + loadCorrection < static_cast<int>(numCores)) ++loadCorrection;
+            else if (measured > percent + share / 2 && workers + loadCorrection > 1) --loadCorrection;
+        }
+
+        workers = std::clamp(workers + loadCorrection, percent > 0 ? 1 : 0, static_cast<int>(numCores));
+        pool->setActive(static_cast<unsigned>(workers));
+    }
+
+    // Profile scheduler thread: sleeps until the next step boundary or square-wave edge, then
+    // publishes it at once (workers through the pool's active limit, STREAM through loadWord).
+    // Edges do not wait for the 250 ms monitor loop, so waves up to hundreds of Hz stay sharp.
+    void profileScheduler(std::chrono::steady_clock::time_point start) {
+        uint64_t epoch = 0;
+        int lastWorkers = -1;
+        bool lastMemory = false;
+        size_t lastStep = 0;
+        double plannedEdge = 0.0; // Elapsed seconds of the edge the last sleep aimed at
+        while (running) {
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const Profile::State state = Profile::at(options.profile, elapsed);
+            const Profile::Step& step = options.profile[state.step];
+            const unsigned percent = state.high ? static_cast<unsigned>(step.cpuPercent) : 0;
+            const int workers = percent > 0 ? static_cast<int>(std::max(1u, (percent * numCores + 99) / 100)) : 0;
+            const bool memory = state.high && step.memoryBandwidth;
+
+            if (workers != lastWorkers || memory != lastMemory || state.step != lastStep) {
+                if (epoch > 0) profileLatenessMs = std::max(profileLatenessMs, (elapsed - plannedEdge) * 1e3);
+                pool->setActive(static_cast<unsigned>(workers));              // [O(1)] Never blocks
+                loadWord.store(Profile::pack(++epoch, state.step, memory), std::memory_order_release);
+                loadWord.notify_all();
+                lastWorkers = workers;
+                lastMemory = memory;
+                lastStep = state.step;
+            }
+
+            // Wake for the edge itself, or every 50 ms to notice the end of the test
+            plannedEdge = elapsed + state.untilChange;
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(std::min(plannedEdge, elapsed + 0.05))));
+        }
+    }
+
+    // [O(cores)] New utilisation sample for the display, telemetry and the load controller
+    void sampleCpuLoad() {
+        cpuLoad->sample();
+        workerUtilisation.store(cpuLoad->mean(loadCpus), std::memory_order_relaxed);
+    }
+
+    // IPC, misses per 1000 instructions and stall fractions per workload, to tell a clock-speed
+    // regression apart from a cache or pipeline one
+    void reportPerfCounters() const {
+        if (perfWorkers.load() == 0) {
+            std::cout << ConsoleColors::YELLOW << "Hardware counters unavailable ("
+                      << (perfFailure.empty() ? "perf_event_open failed" : perfFailure)
+                      << "; needs a hardware PMU and perf_event_paranoid <= 2 or CAP_PERFMON)" << ConsoleColors::RESET << std::endl;
+            return;
+        }
+
+        std::cout << ConsoleColors::CYAN << "Hardware counters (user mode, " << perfWorkers.load() << " workers):"
+                  << ConsoleColors::RESET << std::endl;
+        for (const auto* info : options.workloads) {
+            uint64_t total[Perf::EVENT_COUNT] = {}, ops = 0;
+            for (unsigned i = 0; i < numCores; ++i) {
+                if (workloadFor(i) != info) continue;
+                for (int event = 0; event < Perf::EVENT_COUNT; ++event) total[event] += perfTotals[i].value[event].load();
+                ops += threadCounters[i].value.load();
+            }
+            if (total[Perf::Cycles] == 0 || total[Perf::Instructions] == 0) continue;
+
+            const double cycles = static_cast<double>(total[Perf::Cycles]);
+            const double kiloInstructions = total[Perf::Instructions] / 1000.0;
+            std::cout << ConsoleColors::CYAN << "  " << info->name
+                      << ": IPC " << total[Perf::Instructions] / cycles
+                      << ", " << (ops ? cycles / ops : 0.0) << " cycles/op"
+                      << ", cache misses " << total[Perf::CacheMisses] / kiloInstructions << "/k instr"
+                      << ", branch misses " << total[Perf::BranchMisses] / kiloInstructions << "/k instr";
+            if (total[Perf::StalledFrontend] > 0 || total[Perf::StalledBackend] > 0) {
+                std::cout << ", stalls frontend " << total[Perf::StalledFrontend] / cycles * 100.0
+                          << "% / backend " << total[Perf::StalledBackend] / cycles * 100.0 << "%";
+            }
+            std::cout << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // Tail latency of the sampled kernel calls, per workload (the per-worker histograms merged)
+    void reportCallLatency() const {
+        auto micros = [](uint64_t ns) { return ns / 1000.0; };
+        for (const auto* info : options.workloads) {
+            Histogram::LogLinear merged;
+            for (unsigned i = 0; i < numCores; ++i) {
+                if (workloadFor(i) == info && callLatency[i]) merged.merge(*callLatency[i]); // [O(buckets)]
+            }
+            if (merged.count() == 0) continue;
+
+            const uint64_t median = merged.percentile(0.50);
+            std::cout << ConsoleColors::CYAN << "Call latency " << info->name << " (1 in " << options.latencySample
+                      << ", " << merged.count() << " samples): p50 " << micros(median)
+                      << " us, p99 " << micros(merged.percentile(0.99))
+                      << " us, p99.9 " << micros(merged.percentile(0.999))
+                      << " us, p99.99 " << micros(merged.percentile(0.9999))
+                      << " us, max " << micros(merged.max()) << " us" << ConsoleColors::RESET << std::endl;
+
+            const uint64_t spikes = merged.countAbove(median * 10);
+            if (spikes > 0) {
+                std::cout << ConsoleColors::YELLOW << "  " << spikes << " sampled calls took over 10x the median"
+                          << " (preemption, SMIs or thermal events)" << ConsoleColors::RESET << std::endl;
+            }
+        }
+    }
+
+    // Distribution of the per-interval throughput: bursts, jitter, and when (if ever) it sagged
+    void reportThroughputStability() const {
+        const size_t rows = throughput.rows();
+        const double interval = options.telemetryIntervalMs / 1000.0;
+        const size_t warmup = static_cast<size_t>(std::ceil(1.0 / interval)); // [O(1)] First second excluded
+        if (rows <= warmup + 1) return;
+
+        std::vector<double> machine;
+        for (size_t row = warmup; row < rows; ++row) machine.push_back(throughput.rowSum(row));
+        const TimeSeries::Summary total = TimeSeries::summarize(machine);
+
+        std::cout << ConsoleColors::CYAN << "Throughput per " << options.telemetryIntervalMs << " ms interval ("
+                  << total.samples << " intervals after 1 s warm-up): min " << total.min << ", p50 " << total.p50
+                  << ", p99 " << total.p99 << ", max " << total.max << " ops/s, CV " << total.cv * 100.0 << "%"
+                  << ConsoleColors::RESET << std::endl;
+
+        // Weakest and strongest worker by their own median interval rate
+        double lowest = 0.0, highest = 0.0;
+        unsigned lowWorker = 0, highWorker = 0;
+        std::vector<double> column;
+        for (unsigned worker = 0; worker < throughput.series(); ++worker) {
+            column.clear();
+            for (size_t row = warmup; row < rows; ++row) column.push_back(throughput.at(row, worker));
+            const double median = TimeSeries::summarize(column).p50;
+            if (worker == 0 || median < lowest) { lowest = median; lowWorker = worker; }
+            if (worker == 0 || median > highest) { highest = median; highWorker = worker; }
+        }
+        std::cout << ConsoleColors::CYAN << "Per-worker median ops/s: lowest " << lowest << " (worker " << lowWorker
+                  << ", cpu" << workerCpus[lowWorker] << "), highest " << highest << " (worker " << highWorker
+                  << ", cpu" << workerCpus[highWorker] << ")" << ConsoleColors::RESET << std::endl;
+
+        // A drop is a 1 s stretch averaging under 90% of the best earlier 1 s stretch
+        const size_t window = std::max<size_t>(1, warmup);
+        const double drop = TimeSeries::firstSustainedDrop(throughput, warmup, window, 0.90);
+        if (!options.rampSteps.empty() || !options.profile.empty()) {
+            std::cout << ConsoleColors::YELLOW << "Load " << (options.profile.empty() ? "ramp" : "profile")
+                      << " active: throughput drops include its steps" << ConsoleColors::RESET << std::endl;
+        }
+        if (drop >= 0.0) {
+            std::cout << ConsoleColors::YELLOW << "First sustained throughput drop (>10% below the best 1 s): at "
+                      << drop << " s" << ConsoleColors::RESET << std::endl;
+        } else {
+            std::cout << ConsoleColors::CYAN << "No sustained throughput drop (stayed within 10% of the best 1 s)"
+                      << ConsoleColors::RESET << std::endl;
+        }
+        if (throughput.dropped() > 0) {
+            std::cout << ConsoleColors::YELLOW << "Time series buffer full: last " << throughput.dropped()
+                      << " intervals not recorded" << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // Clocks, thermals and energy over the run; ops per joule is the SKU-selection figure
+    void reportSensors(double seconds) const {
+        if (!showSensors()) {
+            std::cout << ConsoleColors::YELLOW << "Sensors unavailable (no cpufreq, MSR, hwmon, thermal throttle or powercap access)"
+                      << ConsoleColors::RESET << std::endl;
+            return;
+        }
+        if (sensors->hasClock()) {
+            std::cout << ConsoleColors::CYAN << "Clock at end (" << sensors->clockSource() << "): " << sensors->meanMhz()
+                      << " MHz average, " << sensors->lowMhz() << "-" << sensors->highMhz() << " MHz across cores"
+                      << ConsoleColors::RESET << std::endl;
+        }
+        if (sensors->hasTemperature()) {
+            std::cout << ConsoleColors::CYAN << "Peak temperature: " << sensors->peakCelsius() << " C"
+                      << ConsoleColors::RESET << std::endl;
+        }
+        if (sensors->hasThrottle()) {
+            std::cout << (sensors->throttleEventCount() ? ConsoleColors::YELLOW : ConsoleColors::CYAN)
+                      << "Thermal throttle events: " << sensors->throttleEventCount() << ConsoleColors::RESET << std::endl;
+        }
+        if (sensors->hasPower()) {
+            const double joules = sensors->packageJoules() + sensors->dramJoules();
+            std::cout << ConsoleColors::CYAN << "Energy: " << joules << " J (package " << sensors->packageJoules()
+                      << " J, DRAM " << sensors->dramJoules() << " J), " << joules / seconds << " W average"
+                      << ConsoleColors::RESET << std::endl;
+            if (joules > 0.0) {
+                std::cout << ConsoleColors::CYAN << "Efficiency: " << totalHashOps() / joules << " ops/J"
+                          << ConsoleColors::RESET << std::endl;
+            }
+        }
+    }
+
+    // Hashing operations per worker CPU and per NUMA node, to spot a weak core or socket
+    void reportPlacementBreakdown(double seconds) const {
+        std::vector<uint64_t> perNode(Topology::nodeCount(cpus), 0);
+
+        std::cout << ConsoleColors::CYAN << "Per-core hashing operations:" << ConsoleColors::RESET;
+        for (unsigned i = 0; i < numCores; ++i) {
+            uint64_t ops = threadCounters[i].value.load(std::memory_order_relaxed);
+            const Topology::Cpu* cpu = Topology::find(cpus, workerCpus[i]);
+            if (cpu) perNode[cpu->node] += ops;
+
+            if (i % 8 == 0) std::cout << "\n ";
+            std::cout << " cpu" << workerCpus[i] << "=" << ops;
+        }
+        std::cout << std::endl;
+
+        for (size_t node = 0; node < perNode.size(); ++node) {
+            std::cout << ConsoleColors::CYAN
+                    << "  node " << node << ": " << perNode[node] << " ops ("
+                    << perNode[node] / seconds << " ops/s)"
+                    << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    // Times the scalar modexp and every supported multi-lane variant over the same
+    // (base, exponent) pairs on this thread, so the ISA levels compare like for like.
+    void reportIsaThroughput() const {
+        constexpr uint64_t SWEEP_PAIRS = 320; // [O(1)] Multiple of 16 so every lane count divides it
+
+        std::cout << ConsoleColors::BLUE << "\nModexp ISA sweep (" << SWEEP_PAIRS << " pairs per level):"
+                  << ConsoleColors::RESET << std::endl;
+
+        double scalarRate = 0.0;
+        for (const char* name : {"modexp", "modexp-sse4.2", "modexp-avx2", "modexp-avx512"}) {
+            const auto* info = Workloads::find(name);
+            if (!info || !info->isSupported()) continue;
+
+            auto workload = info->create(0);
+            const uint64_t calls = SWEEP_PAIRS / workload->opsPerRun();
+            volatile uint64_t sink = 0;
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < calls; ++i) sink = sink + workload->runOnce(i); // [O(calls * kernel)]
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double rate = SWEEP_PAIRS / seconds;
+            if (scalarRate == 0.0) scalarRate = rate;
+            std::cout << "  " << name << ": " << rate << " ops/s (x" << rate / scalarRate << " vs scalar)" << std::endl;
+        }
+    }
+
+public:
+    explicit SystemStressTest(const StressOptions& options) : options(options) {
+        arena.setPageMode(options.pageMode);
+        chaseArena.setPageMode(options.pageMode);
+        cacheArena.setPageMode(options.pageMode);
+    }
+
+#ifdef __linux__
+    // Runs as a fleet agent: telemetry goes to the coordinator and the start waits for the fleet
+    void joinFleet(Fleet::AgentLink& link) { fleet = &link; }
+#endif
+
+    // Registers one telemetry source per producer thread, the gauges and the requested file writers.
+    // Returns false (after printing why) when an output file cannot be created.
+    bool setupTelemetry() {
+        workerSources.clear();
+        for (unsigned i = 0; i < numCores; ++i) {
+            workerSources.push_back(telemetry.addSource("worker" + std::to_string(i), Telemetry::Metric::HashOps));
+        }
+
+        verifySources.clear();
+        if (options.memoryVerify) {
+            const unsigned threads = std::max(1u, options.verifyThreads ? options.verifyThreads : numCores);
+            for (unsigned t = 0; t < threads; ++t) {
+                verifySources.push_back(telemetry.addSource("verify" + std::to_string(t), Telemetry::Metric::VerifyBytes));
+                verifyResults.push_back(std::make_unique<MemoryVerify::Results>());
+            }
+        }
+
+        cacheSources.clear();
+        for (size_t t = 0; t < cacheRegions.size() / CacheStress::LEVEL_COUNT; ++t) {
+            cacheSources.push_back(telemetry.addSource("cache" + std::to_string(t), Telemetry::Metric::CacheBytes));
+            cacheResults.push_back(std::make_unique<CacheStress::Results>());
+        }
+
+        streamSources.clear();
+        if (options.memoryBandwidth) {
+            const unsigned threads = std::max(1u, options.bandwidthThreads ? options.bandwidthThreads : numCores);
+            for (unsigned t = 0; t < threads; ++t) {
+                streamSources.push_back(telemetry.addSource("stream" + std::to_string(t), Telemetry::Metric::StreamBytes));
+            }
+        }
+
+        if (options.memoryFile) fileSource = telemetry.addSource("file0", Telemetry::Metric::FileBytes);
+        if (options.gpu) gpuSource = telemetry.addSource("gpu0", Telemetry::Metric::GpuOps);
+
+        ioByteSources.clear();
+        ioOpSources.clear();
+        for (unsigned t = 0; t < ioStats.size(); ++t) {
+            ioByteSources.push_back(telemetry.addSource("io" + std::to_string(t), Telemetry::Metric::IoBytes));
+            ioOpSources.push_back(telemetry.addSource("ioops" + std::to_string(t), Telemetry::Metric::IoOps));
+        }
+
+        auto flowSources = [&](std::vector<unsigned>& byteSources, std::vector<unsigned>& packetSources, size_t flows,
+                               const char* prefix, Telemetry::Metric bytes, Telemetry::Metric packets) {
+            byteSources.clear();
+            packetSources.clear();
+            for (size_t f = 0; f < flows; ++f) {
+                byteSources.push_back(telemetry.addSource(prefix + std::to_string(f), bytes));
+                packetSources.push_back(telemetry.addSource(prefix + std::to_string(f) + "_packets", packets));
+            }
+        };
+        flowSources(netTxByteSources, netTxPacketSources, netSenders.size(), "net_tx",
+                    Telemetry::Metric::NetTxBytes, Telemetry::Metric::NetTxPackets);
+        flowSources(netRxByteSources, netRxPacketSources, netReceivers.size(), "net_rx",
+                    Telemetry::Metric::NetRxBytes, Telemetry::Metric::NetRxPackets);
+
+        telemetry.addGauge("memory_mb", [this] { return memoryAllocated.load(std::memory_order_relaxed) / (1024.0 * 1024.0); });
+        telemetry.addGauge("active_workers", [this] { return static_cast<double>(pool->active()); });
+        telemetry.addGauge("cpu_utilisation", [this] { return workerUtilisation.load(std::memory_order_relaxed); });
+        if (options.cacheStress) {
+            telemetry.addGauge("cache_phase", [this] {
+                return cacheReady.load(std::memory_order_acquire) ? cachePhaseAt(std::chrono::steady_clock::now()) + 1.0 : 0.0;
+            });
+        }
+        if (!options.profile.empty()) {
+            telemetry.addGauge("profile_step", [this] {
+                return static_cast<double>(Profile::stepOf(loadWord.load(std::memory_order_relaxed)) + 1);
+            });
+            telemetry.addGauge("load_epoch", [this] {
+                return static_cast<double>(Profile::epochOf(loadWord.load(std::memory_order_relaxed)));
+            });
+        }
+        if (options.memoryFile) {
+            telemetry.addGauge("dirty_mb", [this] { return fileDirty.load(std::memory_order_relaxed) / (1024.0 * 1024.0); });
+            telemetry.addGauge("writeback_mb", [this] { return fileWriteback.load(std::memory_order_relaxed) / (1024.0 * 1024.0); });
+            telemetry.addGauge("msync_ms", [this] { return fileLastSyncNs.load(std::memory_order_relaxed) / 1e6; });
+        }
+        if (options.gpu) {
+            telemetry.addGauge("gpu_gflops", [this] { return gpuGflops.load(std::memory_order_relaxed); });
+            telemetry.addGauge("gpu_memory_gbs", [this] { return gpuMemGbs.load(std::memory_order_relaxed); });
+            telemetry.addGauge("gpu_transfer_gbs", [this] { return gpuTransferGbs.load(std::memory_order_relaxed); });
+        }
+        if (options.memoryPressure) {
+            telemetry.addGauge("mem_available_mb", [this] { return pressureAvailable.load(std::memory_order_relaxed) / (1024.0 * 1024.0); });
+            telemetry.addGauge("swap_used_mb", [this] { return pressureSwapUsed.load(std::memory_order_relaxed) / (1024.0 * 1024.0); });
+            telemetry.addGauge("psi_some", [this] { return psiSome.load(std::memory_order_relaxed); });
+            telemetry.addGauge("psi_full", [this] { return psiFull.load(std::memory_order_relaxed); });
+            telemetry.addGauge("major_faults_per_s", [this] { return majorFaultRate.load(std::memory_order_relaxed); });
+        }
+        if (showSensors()) {
+            telemetry.addGauge("mhz", [this] { return sensors->meanMhz(); });
+            telemetry.addGauge("temperature_c", [this] { return sensors->packageCelsius(); });
+            telemetry.addGauge("package_w", [this] { return sensors->packageWatts(); });
+            telemetry.addGauge("dram_w", [this] { return sensors->dramWatts(); });
+        }
+        if (options.memoryBandwidth) {
+            for (int level = 0; level < LATENCY_LEVELS; ++level) {
+                telemetry.addGauge(std::string("latency_ns_") + LATENCY_NAMES[level],
+                                   [this, level] { return latencyNs[level].load(std::memory_order_relaxed); });
+            }
+        }
+
+        // Per-interval, per-worker ops/s: the whole matrix is allocated here, recording never allocates
+        constexpr size_t MAX_CELLS = size_t(16) << 20; // [O(1)] 64 MB of floats at most
+        const size_t rows = static_cast<size_t>(options.durationSeconds) * 1000 / options.telemetryIntervalMs + 16;
+        throughput.reset(std::min(rows, MAX_CELLS / numCores), numCores);
+        telemetry.onTick([this](double elapsedSeconds) {
+            if (!running.load(std::memory_order_relaxed)) return; // Final drain after stop covers a partial interval
+            float* row = throughput.beginRow(elapsedSeconds);
+            if (!row) return;
+            const auto& sources = telemetry.allSources();
+            for (unsigned i = 0; i < numCores; ++i) {
+                row[i] = static_cast<float>(sources[workerSources[i]]->rate.load(std::memory_order_relaxed));
+            }
+            throughput.commitRow();
+        });
+
+        auto openWriter = [&](auto writer, const std::string& path) {
+            if (!writer->ok()) {
+                std::cout << ConsoleColors::RED << "Cannot open telemetry output: " << path
+                          << ConsoleColors::RESET << std::endl;
+                return false;
+            }
+            telemetry.addWriter(std::move(writer));
+            return true;
+        };
+        if (!options.telemetryJson.empty() &&
+            !openWriter(std::make_unique<Telemetry::JsonLinesWriter>(options.telemetryJson), options.telemetryJson)) return false;
+        if (!options.telemetryCsv.empty() &&
+            !openWriter(std::make_unique<Telemetry::CsvWriter>(options.telemetryCsv), options.telemetryCsv)) return false;
+        return true;
+    }
+
+    // Deletes the storage test's scratch file and the file-backed memory's mapping; either may not exist
+    void removeScratchFiles() {
+    #ifdef __linux__
+        Storage::removeFile(storageFile);
+        PageCache::remove(fileMapping);
+    #endif
+    }
+
+    void run() {
+        // Scratch files go on every exit from run(), including the early returns of a failed setup
+        struct ScratchGuard {
+            SystemStressTest& test;
+            ~ScratchGuard() { test.removeScratchFiles(); }
+        } scratchGuard{*this};
+
+        // Initialize the console (platform-specific setup, e.g., enable colored output on Windows)
+        ConsoleInitializer::initialize();
+
+        // Display the start banner for the stress test
+        std::cout << ConsoleColors::MAGENTA
+                << "\n=== System Stress Test Starting ==="
+                << ConsoleColors::RESET << std::endl;
+
+        // Display a warning message about the test duration
+        std::cout << ConsoleColors::YELLOW
+                << "Warning: This program will stress your system for "
+                << options.durationSeconds << " seconds."
+                << ConsoleColors::RESET << std::endl;
+
+        // Prompt the user to continue (skipped with --yes or when stdin is not a terminal)
+        if (!options.nonInteractive) {
+            std::cout << "Press Enter to continue...";
+            std::cin.get(); // Wait for user input
+        }
+        const auto setupStart = std::chrono::steady_clock::now();
+
+        // Detect the number of CPU cores available on the system
+        cpus = Topology::discover();
+        workerCpus = Topology::placement(cpus, options.affinity, options.cpuList);
+        if (options.threads > 0) {
+            // Unpinned workers may oversubscribe; pinned ones are limited to the placement
+            if (options.affinity == Topology::Affinity::None) {
+                std::vector<unsigned> cycled;
+                for (unsigned i = 0; i < options.threads; ++i) cycled.push_back(workerCpus[i % workerCpus.size()]);
+                workerCpus = cycled;
+            } else if (options.threads < workerCpus.size()) {
+                workerCpus.resize(options.threads);
+            }
+        }
+        numCores = static_cast<unsigned>(workerCpus.size());
+        if (numCores == 0) {
+            std::cout << ConsoleColors::RED << "\nNone of the requested CPUs are available"
+                      << ConsoleColors::RESET << std::endl;
+            return;
+        }
+
+        // Display the number of detected CPU cores
+        std::cout << ConsoleColors::BLUE << "\nDetected "
+                << cpus.size() << " CPU cores on " << Topology::nodeCount(cpus) << " NUMA node(s)"
+                << ConsoleColors::RESET << std::endl;
+
+        // Display the worker placement
+        std::cout << ConsoleColors::BLUE << "Affinity: " << Topology::name(options.affinity)
+                  << " (" << numCores << " workers)" << ConsoleColors::RESET << std::endl;
+
+        // Display the kernels that the workers will run
+        std::cout << ConsoleColors::BLUE << "Workloads:";
+        for (const auto* info : options.workloads) std::cout << " " << info->name;
+        std::cout << ConsoleColors::RESET << std::endl;
+
+        if (options.sharedCounter) {
+            std::cout << ConsoleColors::YELLOW
+                    << "Counter mode: shared atomic (contended)"
+                    << ConsoleColors::RESET << std::endl;
+        }
+
+        if (options.isaReport) reportIsaThroughput();
+        if (options.coreLatency) measureIdleCoreLatency();
+
+        if (!options.rampSteps.empty()) {
+            std::cout << ConsoleColors::BLUE << "Load ramp (% of workers):";
+            for (int percent : options.rampSteps) std::cout << " " << percent;
+            std::cout << ConsoleColors::RESET << std::endl;
+        }
+
+        if (!options.profile.empty()) {
+            std::cout << ConsoleColors::BLUE << "Load profile (" << Profile::totalSeconds(options.profile) << " s per pass):";
+            for (const auto& step : options.profile) {
+                std::cout << " [" << step.seconds << "s cpu " << step.cpuPercent << "%" << (step.memoryBandwidth ? " + mem" : "");
+                if (step.waveHz > 0.0) std::cout << ", " << step.waveHz << " Hz square " << step.dutyPercent << "% duty";
+                std::cout << "]";
+            }
+            std::cout << ConsoleColors::RESET << std::endl;
+        }
+
+        // Utilisation is measured on every CPU a worker may use (all of them when unpinned)
+        if (options.affinity != Topology::Affinity::None) {
+            loadCpus = workerCpus;
+        } else {
+            for (const auto& cpu : cpus) loadCpus.push_back(cpu.id);
+        }
+        std::sort(loadCpus.begin(), loadCpus.end());
+        loadCpus.erase(std::unique(loadCpus.begin(), loadCpus.end()), loadCpus.end());
+        cpuLoad = std::make_unique<CpuLoad::Sampler>(loadCpus.back());
+        if (options.sensors) sensors = std::make_unique<Sensors::Monitor>(loadCpus);
+
+        // Allocate one cache-line-padded counter and one task deque per worker before any of them start
+        threadCounters = std::vector<PaddedCounter>(numCores);
+        perfTotals = std::vector<PerfSlot>(numCores);
+        callLatency.resize(numCores);
+        pool = std::make_unique<WorkStealing::Pool>(numCores, options.batchSize);
+        applyLoadTarget(0);
+        if (!options.storagePath.empty() && !prepareStorage()) return;
+        if ((!options.netTarget.empty() || options.netListenPort != 0) && !prepareNetwork()) return;
+        if (options.cacheStress && !prepareCache()) return;
+        if (options.memoryPressure && !preparePressure()) return;
+        if (options.memoryFile && !prepareFileMapping()) return;
+        if (options.gpu && !prepareGpu()) return;
+        if (options.prefault && !options.memoryPressure && !options.memoryFile) {
+            std::cout << ConsoleColors::BLUE << "Prefaulting " << options.memoryTarget / (1024 * 1024) << "MB..."
+                      << ConsoleColors::RESET << std::flush;
+            prefaultMemory();
+            std::cout << ConsoleColors::BLUE << " ready in " << allocationSeconds << " s" << ConsoleColors::RESET << std::endl;
+        }
+
+        // Every telemetry source exists before any producer starts, so the rings never reallocate
+        if (!setupTelemetry()) return;
+
+        if (options.metricsPort != 0) {
+        #ifdef __linux__
+            std::string error;
+            if (!metrics.start(telemetry, static_cast<uint16_t>(options.metricsPort), options.durationSeconds, error)) {
+                std::cout << ConsoleColors::RED << "Metrics endpoint: " << error << ConsoleColors::RESET << std::endl;
+                return;
+            }
+            std::cout << ConsoleColors::BLUE << "Metrics on http://0.0.0.0:" << options.metricsPort << "/metrics"
+                      << ConsoleColors::RESET << std::endl;
+        #else
+            std::cout << ConsoleColors::YELLOW << "The metrics endpoint is only implemented for Linux"
+                      << ConsoleColors::RESET << std::endl;
+        #endif
+        }
+
+        // Ready to run; a fleet agent's wait for the common start is not setup
+        setupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+
+    #ifdef __linux__
+        // Fleet agents start together: sleep until the agreed moment on this machine's clock
+        if (fleet) {
+            telemetry.addWriter(std::make_unique<Fleet::TickWriter>(*fleet));
+            const int64_t wait = fleet->startLocalNs - Fleet::wallNs();
+            std::cout << ConsoleColors::CYAN << "Fleet start in " << std::max<int64_t>(0, wait) / 1e6
+                      << " ms (clock offset " << fleet->offsetNs / 1e6 << " ms, round trip "
+                      << fleet->roundTripNs / 1e6 << " ms)" << ConsoleColors::RESET << std::endl;
+            std::this_thread::sleep_until(std::chrono::system_clock::time_point(std::chrono::duration_cast<
+                std::chrono::system_clock::duration>(std::chrono::nanoseconds(fleet->startLocalNs))));
+            fleetLatenessNs = Fleet::wallNs() - fleet->startLocalNs;
+        }
+    #endif
+
+        // Inform the user that the stress test is starting
+        std::cout << "\nStarting stress test...\n\n" << std::flush;
+
+        // Record the starting time of the test; utilisation counts from here, not from before the setup
+        cpuLoad->rebaseline();
+        auto startTime = std::chrono::steady_clock::now();
+        telemetry.start(std::chrono::milliseconds(options.telemetryIntervalMs));
+        if (sensors) sensors->start(std::chrono::milliseconds(options.sensorIntervalMs));
+
+        // ===================================================================
+        // CPU STRESS TEST SETUP
+        // ===================================================================
+        // The profile scheduler publishes the first step before any worker takes a task
+        std::thread schedulerThread;
+        if (!options.profile.empty()) schedulerThread = std::thread(&SystemStressTest::profileScheduler, this, startTime);
+
+        // Launch a thread for each CPU core to perform the CPU stress test
+        for (unsigned int i = 0; i < numCores; ++i) {
+            cpuThreads.emplace_back(&SystemStressTest::cpuHashStressTest, this, i); // Launch CPU hashing threads
+        }
+
+        // Launch a separate thread for memory stress testing
+        std::thread memThread(&SystemStressTest::memoryStressTest, this);
+
+        // The loaded core-to-core pass shares the CPUs with the workers
+        std::thread coreLatencyThread;
+        if (!latencyCpus.empty()) coreLatencyThread = std::thread(&SystemStressTest::coreLatencyUnderLoad, this);
+
+        // Cache stress threads step through the levels together
+        std::thread cacheThread;
+        if (options.cacheStress) cacheThread = std::thread(&SystemStressTest::cacheStressTest, this);
+
+        // The GPU is driven from one more host thread, mostly asleep in clWaitForEvents
+        std::thread gpuThread;
+        if (options.gpu) gpuThread = std::thread(&SystemStressTest::gpuStressTest, this);
+
+        // Storage load runs alongside both on its own thread(s)
+        std::thread storageThread;
+    #ifdef __linux__
+        if (!ioStats.empty()) storageThread = std::thread(&SystemStressTest::storageStressTest, this);
+    #endif
+
+        // Network flows too, each flow thread pinned to its own CPU
+        std::thread networkThread;
+    #ifdef __linux__
+        if (networkEnabled()) networkThread = std::thread(&SystemStressTest::networkStressTest, this);
+    #endif
+
+        // ===================================================================
+        // MONITORING LOOP
+        // ===================================================================
+        int elapsedSeconds = 0;
+        while (elapsedSeconds <= options.durationSeconds) { // Run the loop until the test duration is reached
+            // Calculate the elapsed time since the start
+            auto elapsedTime = std::chrono::steady_clock::now() - startTime;
+            elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(elapsedTime).count();
+
+            // Measure, then move the active-worker limit towards the current ramp step
+            sampleCpuLoad();
+            applyLoadTarget(elapsedSeconds);
+
+            // Update the console display with the current progress
+            updateDisplay(elapsedSeconds);
+
+            // Sleep briefly to reduce the frequency of updates
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+            // Move the cursor up to overwrite the previous output in the console
+            moveCursor(displayLines() - 1, true);
+        }
+
+        // The test ends here; joining and unmapping below are timed as the teardown
+        auto endTime = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+        // Signal all threads to stop their work, waking any parked workers so they see it. The profile
+        // scheduler is joined first: a step change it publishes after shutdown() would park the
+        // workers again (an idle step sets the limit to 0) and nothing would wake them.
+        running = false;
+        if (schedulerThread.joinable()) {
+            schedulerThread.join();
+        }
+        loadWord.fetch_add(uint64_t(1) << 16, std::memory_order_release); // New epoch: wakes parked STREAM threads
+        loadWord.notify_all();
+        pool->shutdown();
+
+        // ===================================================================
+        // THREAD CLEANUP
+        // ===================================================================
+        // Wait for all CPU threads to complete
+        for (auto& thread : cpuThreads) {
+            if (thread.joinable()) { // Ensure the thread is joinable before joining
+                thread.join();
+            }
+        }
+
+        // Wait for the memory stress test thread to complete
+        if (memThread.joinable()) {
+            memThread.join();
+        }
+        if (cacheThread.joinable()) {
+            cacheThread.join();
+        }
+        if (gpuThread.joinable()) {
+            gpuThread.join();
+        }
+        if (coreLatencyThread.joinable()) {
+            coreLatencyThread.join();
+        }
+        if (storageThread.joinable()) {
+            storageThread.join();
+        }
+        if (networkThread.joinable()) {
+            networkThread.join();
+        }
+        closeNetwork();
+
+        // Final collector tick: drains whatever the producers published after the last refresh
+        telemetry.stop();
+        if (sensors) sensors->stop();
+    #ifdef __linux__
+        if (fleet) {
+            fleet->sendFinal(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count(),
+                             telemetry, fleetLatenessNs);
+        }
+        metrics.stop(); // Scrapes up to here saw the final tick
+    #endif
+
+        // Unmap every arena chunk at once (one munmap per chunk, no per-block frees)
+        const size_t arenaChunks = arena.chunkCount();
+        const bool hugetlbFallback = arena.fellBackFromHugetlb();
+        const auto unmapStart = std::chrono::steady_clock::now();
+        arena.release();
+        chaseArena.release();
+        cacheArena.release();
+        removeScratchFiles();
+        ioArena.release();
+        netArena.release();
+        const auto teardownEnd = std::chrono::steady_clock::now();
+        unmapSeconds = std::chrono::duration<double>(teardownEnd - unmapStart).count();
+        teardownSeconds = std::chrono::duration<double>(teardownEnd - endTime).count();
+
+        // ===================================================================
+        // DISPLAY TEST RESULTS
+        // ===================================================================
+
+        // Print an empty line for spacing
+        std::cout << std::endl;
+
+        // Display the test results banner
+        std::cout << "\n\n" << ConsoleColors::MAGENTA
+                << "=== Test Results ==="
+                << ConsoleColors::RESET << std::endl;
+
+        // Display the total number of hashing operations performed
+        std::cout << ConsoleColors::CYAN
+                << "Total hashing operations: " << totalHashOps()
+                << " ops" << ConsoleColors::RESET << std::endl;
+
+        // Display each kernel's own throughput (needs the per-worker counters)
+        if (!options.sharedCounter) {
+            for (const auto* info : options.workloads) {
+                uint64_t ops = 0;
+                for (unsigned i = 0; i < numCores; ++i) {
+                    if (workloadFor(i) == info) ops += threadCounters[i].value.load(std::memory_order_relaxed);
+                }
+                std::cout << ConsoleColors::CYAN
+                        << "  " << info->name << ": " << ops << " ops ("
+                        << ops / (duration.count() / 1000.0) << " ops/s)"
+                        << ConsoleColors::RESET << std::endl;
+            }
+        }
+        if (options.gpu) reportGpu();
+
+        // Display the total execution time in seconds
+        std::cout << ConsoleColors::CYAN
+                << "Total execution time: " << duration.count() / 1000.0
+                << " seconds" << ConsoleColors::RESET << std::endl;
+
+        // Display the overhead around the timed run: setting up before the clock, tearing down after it
+        std::cout << ConsoleColors::CYAN
+                << "Setup (time to ready): " << setupSeconds << " s" << (memoryReady ? ", memory prefaulted" : "")
+                << ConsoleColors::RESET << std::endl;
+        std::cout << ConsoleColors::CYAN
+                << "Teardown: " << teardownSeconds << " s (" << arenaChunks << " arena chunks unmapped in "
+                << unmapSeconds << " s)" << ConsoleColors::RESET << std::endl;
+
+        // Display the maximum amount of memory allocated during the test
+        std::cout << ConsoleColors::CYAN
+                << "Maximum memory allocated: " << memoryAllocated / (1024 * 1024)
+                << "MB" << ConsoleColors::RESET << std::endl;
+
+        // Display how fast the memory thread could allocate and fault in its blocks
+        if (allocationSeconds > 0.0) {
+            std::cout << ConsoleColors::CYAN
+                    << "Time to reach " << memoryAllocated / (1024 * 1024) << "MB: " << allocationSeconds << " s ("
+                    << (options.parallelFill ? "parallel" : memoryReady ? "kernel-populated" : "serial") << " fill"
+                    << (memoryReady ? " before the clock" : "")
+                    << (options.parallelFill && Memory::hasStreamingStores() ? ", non-temporal stores" : "") << ")"
+                    << ConsoleColors::RESET << std::endl;
+            std::cout << ConsoleColors::CYAN
+                    << "Allocation rate: " << memoryAllocated / allocationSeconds / (1024.0 * 1024 * 1024)
+                    << " GB/s (" << arenaChunks << " arena chunks, huge pages: " << Memory::name(options.pageMode) << ")"
+                    << ConsoleColors::RESET << std::endl;
+        }
+        if (hugetlbFallback) {
+            std::cout << ConsoleColors::YELLOW
+                    << "MAP_HUGETLB was refused for some chunks; they used normal pages"
+                    << ConsoleColors::RESET << std::endl;
+        }
+
+        // Display the STREAM and latency results of bandwidth mode
+        if (options.memoryBandwidth && totalBandwidthBytes() > 0) {
+            double seconds = std::chrono::duration<double>(endTime - bandwidthStart).count();
+            std::cout << ConsoleColors::CYAN
+                    << "Memory bandwidth under load: " << totalBandwidthBytes() / seconds / 1e9 << " GB/s ("
+                    << streamSources.size() << " STREAM threads)" << ConsoleColors::RESET << std::endl;
+            for (int k = 0; k < 4; ++k) {
+                std::cout << ConsoleColors::CYAN << "  " << MemoryBench::name(MemoryBench::STREAM_KERNELS[k])
+                          << ": " << streamRates[k] << " GB/s" << ConsoleColors::RESET << std::endl;
+            }
+            for (int level = 0; level < LATENCY_LEVELS; ++level) {
+                std::cout << ConsoleColors::CYAN << "  latency " << LATENCY_NAMES[level] << ": "
+                          << latencyNs[level].load() << " ns/access" << ConsoleColors::RESET << std::endl;
+            }
+        }
+
+        if (options.memoryVerify) reportMemoryVerify(endTime);
+        if (options.memoryPressure) reportPressure();
+        if (options.memoryFile) reportFile();
+        if (!cacheResults.empty()) reportCache();
+        if (!options.profile.empty()) {
+            std::cout << ConsoleColors::CYAN << "Load profile: " << Profile::epochOf(loadWord.load()) - 1
+                      << " edges published, worst lateness " << profileLatenessMs << " ms" << ConsoleColors::RESET << std::endl;
+        }
+        if (!latencyCpus.empty()) reportCoreLatency();
+    #ifdef __linux__
+        if (options.metricsPort != 0) {
+            std::cout << ConsoleColors::CYAN << "Metrics endpoint: " << metrics.scrapeCount() << " scrapes served"
+                      << ConsoleColors::RESET << std::endl;
+        }
+    #endif
+
+        // Display whether the workers actually kept their CPUs busy over the whole run
+        if (cpuLoad->available()) {
+            double sum = 0.0, lowest = 1.0;
+            unsigned lowestCpu = loadCpus.front();
+            for (unsigned id : loadCpus) {
+                double load = cpuLoad->coreSinceStart(id);
+                sum += load;
+                if (load < lowest) { lowest = load; lowestCpu = id; }
+            }
+            std::cout << ConsoleColors::CYAN
+                    << "CPU utilisation on worker CPUs: " << sum / loadCpus.size() * 100.0 << "% average, lowest cpu"
+                    << lowestCpu << " at " << lowest * 100.0 << "%" << ConsoleColors::RESET << std::endl;
+        }
+
+        // Display how much rebalancing the work-stealing pool did
+        std::cout << ConsoleColors::CYAN
+                << "Tasks stolen between workers: " << pool->stolen()
+                << ConsoleColors::RESET << std::endl;
+
+        // Display the number of CPU cores utilized
+        std::cout << ConsoleColors::CYAN
+                << "CPU cores utilized: " << numCores
+                << ConsoleColors::RESET << std::endl;
+
+        if (telemetry.dropped() > 0) {
+            std::cout << ConsoleColors::YELLOW
+                    << "Telemetry rings were full " << telemetry.dropped() << " times (refused values were kept and counted later)"
+                    << ConsoleColors::RESET << std::endl;
+        }
+
+        if (pinFailures > 0) {
+            std::cout << ConsoleColors::YELLOW
+                    << "Workers that could not be pinned: " << pinFailures.load()
+                    << ConsoleColors::RESET << std::endl;
+        }
+
+        reportThroughputStability();
+        if (options.latencySample > 0) reportCallLatency();
+        if (options.perfCounters && !options.sharedCounter) reportPerfCounters();
+        if (options.sensors) reportSensors(duration.count() / 1000.0);
+        if (!ioStats.empty()) reportStorage();
+        if (networkEnabled()) reportNetwork();
+        if (!options.sharedCounter) reportPlacementBreakdown(duration.count() / 1000.0);
+    }
+
+};
+
+#ifdef __linux__
+/*
+ * Fleet coordinator (--coordinator=PORT --agents=N): no local load. Waits for the agents,
+ * releases them at one common start time with this command line's test options, shows the
+ * fleet's combined rates while they run and merges their results into one report.
+ */
+int runCoordinator(const StressOptions& options) {
+    ConsoleInitializer::initialize();
+    Fleet::Coordinator coordinator;
+    std::string error;
+
+    std::cout << ConsoleColors::MAGENTA << "\n=== Fleet Coordinator ===" << ConsoleColors::RESET << std::endl;
+    std::cout << "Waiting for " << options.fleetAgents << " agents on port " << options.coordinatorPort << "..." << std::endl;
+    if (!coordinator.gather(static_cast<uint16_t>(options.coordinatorPort), options.fleetAgents, options.fleetWaitSeconds, error) ||
+        !coordinator.release(options.forwarded, error)) {
+        std::cout << ConsoleColors::RED << "Fleet start failed: " << error << ConsoleColors::RESET << std::endl;
+        return 1;
+    }
+    std::cout << ConsoleColors::CYAN << "All agents connected; starting in " << Fleet::START_LEAD_NS / 1e9 << " s"
+              << ConsoleColors::RESET << std::endl;
+
+    // Fleet-wide sums of the agents' latest ticks: what the PDUs and cooling see at that moment
+    double peakWatts = 0.0, peakOpsRate = 0.0;
+    std::string line;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.durationSeconds + 120);
+    while (coordinator.poll(options.telemetryIntervalMs) && std::chrono::steady_clock::now() < deadline) {
+        unsigned ticking = 0;
+        double opsRate = 0.0, watts = 0.0, hottest = 0.0;
+        for (const auto& agent : coordinator.agents) { // [O(agents)]
+            if (!agent.ticking || agent.finished) continue;
+            ++ticking;
+            opsRate += agent.latest.rates[static_cast<size_t>(Telemetry::Metric::HashOps)];
+            watts += agent.latest.gauges[Fleet::PackageWatts];
+            hottest = std::max(hottest, agent.latest.gauges[Fleet::Celsius]);
+        }
+        if (ticking == 0) continue;
+        peakWatts = std::max(peakWatts, watts);
+        peakOpsRate = std::max(peakOpsRate, opsRate);
+
+        line = "\r\033[KFLEET: " + std::to_string(ticking) + "/" + std::to_string(coordinator.agents.size()) + " agents | ";
+        line += std::to_string(static_cast<uint64_t>(opsRate)) + " ops/s";
+        if (watts > 0.0) line += " | " + std::to_string(static_cast<int>(watts)) + " W";
+        if (hottest > 0.0) line += " | " + std::to_string(static_cast<int>(hottest)) + " C max";
+        std::cout << line << std::flush;
+    }
+
+    // ===================================================================
+    // FLEET REPORT
+    // ===================================================================
+    std::cout << "\n\n" << ConsoleColors::MAGENTA << "=== Fleet Report ===" << ConsoleColors::RESET << std::endl;
+    uint64_t fleetOps = 0;
+    double fleetOpsRate = 0.0, fleetIoRate = 0.0, fleetNetRate = 0.0;
+    int64_t earliest = 0, latest = 0, slowestRoundTrip = 0;
+    unsigned finished = 0;
+    for (const auto& agent : coordinator.agents) {
+        if (!agent.finished) {
+            std::cout << ConsoleColors::YELLOW << agent.host << ": no final report (disconnected or timed out)"
+                      << ConsoleColors::RESET << std::endl;
+            continue;
+        }
+        const double seconds = std::max(agent.seconds, 1e-9);
+        const uint64_t ops = agent.totals[static_cast<size_t>(Telemetry::Metric::HashOps)];
+        const double ioRate = agent.totals[static_cast<size_t>(Telemetry::Metric::IoBytes)] / seconds / (1024.0 * 1024.0);
+        const double netRate = (agent.totals[static_cast<size_t>(Telemetry::Metric::NetTxBytes)] +
+                                agent.totals[static_cast<size_t>(Telemetry::Metric::NetRxBytes)]) * 8.0 / seconds / 1e9;
+        std::cout << ConsoleColors::CYAN << agent.host << " (" << agent.cpus << " CPUs): " << ops / seconds
+                  << " ops/s, started " << agent.latenessNs / 1e6 << " ms late (clock offset "
+                  << agent.offsetNs / 1e6 << " ms, round trip " << agent.roundTripNs / 1e6 << " ms)";
+        if (ioRate > 0.0) std::cout << ", storage " << ioRate << " MB/s";
+        if (netRate > 0.0) std::cout << ", network " << netRate << " Gbps";
+        if (agent.peakWatts > 0.0) std::cout << ", peak " << agent.peakWatts << " W";
+        if (agent.peakCelsius > 0.0) std::cout << ", peak " << agent.peakCelsius << " C";
+        std::cout << ConsoleColors::RESET << std::endl;
+
+        fleetOps += ops;
+        fleetOpsRate += ops / seconds;
+        fleetIoRate += ioRate;
+        fleetNetRate += netRate;
+        earliest = finished == 0 ? agent.latenessNs : std::min(earliest, agent.latenessNs);
+        latest = finished == 0 ? agent.latenessNs : std::max(latest, agent.latenessNs);
+        slowestRoundTrip = std::max(slowestRoundTrip, agent.roundTripNs);
+        ++finished;
+    }
+    if (finished == 0) return 1;
+
+    std::cout << ConsoleColors::CYAN << "Fleet: " << finished << "/" << coordinator.agents.size() << " agents, "
+              << fleetOps << " hash ops, " << fleetOpsRate << " ops/s (peak " << peakOpsRate << " ops/s)"
+              << ConsoleColors::RESET << std::endl;
+    if (fleetIoRate > 0.0 || fleetNetRate > 0.0) {
+        std::cout << ConsoleColors::CYAN << "Fleet I/O: storage " << fleetIoRate << " MB/s, network " << fleetNetRate
+                  << " Gbps" << ConsoleColors::RESET << std::endl;
+    }
+    if (peakWatts > 0.0) {
+        std::cout << ConsoleColors::CYAN << "Peak simultaneous package power: " << peakWatts << " W"
+                  << ConsoleColors::RESET << std::endl;
+    }
+    std::cout << ConsoleColors::CYAN << "Start spread across agents: " << (latest - earliest) / 1e6
+              << " ms, plus up to " << slowestRoundTrip / 2e6 << " ms of clock-offset error (half the slowest round trip)"
+              << ConsoleColors::RESET << std::endl;
+    return finished == coordinator.agents.size() ? 0 : 1;
+}
+#endif
+
+// One line per kernel: score, spread, and the change against the baseline when there is one
+void printBenchResult(const Bench::Result& result, const std::vector<Bench::Baseline>& baseline, int threshold) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-16s %14.6g %-6s (cv %.2f%%, %zu/%zu kept)", result.name.c_str(),
+                  result.stats.score, result.unit, result.stats.cvPercent, result.stats.kept, result.stats.samples);
+    const Bench::Baseline* entry = Bench::find(baseline, result.name);
+    if (!entry) {
+        std::cout << ConsoleColors::CYAN << line << (baseline.empty() ? "" : "  not in baseline")
+                  << ConsoleColors::RESET << std::endl;
+        return;
+    }
+    const double change = Bench::improvementPercent(result, *entry);
+    char delta[48];
+    std::snprintf(delta, sizeof(delta), "  %+.1f%% vs baseline%s", change, change < -threshold ? " REGRESSION" : "");
+    std::cout << (change < -threshold ? ConsoleColors::RED : ConsoleColors::CYAN) << line << delta
+              << ConsoleColors::RESET << std::endl;
+}
+/*
+ * Benchmark mode (--bench): no stress test. Scores a fixed list of kernels (see Bench.hpp),
+ * writes the score file and, with --bench-baseline, compares every kernel with the earlier run.
+ * Returns 2 when a kernel is slower than the baseline by more than --bench-threshold.
+ */
+int runBench(const StressOptions& options) {
+    ConsoleInitializer::initialize();
+    const Bench::Settings settings{options.benchSeed, options.benchThreads, options.benchWarmup,
+                                   options.benchIterations, options.benchMs};
+    std::vector<Bench::Baseline> baseline;
+    Bench::Settings baselineSettings;
+    Bench::System baselineSystem;
+    if (!options.benchBaseline.empty() && !Bench::readScores(options.benchBaseline, baseline, baselineSettings, baselineSystem)) {
+        std::cerr << ConsoleColors::RED << "Cannot read baseline scores from " << options.benchBaseline
+                  << ConsoleColors::RESET << std::endl;
+        return 1;
+    }
+
+    const std::vector<Topology::Cpu> cpus = Topology::discover();
+    const std::vector<unsigned> benchCpus = options.affinity != Topology::Affinity::None
+        ? Topology::placement(cpus, options.affinity, options.cpuList) : Topology::placement(cpus, Topology::Affinity::Physical, {});
+    if (benchCpus.empty()) {
+        std::cerr << ConsoleColors::RED << "No CPU to run the benchmark on" << ConsoleColors::RESET << std::endl;
+        return 1;
+    }
+    Topology::pinCurrentThread(benchCpus.front());
+
+    std::cout << ConsoleColors::MAGENTA << "\n=== Benchmark ===" << ConsoleColors::RESET << std::endl;
+    std::cout << "Seed " << settings.seed << ", " << settings.threads << " thread(s) per CPU kernel, " << settings.warmup
+              << " warm-up + " << settings.iterations << " measured iterations of ~" << settings.iterationMs << " ms each"
+              << std::endl;
+    if (!baseline.empty()) {
+        std::cout << "Baseline " << options.benchBaseline << " (" << baselineSystem.host << ", " << baselineSystem.kernel
+                  << ", " << baselineSystem.timestamp << ")" << std::endl;
+        if (baselineSettings.seed != settings.seed || baselineSettings.threads != settings.threads) {
+            std::cout << ConsoleColors::YELLOW << "The baseline used seed " << baselineSettings.seed << " and "
+                      << baselineSettings.threads << " thread(s): scores are not directly comparable"
+                      << ConsoleColors::RESET << std::endl;
+        }
+    }
+
+    std::vector<Bench::Result> results;
+    auto record = [&](Bench::Result result) {
+        printBenchResult(result, baseline, options.benchThresholdPercent);
+        results.push_back(std::move(result));
+    };
+
+    // CPU kernels: one instance per thread, seeded through the factory's thread id
+    for (const char* name : Bench::WORKLOADS) {
+        const auto* info = Workloads::find(name);
+        if (!info || !info->isSupported()) continue;
+        std::vector<std::unique_ptr<Workloads::Workload>> instances;
+        for (unsigned t = 0; t < settings.threads; ++t) instances.push_back(info->create(static_cast<unsigned>(settings.seed + t)));
+        const double opsPerCall = static_cast<double>(instances[0]->opsPerRun() * settings.threads);
+        record(Bench::measure(settings, name, "ops/s", true,
+            [&](uint64_t calls) { return Bench::timeWorkload(instances, benchCpus, calls); },
+            [&](uint64_t calls, double seconds) { return calls * opsPerCall / seconds; }));
+    }
+
+    // Memory kernels on one thread: STREAM copy/triad past the LLC, then a dependent-load chase
+    const Topology::CacheSizes caches = Topology::cacheSizes();
+    const size_t bytes = std::clamp<size_t>(4 * caches.llc, size_t(96) << 20, size_t(1) << 30) / (3 * 4096) * (3 * 4096);
+    Memory::Arena benchArena(bytes, options.pageMode);
+    try {
+        auto* a = static_cast<double*>(benchArena.allocate(bytes, 4096));
+        const size_t n = bytes / 3 / sizeof(double);
+        MemoryBench::streamInit(a, a + n, a + 2 * n, n);
+        for (MemoryBench::StreamKernel kernel : {MemoryBench::StreamKernel::Copy, MemoryBench::StreamKernel::Triad}) {
+            size_t moved = 0;
+            record(Bench::measure(settings, std::string("stream-") + MemoryBench::name(kernel), "GB/s", true,
+                [&](uint64_t passes) {
+                    const auto start = std::chrono::steady_clock::now();
+                    moved = 0;
+                    for (uint64_t p = 0; p < passes; ++p) moved += MemoryBench::streamPass(kernel, a, a + n, a + 2 * n, n, MemoryBench::STREAM_SCALAR);
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                },
+                [&](uint64_t, double seconds) { return moved / seconds / 1e9; }));
+        }
+        MemoryBench::buildChase(a, bytes, settings.seed);
+        double ns = 0.0;
+        record(Bench::measure(settings, "latency-dram", "ns", false,
+            [&](uint64_t steps) {
+                const auto start = std::chrono::steady_clock::now();
+                ns = MemoryBench::chaseNanoseconds(a, steps * 4096);
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            },
+            [&](uint64_t, double) { return ns; }));
+    } catch (const std::bad_alloc&) {
+        std::cout << ConsoleColors::YELLOW << "Cannot allocate " << bytes / (1024 * 1024) << " MB: memory kernels skipped"
+                  << ConsoleColors::RESET << std::endl;
+    }
+    benchArena.release();
+
+    if (!Bench::writeScores(options.benchOut, settings, Bench::describeSystem(), results)) {
+        std::cerr << ConsoleColors::RED << "Cannot write " << options.benchOut << ConsoleColors::RESET << std::endl;
+        return 1;
+    }
+    std::cout << "Scores written to " << options.benchOut << std::endl;
+    if (baseline.empty()) return 0;
+
+    int regressions = 0;
+    for (const auto& result : results) {
+        const Bench::Baseline* entry = Bench::find(baseline, result.name);
+        regressions += entry && Bench::improvementPercent(result, *entry) < -options.benchThresholdPercent;
+    }
+    for (const auto& entry : baseline) {
+        if (std::none_of(results.begin(), results.end(), [&](const Bench::Result& r) { return r.name == entry.name; })) {
+            std::cout << ConsoleColors::YELLOW << "  " << entry.name << ": in the baseline, not run here" << ConsoleColors::RESET << std::endl;
+        }
+    }
+    const double overall = Bench::overallPercent(results, baseline);
+    std::cout << (regressions ? ConsoleColors::RED : ConsoleColors::CYAN) << "Overall " << (overall >= 0.0 ? "+" : "")
+              << std::round(overall * 10.0) / 10.0 << "% vs baseline (geometric mean), " << regressions << " regression(s) beyond "
+              << options.benchThresholdPercent << "%" << ConsoleColors::RESET << std::endl;
+    return regressions ? 2 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    StressOptions options;
+    std::string error;
+    switch (Config::parseArguments(argc, argv, options, error)) {
+        case Config::Outcome::Exit:
+            return 0;
+        case Config::Outcome::Error:
+            std::cerr << ConsoleColors::RED << error << ConsoleColors::RESET << std::endl;
+            std::cerr << "Run with --help for the list of options." << std::endl;
+            return 1;
+        default:
+            break;
+    }
+
+    if (options.bench) return runBench(options);
+
+#ifdef __linux__
+    if (options.coordinatorPort != 0) return runCoordinator(options);
+
+    Fleet::AgentLink fleet;
+    if (!options.agentTarget.empty()) {
+        std::cout << "Joining coordinator " << options.agentTarget << "..." << std::endl;
+        if (!fleet.join(options.agentTarget, std::thread::hardware_concurrency(), error) ||
+            !Config::applyForwarded(fleet.config, options, error)) {
+            std::cerr << ConsoleColors::RED << "Cannot join the fleet: " << error << ConsoleColors::RESET << std::endl;
+            return 1;
+        }
+    }
+#else
+    if (options.coordinatorPort != 0 || !options.agentTarget.empty()) {
+        std::cerr << ConsoleColors::RED << "Fleet runs are only implemented for Linux" << ConsoleColors::RESET << std::endl;
+        return 1;
+    }
+#endif
 
-int main() {
-    SystemStressTest test;
+    SystemStressTest test(options);
+#ifdef __linux__
+    if (!options.agentTarget.empty()) test.joinFleet(fleet);
+#endif
     test.run(); // Start the stress test
     return 0;
 }